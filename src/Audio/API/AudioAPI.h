@@ -36,6 +36,14 @@
     #define MRH_SPEECHD_SOUND_IO_API_SDL2 0
 #endif
 
+/**
+ *  File (I/O)
+ */
+
+#ifndef MRH_SPEECHD_SOUND_IO_API_FILE
+    #define MRH_SPEECHD_SOUND_IO_API_FILE 0
+#endif
+
 //*************************************************************************************
 // Speech Checker API Use Flags
 //*************************************************************************************
@@ -57,9 +65,10 @@ typedef enum
 {
     // APIs
     RECORDER_API_SDL2 = 0,
+    RECORDER_API_FILE = 1,
 
     // Bounds
-    RECORDER_API_MAX = RECORDER_API_SDL2,
+    RECORDER_API_MAX = RECORDER_API_FILE,
 
     RECORDER_API_COUNT = RECORDER_API_MAX + 1
 
@@ -69,9 +78,10 @@ typedef enum
 {
     // APIs
     PLAYER_API_SDL2 = 0,
+    PLAYER_API_FILE = 1,
 
     // Bounds
-    PLAYER_API_MAX = PLAYER_API_SDL2,
+    PLAYER_API_MAX = PLAYER_API_FILE,
 
     PLAYER_API_COUNT = PLAYER_API_MAX + 1
 
@@ -25,7 +25,7 @@
 
 // Pre-defined
 #if CHUNK_VOLUME_LOG_EXTENDED > 0
-    #define CHUNK_VOLUME_LOG(X) Logger::Singleton().Log(Logger::INFO, X, "ChunkVolume.cpp", __LINE__)
+    #define CHUNK_VOLUME_LOG(X) MRH_LOG_INFO("{}", X)
 #else
     #define CHUNK_VOLUME_LOG(X)
 #endif
@@ -36,9 +36,25 @@
 //*************************************************************************************
 
 ChunkVolume::ChunkVolume(Configuration::ChunkVolume const& c_Configuration) : SpeechChecker("Chunk Volume"),
-                                                                              f32_MinVolume(c_Configuration.f32_MinVolume),
-                                                                              f32_MinSamples(c_Configuration.f32_MinSamples)
-{}
+                                                                              u8_Mode(c_Configuration.u8_Mode),
+                                                                              s16_Threshold(AudioFeatures::GetThreshold(c_Configuration.f32_MinVolume)),
+                                                                              f64_MinEnergy(0.0),
+                                                                              f32_MinSamples(c_Configuration.f32_MinSamples),
+                                                                              f32_MaxCrossingRate(c_Configuration.f32_MaxCrossingRate)
+{
+    if (u8_Mode > MODE_MAX)
+    {
+        throw Exception("Unknown chunk volume mode " +
+                        std::to_string(u8_Mode) +
+                        "!");
+    }
+
+    // Mean squared amplitude for the RMS comparison
+    MRH_Sfloat64 f64_MinRMS = 32768.0 * c_Configuration.f32_MinVolume;
+    f64_MinEnergy = f64_MinRMS * f64_MinRMS;
+
+    MRH_LOG_INFO("Using chunk volume mode {} (Vector Instructions: {}).", u8_Mode, MRH_AUDIO_FEATURES_SIMD);
+}
 
 ChunkVolume::~ChunkVolume() noexcept
 {}
@@ -47,38 +63,90 @@ ChunkVolume::~ChunkVolume() noexcept
 // Check
 //*************************************************************************************
 
-bool ChunkVolume::IsSpeech(AudioBuffer::AudioChunk const& v_Chunk)
+bool ChunkVolume::IsSpeech(const MRH_Sint16* p_Samples, size_t us_Samples)
 {
-    Logger& c_Logger = Logger::Singleton();
-    size_t us_SampleCount = v_Chunk.size();
-
-    if (us_SampleCount == 0)
+    if (us_Samples == 0)
     {
         CHUNK_VOLUME_LOG("No samples to process!");
         return false;
     }
 
-    MRH_Uint16 u16_MinVolume = (MRH_Uint16)(32768.f * f32_MinVolume);
-    size_t us_RequiredSamples = (size_t)((float)(v_Chunk.size()) * f32_MinSamples);
-    size_t us_MatchingSamples = 0;
+    // All features are measured in one pass over the chunk
+    return IsSpeechFeatures(p_Samples, us_Samples, AudioFeatures::Measure(p_Samples, us_Samples, s16_Threshold));
+}
 
-    for (auto const& Sample : v_Chunk)
+bool ChunkVolume::IsSpeechFeatures(const MRH_Sint16* /* p_Samples */, size_t us_Samples, AudioFeatures::Features const& c_Features)
+{
+    if (us_Samples == 0)
     {
-        if (Sample >= u16_MinVolume)
-        {
-            us_MatchingSamples += 1;
-        }
+        CHUNK_VOLUME_LOG("No samples to process!");
+        return false;
     }
 
-    if (us_MatchingSamples >= us_RequiredSamples)
+    switch (u8_Mode)
     {
-        return true;
+        case MODE_PEAK:
+        {
+            size_t us_RequiredSamples = (size_t)((MRH_Sfloat32)(us_Samples) * f32_MinSamples);
+
+            if (c_Features.us_Loud >= us_RequiredSamples)
+            {
+                return true;
+            }
+
+            CHUNK_VOLUME_LOG("Found " +
+                             std::to_string(c_Features.us_Loud) +
+                             " matching samples, " +
+                             std::to_string(us_RequiredSamples) +
+                             " are required.");
+            return false;
+        }
+
+        case MODE_RMS:
+        case MODE_ZERO_CROSSING:
+        {
+            MRH_Sfloat64 f64_Energy = (MRH_Sfloat64)(c_Features.u64_Energy) / us_Samples;
+
+            if (f64_Energy < f64_MinEnergy)
+            {
+                CHUNK_VOLUME_LOG("Chunk mean energy " +
+                                 std::to_string(f64_Energy) +
+                                 " below required " +
+                                 std::to_string(f64_MinEnergy) +
+                                 ".");
+                return false;
+            }
+            else if (u8_Mode == MODE_RMS || us_Samples < 2)
+            {
+                return true;
+            }
+
+            // Voiced speech crosses zero less often than broadband noise
+            MRH_Sfloat32 f32_CrossingRate = (MRH_Sfloat32)(c_Features.us_Crossings) / (us_Samples - 1);
+
+            if (f32_CrossingRate <= f32_MaxCrossingRate)
+            {
+                return true;
+            }
+
+            CHUNK_VOLUME_LOG("Chunk zero crossing rate " +
+                             std::to_string(f32_CrossingRate) +
+                             " above allowed " +
+                             std::to_string(f32_MaxCrossingRate) +
+                             ".");
+            return false;
+        }
+
+        default:
+            return false;
     }
+}
 
-    CHUNK_VOLUME_LOG("Found " +
-                     std::to_string(us_MatchingSamples) +
-                     " matching samples, " +
-                     std::to_string(us_RequiredSamples) +
-                     " are required.");
-    return false;
+//*************************************************************************************
+// Getters
+//*************************************************************************************
+
+MRH_Sint16 ChunkVolume::GetThreshold() const noexcept
+{
+    return s16_Threshold;
 }
@@ -23,6 +23,7 @@
 
 // Project
 #include "../../SpeechChecker.h"
+#include "../../AudioFeatures.h"
 #include "../../../Configuration.h"
 
 
@@ -30,6 +31,22 @@ class ChunkVolume : public SpeechChecker
 {
 public:
 
+    //*************************************************************************************
+    // Types
+    //*************************************************************************************
+
+    typedef enum
+    {
+        MODE_PEAK = 0, // Share of samples above the minimum volume
+        MODE_RMS = 1, // Chunk RMS above the minimum volume
+        MODE_ZERO_CROSSING = 2, // RMS mode with a maximum zero crossing rate
+
+        MODE_MAX = MODE_ZERO_CROSSING,
+
+        MODE_COUNT = MODE_MAX + 1
+
+    }Mode;
+
     //*************************************************************************************
     // Constructor / Destructor
     //*************************************************************************************
@@ -55,12 +72,38 @@ public:
     /**
      *  Check if a audio chunk contains speech.
      *
-     *  \param v_Chunk The chunk to check.
+     *  \param p_Samples The chunk samples to check.
+     *  \param us_Samples The amount of chunk samples.
+     *
+     *  \return true if speech was found, false if not.
+     */
+
+    bool IsSpeech(const MRH_Sint16* p_Samples, size_t us_Samples) override;
+
+    /**
+     *  Check if a audio chunk contains speech with features measured while
+     *  recording the chunk.
+     *
+     *  \param p_Samples The chunk samples to check.
+     *  \param us_Samples The amount of chunk samples.
+     *  \param c_Features The chunk features, measured with the threshold of GetThreshold().
      *
      *  \return true if speech was found, false if not.
      */
 
-    bool IsSpeech(AudioBuffer::AudioChunk const& v_Chunk) override;
+    bool IsSpeechFeatures(const MRH_Sint16* p_Samples, size_t us_Samples, AudioFeatures::Features const& c_Features) override;
+
+    //*************************************************************************************
+    // Getters
+    //*************************************************************************************
+
+    /**
+     *  Get the amplitude threshold to measure chunk features with.
+     *
+     *  \return The amplitude threshold.
+     */
+
+    MRH_Sint16 GetThreshold() const noexcept override;
 
 private:
 
@@ -68,8 +111,11 @@ private:
     // Data
     //*************************************************************************************
 
-    MRH_Sfloat32 f32_MinVolume;
+    MRH_Uint8 u8_Mode;
+    MRH_Sint16 s16_Threshold;
+    MRH_Sfloat64 f64_MinEnergy;
     MRH_Sfloat32 f32_MinSamples;
+    MRH_Sfloat32 f32_MaxCrossingRate;
 
 protected:
 
@@ -25,6 +25,10 @@
 #include "./SDL2/SDL2Recorder.h"
 #include "./SDL2/SDL2Player.h"
 #endif
+#if MRH_SPEECHD_SOUND_IO_API_FILE > 0
+#include "./File/FileRecorder.h"
+#include "./File/FilePlayer.h"
+#endif
 #if MRH_SPEECHD_SPEECH_CHECKER_API_PICOVOICE_COBRA > 0
 #include "./PicovoiceCobra/PicovoiceCobra.h"
 #endif
@@ -66,16 +70,42 @@ void CreateAudioAPI::Destroy(Configuration const& c_Configuration) noexcept
 // Recording API
 //*************************************************************************************
 
-std::shared_ptr<Recorder> CreateAudioAPI::CreateRecorder(Configuration const& c_Configuration, std::shared_ptr<RecorderContext>& p_Context)
+std::shared_ptr<Recorder> CreateAudioAPI::CreateRecorder(Configuration const& c_Configuration, Configuration::Session const& c_Session, std::shared_ptr<RecorderContext>& p_Context)
 {
+    // @NOTE: Sessions only replace the device, all other settings are shared
+    bool b_Device = c_Session.s_RecordingDevice.size() > 0;
+
     try
     {
         switch (c_Configuration.c_API.u8_RecordingAPI)
         {
 #if MRH_SPEECHD_SOUND_IO_API_SDL2 > 0
             case RECORDER_API_SDL2:
-                return std::make_shared<SDL2Recorder>(c_Configuration.c_SDL2Recorder,
+            {
+                Configuration::SDL2Recorder c_Recorder = c_Configuration.c_SDL2Recorder;
+
+                if (b_Device == true)
+                {
+                    c_Recorder.s_DeviceName = c_Session.s_RecordingDevice;
+                }
+
+                return std::make_shared<SDL2Recorder>(c_Recorder,
+                                                      p_Context);
+            }
+#endif
+#if MRH_SPEECHD_SOUND_IO_API_FILE > 0
+            case RECORDER_API_FILE:
+            {
+                Configuration::FileRecorder c_Recorder = c_Configuration.c_FileRecorder;
+
+                if (b_Device == true)
+                {
+                    c_Recorder.s_FilePath = c_Session.s_RecordingDevice;
+                }
+
+                return std::make_shared<FileRecorder>(c_Recorder,
                                                       p_Context);
+            }
 #endif
             default:
                 throw Exception("Unknown or unsupported recording API!");
@@ -91,15 +121,41 @@ std::shared_ptr<Recorder> CreateAudioAPI::CreateRecorder(Configuration const& c_
 // Playback API
 //*************************************************************************************
 
-std::shared_ptr<Player> CreateAudioAPI::CreatePlayer(Configuration const& c_Configuration)
+std::shared_ptr<Player> CreateAudioAPI::CreatePlayer(Configuration const& c_Configuration, Configuration::Session const& c_Session, std::shared_ptr<Latency::Marks>& p_Marks)
 {
+    bool b_Device = c_Session.s_PlaybackDevice.size() > 0;
+
     try
     {
         switch (c_Configuration.c_API.u8_PlaybackAPI)
         {
 #if MRH_SPEECHD_SOUND_IO_API_SDL2 > 0
             case PLAYER_API_SDL2:
-                return std::make_shared<SDL2Player>(c_Configuration.c_SDL2Player);
+            {
+                Configuration::SDL2Player c_Player = c_Configuration.c_SDL2Player;
+
+                if (b_Device == true)
+                {
+                    c_Player.s_DeviceName = c_Session.s_PlaybackDevice;
+                }
+
+                return std::make_shared<SDL2Player>(c_Player,
+                                                    p_Marks);
+            }
+#endif
+#if MRH_SPEECHD_SOUND_IO_API_FILE > 0
+            case PLAYER_API_FILE:
+            {
+                Configuration::FilePlayer c_Player = c_Configuration.c_FilePlayer;
+
+                if (b_Device == true)
+                {
+                    c_Player.s_FilePath = c_Session.s_PlaybackDevice;
+                }
+
+                return std::make_shared<FilePlayer>(c_Player,
+                                                    p_Marks);
+            }
 #endif
             default:
                 throw Exception("Unknown or unsupported playback API!");
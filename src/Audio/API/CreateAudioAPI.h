@@ -59,12 +59,13 @@ namespace CreateAudioAPI
      *  Create a audio recorder.
      *
      *  \param c_Configuration The configuration to create with.
+     *  \param c_Session The session to create for.
      *  \param p_Context The recording context to use.
      *
      *  \return The created audio recorder.
      */
 
-    std::shared_ptr<Recorder> CreateRecorder(Configuration const& c_Configuration, std::shared_ptr<RecorderContext>& p_Context);
+    std::shared_ptr<Recorder> CreateRecorder(Configuration const& c_Configuration, Configuration::Session const& c_Session, std::shared_ptr<RecorderContext>& p_Context);
 
     //*************************************************************************************
     // Playback API
@@ -74,11 +75,13 @@ namespace CreateAudioAPI
      *  Create a audio player.
      *
      *  \param c_Configuration The configuration to create with.
+     *  \param c_Session The session to create for.
+     *  \param p_Marks The session latency marks.
      *
      *  \return The created audio player.
      */
 
-    std::shared_ptr<Player> CreatePlayer(Configuration const& c_Configuration);
+    std::shared_ptr<Player> CreatePlayer(Configuration const& c_Configuration, Configuration::Session const& c_Session, std::shared_ptr<Latency::Marks>& p_Marks);
 
     //*************************************************************************************
     // Speech Check API
@@ -0,0 +1,295 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef FileDevice_h
+#define FileDevice_h
+
+// C / C++
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <string>
+
+// External
+#include <MRH_Typedefs.h>
+
+// Project
+#include "../../AudioBuffer.h"
+#include "../../../Exception.h"
+
+// Pre-defined
+#define MRH_FILE_NULL_DEVICE_PATH "null"
+#define MRH_FILE_WAV_EXTENSION ".wav"
+#define MRH_FILE_WAV_HEADER_SIZE 44
+#define MRH_FILE_FD_INVALID -1
+
+
+namespace FileDevice
+{
+    //*************************************************************************************
+    // Read / Write
+    //*************************************************************************************
+
+    /**
+     *  Read bytes from a file descriptor until the size is reached, the
+     *  file ended or no more bytes are available.
+     *
+     *  \param i_FD The file descriptor to read from.
+     *  \param p_Bytes The bytes to read into.
+     *  \param us_Size The amount of bytes to read.
+     *
+     *  \return The amount of bytes read.
+     */
+
+    inline size_t Read(int i_FD, void* p_Bytes, size_t us_Size)
+    {
+        MRH_Uint8* p_Pos = (MRH_Uint8*)p_Bytes;
+        size_t us_Read = 0;
+
+        while (us_Read < us_Size)
+        {
+            ssize_t ss_Result = read(i_FD, p_Pos + us_Read, us_Size - us_Read);
+
+            if (ss_Result > 0)
+            {
+                us_Read += ss_Result;
+            }
+            else if (ss_Result == 0)
+            {
+                break;
+            }
+            else if (errno == EAGAIN || errno == EWOULDBLOCK)
+            {
+                break;
+            }
+            else if (errno != EINTR)
+            {
+                throw Exception("Failed to read audio file: " +
+                                std::string(std::strerror(errno)));
+            }
+        }
+
+        return us_Read;
+    }
+
+    /**
+     *  Write bytes to a file descriptor until all bytes are written or no 
+     *  more bytes can be written.
+     *
+     *  \param i_FD The file descriptor to write to.
+     *  \param p_Bytes The bytes to write.
+     *  \param us_Size The amount of bytes to write.
+     *
+     *  \return The amount of bytes written.
+     */
+
+    inline size_t Write(int i_FD, const void* p_Bytes, size_t us_Size)
+    {
+        const MRH_Uint8* p_Pos = (const MRH_Uint8*)p_Bytes;
+        size_t us_Written = 0;
+
+        while (us_Written < us_Size)
+        {
+            ssize_t ss_Result = write(i_FD, p_Pos + us_Written, us_Size - us_Written);
+
+            if (ss_Result >= 0)
+            {
+                us_Written += ss_Result;
+            }
+            else if (errno == EAGAIN || errno == EWOULDBLOCK)
+            {
+                break;
+            }
+            else if (errno != EINTR)
+            {
+                throw Exception("Failed to write audio file: " +
+                                std::string(std::strerror(errno)));
+            }
+        }
+
+        return us_Written;
+    }
+
+    //*************************************************************************************
+    // WAV
+    //*************************************************************************************
+
+    /**
+     *  Check if a file path names a WAV file.
+     *
+     *  \param s_FilePath The file path to check.
+     *
+     *  \return true if a WAV file, false if raw PCM.
+     */
+
+    inline bool IsWAV(std::string const& s_FilePath) noexcept
+    {
+        static const size_t us_Extension = std::strlen(MRH_FILE_WAV_EXTENSION);
+
+        if (s_FilePath.size() < us_Extension)
+        {
+            return false;
+        }
+
+        return s_FilePath.compare(s_FilePath.size() - us_Extension, us_Extension, MRH_FILE_WAV_EXTENSION) == 0;
+    }
+
+    /**
+     *  Get a little endian value from WAV header bytes.
+     *
+     *  \param p_Bytes The bytes to read.
+     *  \param us_Size The size of the value in bytes.
+     *
+     *  \return The header value.
+     */
+
+    inline MRH_Uint32 GetWAVValue(const MRH_Uint8* p_Bytes, size_t us_Size) noexcept
+    {
+        MRH_Uint32 u32_Value = 0;
+
+        for (size_t i = 0; i < us_Size; ++i)
+        {
+            u32_Value |= static_cast<MRH_Uint32>(p_Bytes[i]) << (8 * i);
+        }
+
+        return u32_Value;
+    }
+
+    /**
+     *  Set a little endian value for WAV header bytes.
+     *
+     *  \param p_Bytes The bytes to write.
+     *  \param u32_Value The value to write.
+     *  \param us_Size The size of the value in bytes.
+     */
+
+    inline void SetWAVValue(MRH_Uint8* p_Bytes, MRH_Uint32 u32_Value, size_t us_Size) noexcept
+    {
+        for (size_t i = 0; i < us_Size; ++i)
+        {
+            p_Bytes[i] = static_cast<MRH_Uint8>(u32_Value >> (8 * i));
+        }
+    }
+
+    /**
+     *  Read a WAV header up to the start of the sample data. Only 16 bit mono 
+     *  PCM is accepted.
+     *
+     *  \param i_FD The file descriptor to read from.
+     *  \param u32_KHz The KHz of the file.
+     *
+     *  \return The size of the sample data in bytes.
+     */
+
+    inline MRH_Uint32 ReadWAVHeader(int i_FD, MRH_Uint32& u32_KHz)
+    {
+        MRH_Uint8 p_Chunk[12];
+
+        if (Read(i_FD, p_Chunk, 12) != 12 || std::memcmp(p_Chunk, "RIFF", 4) != 0 || std::memcmp(&(p_Chunk[8]), "WAVE", 4) != 0)
+        {
+            throw Exception("Invalid WAV file header!");
+        }
+
+        bool b_Format = false;
+
+        while (Read(i_FD, p_Chunk, 8) == 8)
+        {
+            MRH_Uint32 u32_Size = GetWAVValue(&(p_Chunk[4]), 4);
+
+            if (std::memcmp(p_Chunk, "data", 4) == 0)
+            {
+                if (b_Format == false)
+                {
+                    throw Exception("WAV file data before format!");
+                }
+
+                return u32_Size;
+            }
+            else if (std::memcmp(p_Chunk, "fmt ", 4) == 0)
+            {
+                MRH_Uint8 p_Format[16];
+
+                if (u32_Size < 16 || Read(i_FD, p_Format, 16) != 16)
+                {
+                    throw Exception("Invalid WAV file format!");
+                }
+                else if (GetWAVValue(p_Format, 2) != 1 || 
+                         GetWAVValue(&(p_Format[2]), 2) != MRH_AUDIO_BUFFER_CHANNELS || 
+                         GetWAVValue(&(p_Format[14]), 2) != 16)
+                {
+                    throw Exception("Unsupported WAV file format, 16 bit mono PCM is required!");
+                }
+
+                u32_KHz = GetWAVValue(&(p_Format[4]), 4);
+                b_Format = true;
+
+                u32_Size -= 16;
+            }
+
+            // Skip the remaining chunk, chunks are padded to even sizes
+            u32_Size += (u32_Size & 1);
+
+            while (u32_Size > 0)
+            {
+                MRH_Uint8 p_Skip[256];
+                size_t us_Skip = u32_Size < sizeof(p_Skip) ? u32_Size : sizeof(p_Skip);
+
+                if (Read(i_FD, p_Skip, us_Skip) != us_Skip)
+                {
+                    throw Exception("Unexpected end of WAV file!");
+                }
+
+                u32_Size -= us_Skip;
+            }
+        }
+
+        throw Exception("WAV file is missing sample data!");
+    }
+
+    /**
+     *  Write a 16 bit mono PCM WAV header.
+     *
+     *  \param i_FD The file descriptor to write to.
+     *  \param u32_KHz The KHz of the samples.
+     *  \param u32_DataSize The size of the sample data in bytes.
+     */
+
+    inline void WriteWAVHeader(int i_FD, MRH_Uint32 u32_KHz, MRH_Uint32 u32_DataSize)
+    {
+        MRH_Uint8 p_Header[MRH_FILE_WAV_HEADER_SIZE];
+
+        std::memcpy(p_Header, "RIFF", 4);
+        SetWAVValue(&(p_Header[4]), MRH_FILE_WAV_HEADER_SIZE - 8 + u32_DataSize, 4);
+        std::memcpy(&(p_Header[8]), "WAVEfmt ", 8);
+        SetWAVValue(&(p_Header[16]), 16, 4);
+        SetWAVValue(&(p_Header[20]), 1, 2); // PCM
+        SetWAVValue(&(p_Header[22]), MRH_AUDIO_BUFFER_CHANNELS, 2);
+        SetWAVValue(&(p_Header[24]), u32_KHz, 4);
+        SetWAVValue(&(p_Header[28]), u32_KHz * MRH_AUDIO_BUFFER_CHANNELS * sizeof(MRH_Sint16), 4);
+        SetWAVValue(&(p_Header[32]), MRH_AUDIO_BUFFER_CHANNELS * sizeof(MRH_Sint16), 2);
+        SetWAVValue(&(p_Header[34]), 16, 2);
+        std::memcpy(&(p_Header[36]), "data", 4);
+        SetWAVValue(&(p_Header[40]), u32_DataSize, 4);
+
+        if (Write(i_FD, p_Header, MRH_FILE_WAV_HEADER_SIZE) != MRH_FILE_WAV_HEADER_SIZE)
+        {
+            throw Exception("Failed to write WAV file header!");
+        }
+    }
+};
+
+
+#endif /* FileDevice_h */
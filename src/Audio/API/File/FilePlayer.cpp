@@ -0,0 +1,333 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <chrono>
+
+// External
+
+// Project
+#include "./FilePlayer.h"
+#include "../../../Latency.h"
+
+// Pre-defined
+#if FILE_PLAYER_LOG_EXTENDED > 0
+    #define FILE_PLAYER_LOG(X) MRH_LOG_INFO("{}", X)
+#else
+    #define FILE_PLAYER_LOG(X)
+#endif
+
+
+//*************************************************************************************
+// Constructor / Destructor
+//*************************************************************************************
+
+FilePlayer::FilePlayer(Configuration::FilePlayer const& c_Configuration,
+                       std::shared_ptr<Latency::Marks>& p_Marks) : Player("File Player",
+                                                                          p_Marks),
+                                                                   b_Run(false),
+                                                                   b_Playing(false),
+                                                                   c_Pending(0),
+                                                                   i_FD(MRH_FILE_FD_INVALID),
+                                                                   b_WAV(FileDevice::IsWAV(c_Configuration.s_FilePath)),
+                                                                   u32_DataSize(0),
+                                                                   us_DroppedSamples(0),
+                                                                   s_FilePath(c_Configuration.s_FilePath),
+                                                                   u32_SamplesPerFrame(c_Configuration.u32_SamplesPerFrame),
+                                                                   f32_Speed(c_Configuration.f32_Speed)
+{
+    if (u32_SamplesPerFrame == 0)
+    {
+        throw Exception("Invalid playback frame size!");
+    }
+}
+
+FilePlayer::~FilePlayer() noexcept
+{
+    Stop();
+}
+
+//*************************************************************************************
+// Playback
+//*************************************************************************************
+
+void FilePlayer::Start(AudioBuffer& c_Buffer)
+{
+    // Stop old playback first
+    // @NOTE: Also joins a thread which finished on its own
+    Stop();
+
+    if (c_Buffer.GetKHz() == 0)
+    {
+        throw Exception("Invalid playback KHz!");
+    }
+
+    Open(c_Buffer.GetKHz());
+
+    // @NOTE: No playback thread is active, no lock required
+    c_Pending.Reset(c_Buffer.GetKHz());
+    c_Pending.Add(c_Buffer);
+
+    // Start playback
+    MRH_LOG_INFO("Started audio playback.");
+
+    b_Run = true;
+    b_Playing = true;
+
+    try
+    {
+        c_Thread = std::thread(&FilePlayer::Update, this);
+    }
+    catch (std::exception& e)
+    {
+        b_Run = false;
+        b_Playing = false;
+
+        Close();
+
+        throw Exception("Failed to start playback thread: " +
+                        std::string(e.what()));
+    }
+}
+
+void FilePlayer::Append(AudioBuffer& c_Buffer)
+{
+    {
+        std::lock_guard<std::mutex> c_Guard(c_Mutex);
+
+        // @NOTE: The playback thread ends while holding the lock, playing
+        //        samples are guaranteed to include the appended ones
+        if (b_Playing == true && c_Pending.GetKHz() == c_Buffer.GetKHz())
+        {
+            c_Pending.Add(c_Buffer);
+
+            FILE_PLAYER_LOG("Appended audio, " +
+                            std::to_string(c_Pending.GetSampleCount()) +
+                            " samples queued.");
+            return;
+        }
+    }
+
+    // Nothing to append to, or the format changed
+    Start(c_Buffer);
+}
+
+void FilePlayer::Stop() noexcept
+{
+    bool b_Active = GetPlaying();
+
+    b_Run = false;
+
+    if (c_Thread.joinable() == true)
+    {
+        c_Thread.join();
+    }
+
+    b_Playing = false;
+
+    if (b_Active == true)
+    {
+        MRH_LOG_INFO("Stopped audio playback.");
+    }
+}
+
+//*************************************************************************************
+// Output
+//*************************************************************************************
+
+void FilePlayer::Open(MRH_Uint32 u32_KHz)
+{
+    u32_DataSize = 0;
+    us_DroppedSamples = 0;
+
+    // Null sinks discard all samples
+    if (s_FilePath.compare(MRH_FILE_NULL_DEVICE_PATH) == 0)
+    {
+        return;
+    }
+
+    struct stat c_Stat;
+
+    if (stat(s_FilePath.c_str(), &c_Stat) == 0 && S_ISFIFO(c_Stat.st_mode))
+    {
+        if (b_WAV == true)
+        {
+            throw Exception("Playback FIFOs only support raw PCM!");
+        }
+
+        // @NOTE: Opening for reading as well never blocks without a reader,
+        //        samples which do not fit the FIFO are dropped
+        i_FD = open(s_FilePath.c_str(), O_RDWR | O_NONBLOCK | O_CLOEXEC);
+    }
+    else if (b_WAV == true)
+    {
+        i_FD = open(s_FilePath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    }
+    else
+    {
+        i_FD = open(s_FilePath.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    }
+
+    if (i_FD < 0)
+    {
+        i_FD = MRH_FILE_FD_INVALID;
+
+        throw Exception("Failed to open playback file " +
+                        s_FilePath +
+                        ": " +
+                        std::string(std::strerror(errno)));
+    }
+
+    if (b_WAV == true)
+    {
+        try
+        {
+            // Sizes are written on close
+            FileDevice::WriteWAVHeader(i_FD, u32_KHz, 0);
+        }
+        catch (...)
+        {
+            close(i_FD);
+            i_FD = MRH_FILE_FD_INVALID;
+
+            throw;
+        }
+    }
+
+    FILE_PLAYER_LOG("Opened playback file " +
+                    s_FilePath +
+                    " (KHz: " +
+                    std::to_string(u32_KHz) +
+                    ").");
+}
+
+void FilePlayer::Close() noexcept
+{
+    if (i_FD == MRH_FILE_FD_INVALID)
+    {
+        return;
+    }
+
+    if (b_WAV == true)
+    {
+        try
+        {
+            if (lseek(i_FD, 0, SEEK_SET) < 0)
+            {
+                throw Exception("Failed to seek WAV file header!");
+            }
+
+            FileDevice::WriteWAVHeader(i_FD, c_Pending.GetKHz(), u32_DataSize);
+        }
+        catch (Exception& e)
+        {
+            MRH_LOG_ERROR("{}", e.what());
+        }
+    }
+
+    if (us_DroppedSamples > 0)
+    {
+        MRH_LOG_WARNING("Playback FIFO full, dropped {} samples!", us_DroppedSamples);
+    }
+
+    close(i_FD);
+    i_FD = MRH_FILE_FD_INVALID;
+}
+
+//*************************************************************************************
+// Update
+//*************************************************************************************
+
+void FilePlayer::Update() noexcept
+{
+    std::vector<MRH_Sint16> v_Frame(u32_SamplesPerFrame);
+    MRH_Uint32 u32_KHz = c_Pending.GetKHz();
+
+    auto c_Start = std::chrono::steady_clock::now();
+    MRH_Uint64 u64_Samples = 0;
+    bool b_FirstFrame = true;
+
+    while (b_Run == true)
+    {
+        size_t us_Length;
+
+        // Anything left to play?
+        {
+            std::lock_guard<std::mutex> c_Guard(c_Mutex);
+
+            us_Length = c_Pending.Retrieve(v_Frame.data(), v_Frame.size());
+
+            if (us_Length == 0)
+            {
+                FILE_PLAYER_LOG("No playable samples remain, stopping playback.");
+
+                b_Playing = false;
+                break;
+            }
+        }
+
+        if (i_FD != MRH_FILE_FD_INVALID)
+        {
+            try
+            {
+                size_t us_Size = us_Length * sizeof(MRH_Sint16);
+                size_t us_Written = FileDevice::Write(i_FD, v_Frame.data(), us_Size);
+
+                u32_DataSize += us_Written;
+                us_DroppedSamples += (us_Size - us_Written) / sizeof(MRH_Sint16);
+            }
+            catch (Exception& e)
+            {
+                MRH_LOG_ERROR("{}", e.what());
+
+                std::lock_guard<std::mutex> c_Guard(c_Mutex);
+
+                b_Playing = false;
+                break;
+            }
+        }
+
+        if (b_FirstFrame == true)
+        {
+            Latency::Singleton().Complete(*p_Marks,
+                                          Latency::MARK_MESSAGE_PLAYBACK,
+                                          Latency::STAGE_MESSAGE_FIRST_AUDIO);
+            b_FirstFrame = false;
+        }
+
+        // Playback lasts as long as the samples would have been played
+        // @NOTE: A speed of 0 plays as fast as possible
+        if (f32_Speed > 0.f)
+        {
+            u64_Samples += us_Length;
+
+            std::this_thread::sleep_until(c_Start + std::chrono::microseconds(static_cast<MRH_Uint64>((u64_Samples * 1000000.0) / (u32_KHz * f32_Speed))));
+        }
+    }
+
+    Close();
+}
+
+//*************************************************************************************
+// Getters
+//*************************************************************************************
+
+bool FilePlayer::GetPlaying() const noexcept
+{
+    return b_Playing;
+}
@@ -0,0 +1,148 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef FilePlayer_h
+#define FilePlayer_h
+
+// C / C++
+#include <thread>
+#include <mutex>
+#include <atomic>
+
+// External
+
+// Project
+#include "../../Player.h"
+#include "./FileDevice.h"
+#include "../../../Configuration.h"
+
+
+class FilePlayer : public Player
+{
+public:
+
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+
+    /**
+     *  Default constructor.
+     *
+     *  \param c_Configuration The configuration to setup with.
+     *  \param p_Marks The latency marks to complete with the first played frame.
+     */
+
+    FilePlayer(Configuration::FilePlayer const& c_Configuration,
+               std::shared_ptr<Latency::Marks>& p_Marks);
+
+    /**
+     *  Default destructor.
+     */
+
+    ~FilePlayer() noexcept;
+
+    //*************************************************************************************
+    // Playback
+    //*************************************************************************************
+
+    /**
+     *  Start playback.
+     */
+
+    void Start(AudioBuffer& c_Buffer) override;
+
+    /**
+     *  Append audio to the active playback. Playback is started if not active.
+     *
+     *  \param c_Buffer The audio buffer to append. The buffer is emptied.
+     */
+
+    void Append(AudioBuffer& c_Buffer) override;
+
+    /**
+     *  Stop playback.
+     */
+
+    void Stop() noexcept override;
+
+    //*************************************************************************************
+    // Getters
+    //*************************************************************************************
+
+    /**
+     *  Check if playback is active.
+     *
+     *  \return true if active, false if not.
+     */
+
+    bool GetPlaying() const noexcept override;
+
+private:
+
+    //*************************************************************************************
+    // Output
+    //*************************************************************************************
+
+    /**
+     *  Open the output file and write the WAV header if required.
+     *
+     *  \param u32_KHz The KHz of the output.
+     */
+
+    void Open(MRH_Uint32 u32_KHz);
+
+    /**
+     *  Close the output file and complete the WAV header if required.
+     */
+
+    void Close() noexcept;
+
+    //*************************************************************************************
+    // Update
+    //*************************************************************************************
+
+    /**
+     *  Playback thread update.
+     */
+
+    void Update() noexcept;
+
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+
+    std::thread c_Thread;
+    std::atomic<bool> b_Run;
+    std::atomic<bool> b_Playing;
+
+    // @NOTE: Filled by the main thread, played by the playback thread
+    std::mutex c_Mutex;
+    AudioBuffer c_Pending;
+
+    int i_FD;
+    bool b_WAV;
+    MRH_Uint32 u32_DataSize;
+    size_t us_DroppedSamples;
+
+    std::string s_FilePath;
+    MRH_Uint32 u32_SamplesPerFrame;
+    MRH_Sfloat32 f32_Speed;
+
+protected:
+
+};
+
+#endif /* FilePlayer_h */
@@ -0,0 +1,467 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <limits>
+#include <chrono>
+
+// External
+
+// Project
+#include "./FileRecorder.h"
+#include "../../AudioFeatures.h"
+#include "../../../Latency.h"
+
+// Pre-defined
+#ifndef MRH_FILE_RECORDING_POLL_MS
+    #define MRH_FILE_RECORDING_POLL_MS 100
+#endif
+#ifndef MRH_FILE_RECORDING_QUEUE_WAIT_MS
+    #define MRH_FILE_RECORDING_QUEUE_WAIT_MS 5
+#endif
+
+#if FILE_RECORDER_LOG_EXTENDED > 0
+    #define FILE_RECORDER_LOG(X) MRH_LOG_INFO("{}", X)
+#else
+    #define FILE_RECORDER_LOG(X)
+#endif
+
+
+//*************************************************************************************
+// Constructor / Destructor
+//*************************************************************************************
+
+FileRecorder::FileRecorder(Configuration::FileRecorder const& c_Configuration,
+                           std::shared_ptr<RecorderContext>& p_Context) : Recorder("File Recorder",
+                                                                                   p_Context),
+                                                                          b_Run(false),
+                                                                          b_Recording(false),
+                                                                          c_Queue(0),
+                                                                          c_PreRoll(c_Configuration.u32_PreRollSize),
+                                                                          i_FD(MRH_FILE_FD_INVALID),
+                                                                          b_FIFO(false),
+                                                                          u64_DataStart(0),
+                                                                          u64_DataSize(0),
+                                                                          u64_DataRead(0),
+                                                                          s_FilePath(c_Configuration.s_FilePath),
+                                                                          u32_KHz(c_Configuration.u32_KHz),
+                                                                          u32_SamplesPerFrame(c_Configuration.u32_SamplesPerFrame),
+                                                                          u32_TrailingFrameSizeMax(c_Configuration.u32_TrailingFrameSize),
+                                                                          u32_PreRollSize(c_Configuration.u32_PreRollSize),
+                                                                          f32_Speed(c_Configuration.f32_Speed),
+                                                                          b_Loop(c_Configuration.b_Loop)
+{
+    if (u32_SamplesPerFrame == 0)
+    {
+        throw Exception("Invalid recording frame size!");
+    }
+
+    Open();
+
+    // @NOTE: The KHz is known after opening, WAV files provide their own
+    size_t us_Capacity = u32_KHz * MRH_FILE_RECORDING_QUEUE_S;
+
+    if (us_Capacity < u32_PreRollSize + u32_SamplesPerFrame)
+    {
+        us_Capacity = u32_PreRollSize + u32_SamplesPerFrame;
+    }
+
+    c_Queue.Reset(us_Capacity);
+
+    MRH_LOG_INFO("Opened recording file {} (KHz: {}, Frame Size: {}, Speed: {}).",
+                 s_FilePath,
+                 u32_KHz,
+                 u32_SamplesPerFrame,
+                 f32_Speed);
+}
+
+FileRecorder::~FileRecorder() noexcept
+{
+    Stop();
+
+    if (i_FD != MRH_FILE_FD_INVALID)
+    {
+        close(i_FD);
+    }
+}
+
+//*************************************************************************************
+// Recording
+//*************************************************************************************
+
+void FileRecorder::Start(bool b_Clear)
+{
+    // Already recording?
+    if (GetRecording() == true && b_Clear == false)
+    {
+        return;
+    }
+
+    // @NOTE: Also joins a thread which finished on its own
+    Stop();
+
+    // Clear old recording
+    c_Queue.Clear();
+    c_PreRoll.Clear();
+
+    // Flag context
+    p_Context->b_SpeechRecorded = false;
+
+    // Start recording
+    MRH_LOG_INFO("Started audio recording.");
+
+    b_Run = true;
+    b_Recording = true;
+
+    try
+    {
+        c_Thread = std::thread(&FileRecorder::Update, this);
+    }
+    catch (std::exception& e)
+    {
+        b_Run = false;
+        b_Recording = false;
+
+        throw Exception("Failed to start recording thread: " +
+                        std::string(e.what()));
+    }
+}
+
+void FileRecorder::Stop() noexcept
+{
+    bool b_Active = GetRecording();
+
+    b_Run = false;
+
+    if (c_Thread.joinable() == true)
+    {
+        c_Thread.join();
+    }
+
+    b_Recording = false;
+
+    if (b_Active == true)
+    {
+        MRH_LOG_INFO("Stopped audio recording.");
+    }
+}
+
+//*************************************************************************************
+// Input
+//*************************************************************************************
+
+void FileRecorder::Open()
+{
+    struct stat c_Stat;
+
+    if (stat(s_FilePath.c_str(), &c_Stat) < 0)
+    {
+        throw Exception("Failed to find recording file " +
+                        s_FilePath +
+                        ": " +
+                        std::string(std::strerror(errno)));
+    }
+
+    b_FIFO = S_ISFIFO(c_Stat.st_mode);
+
+    if (b_FIFO == true)
+    {
+        if (FileDevice::IsWAV(s_FilePath) == true)
+        {
+            throw Exception("Recording FIFOs only support raw PCM!");
+        }
+
+        // @NOTE: Opening for writing as well keeps the FIFO from ending
+        //        when a writer disconnects and never blocks the open
+        i_FD = open(s_FilePath.c_str(), O_RDWR | O_NONBLOCK | O_CLOEXEC);
+    }
+    else
+    {
+        i_FD = open(s_FilePath.c_str(), O_RDONLY | O_CLOEXEC);
+    }
+
+    if (i_FD < 0)
+    {
+        i_FD = MRH_FILE_FD_INVALID;
+
+        throw Exception("Failed to open recording file " +
+                        s_FilePath +
+                        ": " +
+                        std::string(std::strerror(errno)));
+    }
+
+    try
+    {
+        if (FileDevice::IsWAV(s_FilePath) == true)
+        {
+            u64_DataSize = FileDevice::ReadWAVHeader(i_FD, u32_KHz);
+            u64_DataStart = lseek(i_FD, 0, SEEK_CUR);
+        }
+        else
+        {
+            u64_DataSize = std::numeric_limits<MRH_Uint64>::max();
+            u64_DataStart = 0;
+        }
+    }
+    catch (...)
+    {
+        close(i_FD);
+        i_FD = MRH_FILE_FD_INVALID;
+
+        throw;
+    }
+
+    if (u32_KHz == 0)
+    {
+        throw Exception("Invalid recording KHz!");
+    }
+
+    u64_DataRead = 0;
+}
+
+size_t FileRecorder::Read(MRH_Sint16* p_Samples, size_t us_Samples)
+{
+    MRH_Uint8* p_Bytes = (MRH_Uint8*)p_Samples;
+    size_t us_Size = us_Samples * sizeof(MRH_Sint16);
+    size_t us_Read = 0;
+
+    while (us_Read < us_Size && b_Run == true)
+    {
+        // Wait for the FIFO writer, the stop flag is checked in between
+        if (b_FIFO == true)
+        {
+            struct pollfd c_Poll;
+            c_Poll.fd = i_FD;
+            c_Poll.events = POLLIN;
+            c_Poll.revents = 0;
+
+            if (poll(&c_Poll, 1, MRH_FILE_RECORDING_POLL_MS) > 0)
+            {
+                us_Read += FileDevice::Read(i_FD, p_Bytes + us_Read, us_Size - us_Read);
+            }
+
+            continue;
+        }
+
+        MRH_Uint64 u64_Left = u64_DataSize - u64_DataRead;
+        size_t us_Left = us_Size - us_Read;
+
+        if (us_Left > u64_Left)
+        {
+            us_Left = static_cast<size_t>(u64_Left);
+        }
+
+        if (us_Left > 0)
+        {
+            size_t us_Result = FileDevice::Read(i_FD, p_Bytes + us_Read, us_Left);
+
+            us_Read += us_Result;
+            u64_DataRead += us_Result;
+
+            if (us_Result == us_Left)
+            {
+                continue;
+            }
+        }
+
+        // Input ended, start again if looping a file with samples
+        if (b_Loop == false || u64_DataRead == 0)
+        {
+            break;
+        }
+
+        FILE_RECORDER_LOG("Recording file ended, looping.");
+
+        if (lseek(i_FD, u64_DataStart, SEEK_SET) < 0)
+        {
+            throw Exception("Failed to loop recording file: " +
+                            std::string(std::strerror(errno)));
+        }
+
+        u64_DataRead = 0;
+    }
+
+    return us_Read / sizeof(MRH_Sint16);
+}
+
+//*************************************************************************************
+// Update
+//*************************************************************************************
+
+void FileRecorder::Update() noexcept
+{
+    std::vector<MRH_Sint16> v_Frame(u32_SamplesPerFrame);
+    SpeechChecker* p_SpeechChecker = p_Context->p_SpeechChecker.get();
+    MRH_Uint32 u32_TrailingFrameSizeCurrent = 0;
+
+    auto c_Start = std::chrono::steady_clock::now();
+    MRH_Uint64 u64_Samples = 0;
+
+    while (b_Run == true)
+    {
+        size_t us_Length;
+
+        try
+        {
+            us_Length = Read(v_Frame.data(), v_Frame.size());
+        }
+        catch (Exception& e)
+        {
+            MRH_LOG_ERROR("{}", e.what());
+            break;
+        }
+
+        if (us_Length == 0)
+        {
+            if (b_Run == true)
+            {
+                MRH_LOG_INFO("Recording file ended.");
+            }
+
+            break;
+        }
+
+        // Hand out samples at the pace they would have been recorded in
+        // @NOTE: FIFOs are paced by their writer, a speed of 0 reads as
+        //        fast as possible
+        if (b_FIFO == false && f32_Speed > 0.f)
+        {
+            u64_Samples += us_Length;
+
+            std::this_thread::sleep_until(c_Start + std::chrono::microseconds(static_cast<MRH_Uint64>((u64_Samples * 1000000.0) / (u32_KHz * f32_Speed))));
+        }
+
+        const MRH_Sint16* p_Audio = v_Frame.data();
+        AudioFeatures::Features c_Features = AudioFeatures::Measure(p_Audio,
+                                                                    us_Length,
+                                                                    p_SpeechChecker->GetThreshold());
+
+        try
+        {
+            if (p_SpeechChecker->IsSpeechFeatures(p_Audio, us_Length, c_Features) == true)
+            {
+                FILE_RECORDER_LOG("Speech recognized, adding chunk and resetting trailing sample count.");
+
+                // Speech onset, start with the audio before the chunk
+                if (p_Context->b_SpeechRecorded == false)
+                {
+                    PushPreRoll();
+                }
+
+                Add(p_Audio, us_Length);
+
+                p_Context->b_SpeechRecorded = true;
+                u32_TrailingFrameSizeCurrent = 0; // Reset, audio found again
+
+                // Accepted audio can be streamed for transcription
+                p_Context->p_EventQueue->Notify(EventQueue::EVENT_RECORDING, p_Context->us_Channel);
+
+                continue;
+            }
+        }
+        catch (Exception& e)
+        {
+            MRH_LOG_ERROR("{}", e.what());
+            continue;
+        }
+
+        if (p_Context->b_SpeechRecorded == false)
+        {
+            c_PreRoll.Add(p_Audio, us_Length);
+            continue;
+        }
+
+        // Add trailing frames?
+        if (u32_TrailingFrameSizeCurrent < u32_TrailingFrameSizeMax)
+        {
+            Add(p_Audio, us_Length);
+
+            u32_TrailingFrameSizeCurrent += us_Length;
+            p_Context->p_EventQueue->Notify(EventQueue::EVENT_RECORDING, p_Context->us_Channel);
+
+            FILE_RECORDER_LOG("No speech found, add " +
+                              std::to_string(us_Length) +
+                              " trailing samples (now " +
+                              std::to_string(u32_TrailingFrameSizeCurrent) +
+                              ")");
+            continue;
+        }
+
+        FILE_RECORDER_LOG("Recording finished, notifying...");
+        break;
+    }
+
+    // Ending, notify of audio
+    // @NOTE: Samples are queued before recording ends
+    if (p_Context->b_SpeechRecorded == true)
+    {
+        p_Context->p_Marks->Set(Latency::MARK_SPEECH_END);
+    }
+
+    b_Recording = false;
+
+    p_Context->p_EventQueue->Notify(EventQueue::EVENT_RECORDING_FINISHED, p_Context->us_Channel);
+}
+
+void FileRecorder::Add(const MRH_Sint16* p_Samples, size_t us_Samples) noexcept
+{
+    // @NOTE: File input is not lost if the main thread falls behind, wait
+    //        for free space instead of dropping samples
+    while (us_Samples > 0 && b_Run == true)
+    {
+        size_t us_Pushed = c_Queue.Push(p_Samples, us_Samples);
+
+        p_Samples += us_Pushed;
+        us_Samples -= us_Pushed;
+
+        if (us_Samples > 0)
+        {
+            p_Context->p_EventQueue->Notify(EventQueue::EVENT_RECORDING, p_Context->us_Channel);
+            std::this_thread::sleep_for(std::chrono::milliseconds(MRH_FILE_RECORDING_QUEUE_WAIT_MS));
+        }
+    }
+}
+
+void FileRecorder::PushPreRoll() noexcept
+{
+    AudioBuffer::ConstRegion c_First;
+    AudioBuffer::ConstRegion c_Second;
+
+    c_PreRoll.GetReadRegions(c_First, c_Second);
+
+    Add(c_First.p_Samples, c_First.us_Samples);
+    Add(c_Second.p_Samples, c_Second.us_Samples);
+
+    c_PreRoll.Clear();
+}
+
+//*************************************************************************************
+// Getters
+//*************************************************************************************
+
+bool FileRecorder::GetRecording() const noexcept
+{
+    return b_Recording;
+}
+
+void FileRecorder::GetRecordedAudio(AudioBuffer& c_Buffer)
+{
+    c_Buffer.Reset(u32_KHz);
+    c_Queue.Pop(c_Buffer);
+}
@@ -0,0 +1,182 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef FileRecorder_h
+#define FileRecorder_h
+
+// C / C++
+#include <thread>
+#include <atomic>
+
+// External
+
+// Project
+#include "../../Recorder.h"
+#include "../../AudioQueue.h"
+#include "../../AudioPreRoll.h"
+#include "./FileDevice.h"
+#include "../../../Configuration.h"
+
+// Pre-defined
+#ifndef MRH_FILE_RECORDING_QUEUE_S
+    #define MRH_FILE_RECORDING_QUEUE_S 10
+#endif
+
+
+class FileRecorder : public Recorder
+{
+public:
+
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+
+    /**
+     *  Default constructor.
+     *
+     *  \param c_Configuration The configuration to setup with.
+     *  \param p_Context The recorder context to use.
+     */
+
+    FileRecorder(Configuration::FileRecorder const& c_Configuration,
+                 std::shared_ptr<RecorderContext>& p_Context);
+
+    /**
+     *  Default destructor.
+     */
+
+    ~FileRecorder() noexcept;
+
+    //*************************************************************************************
+    // Recording
+    //*************************************************************************************
+
+    /**
+     *  Start recording.
+     *
+     *  \param b_Clear If the current recording should be cleared.
+     */
+
+    void Start(bool b_Clear) override;
+
+    /**
+     *  Stop recording.
+     */
+
+    void Stop() noexcept override;
+
+    //*************************************************************************************
+    // Getters
+    //*************************************************************************************
+
+    /**
+     *  Check if recording is active.
+     *
+     *  \return true if active, false if not.
+     */
+
+    bool GetRecording() const noexcept override;
+
+    /**
+     *  Get all currently recorded audio. This function can be called while
+     *  recording.
+     *
+     *  \param c_Buffer The audio buffer to store in. The buffer is overwritten.
+     */
+
+    void GetRecordedAudio(AudioBuffer& c_Buffer) override;
+
+private:
+
+    //*************************************************************************************
+    // Input
+    //*************************************************************************************
+
+    /**
+     *  Open the input file and read the WAV header if required.
+     */
+
+    void Open();
+
+    /**
+     *  Read input samples. Looped files restart, FIFOs wait for samples.
+     *
+     *  \param p_Samples The sample array to read into.
+     *  \param us_Samples The maximum amount of samples to read.
+     *
+     *  \return The amount of samples read, 0 if the input ended.
+     */
+
+    size_t Read(MRH_Sint16* p_Samples, size_t us_Samples);
+
+    //*************************************************************************************
+    // Update
+    //*************************************************************************************
+
+    /**
+     *  Recording thread update.
+     */
+
+    void Update() noexcept;
+
+    /**
+     *  Add recorded samples to the recording queue.
+     *
+     *  \param p_Samples The samples to add.
+     *  \param us_Samples The amount of samples to add.
+     */
+
+    void Add(const MRH_Sint16* p_Samples, size_t us_Samples) noexcept;
+
+    /**
+     *  Move the pre-roll samples to the recording queue.
+     */
+
+    void PushPreRoll() noexcept;
+
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+
+    std::thread c_Thread;
+    std::atomic<bool> b_Run;
+    std::atomic<bool> b_Recording;
+
+    // @NOTE: Written by the recording thread, read by the main thread
+    AudioQueue c_Queue;
+
+    // @NOTE: Only used by the recording thread
+    AudioPreRoll c_PreRoll;
+
+    int i_FD;
+    bool b_FIFO;
+    MRH_Uint64 u64_DataStart;
+    MRH_Uint64 u64_DataSize;
+    MRH_Uint64 u64_DataRead;
+
+    std::string s_FilePath;
+    MRH_Uint32 u32_KHz;
+    MRH_Uint32 u32_SamplesPerFrame;
+    MRH_Uint32 u32_TrailingFrameSizeMax;
+    MRH_Uint32 u32_PreRollSize;
+    MRH_Sfloat32 f32_Speed;
+    bool b_Loop;
+
+protected:
+
+};
+
+#endif /* FileRecorder_h */
@@ -24,7 +24,7 @@
 
 // Pre-defined
 #if PICOVOICE_COBRA_LOG_EXTENDED > 0
-    #define PICOVOICE_COBRA_LOG(X) Logger::Singleton().Log(Logger::INFO, X, "PicovoiceCobra.cpp", __LINE__)
+    #define PICOVOICE_COBRA_LOG(X) MRH_LOG_INFO("{}", X)
 #else
     #define PICOVOICE_COBRA_LOG(X)
 #endif
@@ -72,12 +72,9 @@ PicovoiceCobra::~PicovoiceCobra() noexcept
 // Check
 //*************************************************************************************
 
-bool PicovoiceCobra::IsSpeech(AudioBuffer::AudioChunk const& v_Chunk)
+bool PicovoiceCobra::IsSpeech(const MRH_Sint16* p_Samples, size_t us_Samples)
 {
-    Logger& c_Logger = Logger::Singleton();
-    size_t us_SampleCount = v_Chunk.size();
-
-    if (us_SampleCount == 0)
+    if (us_Samples == 0)
     {
         PICOVOICE_COBRA_LOG("No samples to process!");
         return false;
@@ -87,32 +84,31 @@ bool PicovoiceCobra::IsSpeech(AudioBuffer::AudioChunk const& v_Chunk)
     float f32_Confidence;
     size_t us_Pos = 0;
 
-    while (us_Pos < us_SampleCount)
-    {
-        // Cobra wants a specific sample rate
-        int32_t s32_RequiredSamples = pv_cobra_frame_length();
+    // Cobra wants a specific sample rate
+    size_t us_RequiredSamples = static_cast<size_t>(pv_cobra_frame_length());
 
+    while (us_Pos < us_Samples)
+    {
         PICOVOICE_COBRA_LOG("Required sample count: " +
-                            std::to_string(s32_RequiredSamples) +
+                            std::to_string(us_RequiredSamples) +
                             ", available sample count: " +
-                            std::to_string(us_SampleCount) +
+                            std::to_string(us_Samples) +
                             ", current position: " +
                             std::to_string(us_Pos));
 
         // Got enough samples to check for voice?
-        if (s32_RequiredSamples > (us_SampleCount - us_Pos))
+        if (us_RequiredSamples > (us_Samples - us_Pos))
         {
             PICOVOICE_COBRA_LOG("Not enough samples!");
             return false;
         }
 
         // Process
-        e_Status = pv_cobra_process(p_Handle, &(v_Chunk[us_Pos]), &f32_Confidence);
+        e_Status = pv_cobra_process(p_Handle, &(p_Samples[us_Pos]), &f32_Confidence);
 
         if (e_Status != PV_STATUS_SUCCESS)
         {
-            c_Logger.Log(Logger::WARNING, pv_status_to_string(e_Status),
-                         "PicovoiceCobra.cpp", __LINE__);
+            MRH_LOG_WARNING("{}", pv_status_to_string(e_Status));
             return false;
         }
 
@@ -126,7 +122,7 @@ bool PicovoiceCobra::IsSpeech(AudioBuffer::AudioChunk const& v_Chunk)
             return true;
         }
 
-        us_Pos += s32_RequiredSamples;
+        us_Pos += us_RequiredSamples;
     }
 
     // Default
@@ -56,12 +56,13 @@ public:
     /**
      *  Check if a audio chunk contains speech.
      *
-     *  \param v_Chunk The chunk to check.
+     *  \param p_Samples The chunk samples to check.
+     *  \param us_Samples The amount of chunk samples.
      *
      *  \return true if speech was found, false if not.
      */
 
-    bool IsSpeech(AudioBuffer::AudioChunk const& v_Chunk) override;
+    bool IsSpeech(const MRH_Sint16* p_Samples, size_t us_Samples) override;
 
 private:
 
@@ -18,13 +18,20 @@
 #define SDL2PlaybackContext_h
 
 // C / C++
+#include <atomic>
 
 // External
 #include <SDL2/SDL.h>
 
 // Project
 #include "./SDL2Device.h"
-#include "../../AudioBuffer.h"
+#include "../../AudioQueue.h"
+#include "../../../Latency.h"
+
+// Pre-defined
+#ifndef MRH_SDL2_PLAYBACK_QUEUE_S
+    #define MRH_SDL2_PLAYBACK_QUEUE_S 10
+#endif
 
 
 struct SDL2PlaybackContext
@@ -37,17 +44,29 @@ public:
 
     /**
      *  Default constructor.
+     *
+     *  \param p_Marks The latency marks to complete with the first played frame.
      */
 
-    SDL2PlaybackContext() noexcept : c_Buffer(0),
-                                     u32_DeviceID(MRH_SDL2_AUDIO_DEVICE_ID_INVALID)
+    SDL2PlaybackContext(std::shared_ptr<Latency::Marks>& p_Marks) : c_Queue(0),
+                                                                     b_FirstFrame(false),
+                                                                     p_Marks(p_Marks),
+                                                                     u32_KHz(0),
+                                                                     u32_DeviceID(MRH_SDL2_AUDIO_DEVICE_ID_INVALID)
     {}
 
     //*************************************************************************************
     // Data
     //*************************************************************************************
 
-    AudioBuffer c_Buffer;
+    // @NOTE: Written by the main thread, read by the audio callback
+    AudioQueue c_Queue;
+
+    // @NOTE: Set by the main thread, cleared by the first played frame
+    std::atomic<bool> b_FirstFrame;
+    std::shared_ptr<Latency::Marks> p_Marks;
+
+    MRH_Uint32 u32_KHz;
 
     SDL_AudioDeviceID u32_DeviceID;
 };
@@ -21,10 +21,11 @@
 
 // Project
 #include "./SDL2Player.h"
+#include "../../../Latency.h"
 
 // Pre-defined
 #if SDL2_PLAYER_LOG_EXTENDED > 0
-    #define SDL2_PLAYER_LOG(X) Logger::Singleton().Log(Logger::INFO, X, "SDL2Player.cpp", __LINE__)
+    #define SDL2_PLAYER_LOG(X) MRH_LOG_INFO("{}", X)
 #else
     #define SDL2_PLAYER_LOG(X)
 #endif
@@ -34,12 +35,14 @@
 // Constructor / Destructor
 //*************************************************************************************
 
-SDL2Player::SDL2Player(Configuration::SDL2Player const& c_Configuration) : Player("SDL2 Player"),
-                                                                           p_Context(NULL),
-                                                                           s_DeviceName(c_Configuration.s_DeviceName),
-                                                                           u32_SamplesPerFrame(c_Configuration.u32_SamplesPerFrame)
+SDL2Player::SDL2Player(Configuration::SDL2Player const& c_Configuration,
+                       std::shared_ptr<Latency::Marks>& p_Marks) : Player("SDL2 Player",
+                                                                          p_Marks),
+                                                                   p_Context(NULL),
+                                                                   s_DeviceName(c_Configuration.s_DeviceName),
+                                                                   u32_SamplesPerFrame(c_Configuration.u32_SamplesPerFrame)
 {
-    p_Context = new SDL2PlaybackContext();
+    p_Context = new SDL2PlaybackContext(p_Marks);
 }
 
 SDL2Player::~SDL2Player() noexcept
@@ -59,26 +62,45 @@ void SDL2Player::Start(AudioBuffer& c_Buffer)
     // Stop old playback first
     Stop();
 
-    // Now Reset buffer with new info
-    p_Context->c_Buffer.Reset(c_Buffer);
+    // A open device with a different KHz has to be reopened
+    if (p_Context->u32_DeviceID != MRH_SDL2_AUDIO_DEVICE_ID_INVALID && p_Context->u32_KHz != c_Buffer.GetKHz())
+    {
+        SDL_CloseAudioDevice(p_Context->u32_DeviceID);
+        p_Context->u32_DeviceID = MRH_SDL2_AUDIO_DEVICE_ID_INVALID;
+    }
+
+    // Now refill queue with new info
+    // @NOTE: The device is paused or closed, the callback does not consume samples
+    size_t us_Capacity = c_Buffer.GetKHz() * MRH_SDL2_PLAYBACK_QUEUE_S;
+
+    if (us_Capacity < c_Buffer.GetSampleCount())
+    {
+        us_Capacity = c_Buffer.GetSampleCount();
+    }
+
+    if (us_Capacity < p_Context->c_Queue.GetCapacity())
+    {
+        us_Capacity = p_Context->c_Queue.GetCapacity();
+    }
+
+    p_Context->c_Queue.Reset(us_Capacity);
+    p_Context->c_Queue.Push(c_Buffer);
+    p_Context->u32_KHz = c_Buffer.GetKHz();
+    p_Context->b_FirstFrame = true;
 
     // Open playback device if needed
     if (p_Context->u32_DeviceID == MRH_SDL2_AUDIO_DEVICE_ID_INVALID)
     {
-        Logger::Singleton().Log(Logger::INFO, "Opening playback device " +
-                                              s_DeviceName +
-                                              " (KHz: " +
-                                              std::to_string(p_Context->c_Buffer.GetKHz()) +
-                                              ", Frame Size: " +
-                                              std::to_string(u32_SamplesPerFrame) +
-                                              ") ...",
-                                "SDL2Player.cpp", __LINE__);
+        MRH_LOG_INFO("Opening playback device {} (KHz: {}, Frame Size: {}) ...",
+                     s_DeviceName,
+                     p_Context->u32_KHz,
+                     u32_SamplesPerFrame);
         SDL_AudioSpec c_Want;
         SDL_AudioSpec c_Have;
 
         SDL_zero(c_Want);
 
-        c_Want.freq = c_Buffer.GetKHz();
+        c_Want.freq = p_Context->u32_KHz;
         c_Want.format = AUDIO_S16SYS;
         c_Want.channels = MRH_AUDIO_BUFFER_CHANNELS;
         c_Want.samples = u32_SamplesPerFrame;
@@ -109,25 +131,59 @@ void SDL2Player::Start(AudioBuffer& c_Buffer)
 
         if (s_DeviceName.compare(MRH_SDL2_DEFAULT_DEVICE_NAME) == 0)
         {
-            Logger::Singleton().Log(Logger::INFO, "Opened system default playback device.",
-                                    "SDL2Player.cpp", __LINE__);
+            MRH_LOG_INFO("Opened system default playback device.");
         }
         else
         {
-            Logger::Singleton().Log(Logger::INFO, "Opened playback device " +
-                                                  s_DeviceName +
-                                                  ".",
-                                    "SDL2Player.cpp", __LINE__);
+            MRH_LOG_INFO("Opened playback device {}.", s_DeviceName);
         }
     }
 
     // Start playback
-    Logger::Singleton().Log(Logger::INFO, "Started audio playback.",
-                            "SDL2Player.cpp", __LINE__);
+    MRH_LOG_INFO("Started audio playback.");
 
     SDL_PauseAudioDevice(p_Context->u32_DeviceID, 0);
 }
 
+void SDL2Player::Append(AudioBuffer& c_Buffer)
+{
+    // Nothing to append to, or the format changed?
+    if (p_Context->u32_DeviceID == MRH_SDL2_AUDIO_DEVICE_ID_INVALID || p_Context->u32_KHz != c_Buffer.GetKHz())
+    {
+        Start(c_Buffer);
+        return;
+    }
+
+    size_t us_Required = p_Context->c_Queue.GetSampleCount() + c_Buffer.GetSampleCount();
+
+    if (us_Required <= p_Context->c_Queue.GetCapacity())
+    {
+        // @NOTE: The queue allows pushing while the callback pops
+        p_Context->c_Queue.Push(c_Buffer);
+    }
+    else
+    {
+        // Grow the queue, the callback has to be held while it is replaced
+        AudioBuffer c_Pending(p_Context->u32_KHz);
+
+        SDL_LockAudioDevice(p_Context->u32_DeviceID);
+
+        p_Context->c_Queue.Pop(c_Pending);
+        p_Context->c_Queue.Reset(c_Pending.GetSampleCount() + c_Buffer.GetSampleCount());
+        p_Context->c_Queue.Push(c_Pending);
+        p_Context->c_Queue.Push(c_Buffer);
+
+        SDL_UnlockAudioDevice(p_Context->u32_DeviceID);
+    }
+
+    SDL2_PLAYER_LOG("Appended audio, " +
+                    std::to_string(p_Context->c_Queue.GetSampleCount()) +
+                    " samples queued.");
+
+    // The callback pauses the device once the queue runs empty
+    SDL_PauseAudioDevice(p_Context->u32_DeviceID, 0);
+}
+
 void SDL2Player::Stop() noexcept
 {
     if (GetPlaying() == false)
@@ -135,8 +191,7 @@ void SDL2Player::Stop() noexcept
         return;
     }
 
-    Logger::Singleton().Log(Logger::INFO, "Stopped audio playback.",
-                            "SDL2Player.cpp", __LINE__);
+    MRH_LOG_INFO("Stopped audio playback.");
 
     SDL_PauseAudioDevice(p_Context->u32_DeviceID, 1);
     SDL_CloseAudioDevice(p_Context->u32_DeviceID);
@@ -152,76 +207,39 @@ void SDL2Player::Callback(void* p_Context, Uint8* p_Stream, int i_Length) noexce
 {
     SDL2PlaybackContext* p_SDL2Context = (SDL2PlaybackContext*)p_Context;
 
-    // Anything left to play?
-    if (p_SDL2Context->c_Buffer.GetChunkCount() == 0)
+    if (i_Length <= 0)
     {
-        SDL2_PLAYER_LOG("No playable chunks remain, stopping playback.");
-
-        // Zero buffer
-        memset(p_Stream, 0, i_Length);
-
-        // No samples left, no longer playing
-        // @NOTE: PauseAudioDevice locks the audio device!
-        SDL_PauseAudioDevice(p_SDL2Context->u32_DeviceID, 1);
         return;
     }
 
-    SDL2_PLAYER_LOG("Playback requested " +
-                    std::to_string(i_Length) +
-                    " bytes.");
+    size_t us_Length = static_cast<size_t>(i_Length); // Bytes!
 
-    // Audio remains, copy
-    AudioBuffer::AudioChunk v_Chunk;
-    size_t us_Written = 0;
+    // @NOTE: The queue read position is the playback cursor, a partially played
+    //        region stays in place for the next callback. Each call is at most
+    //        two copies and a zero fill without any allocation.
+    size_t us_Written = p_SDL2Context->c_Queue.Pop((MRH_Sint16*)p_Stream, us_Length / sizeof(MRH_Sint16)) * sizeof(MRH_Sint16); // Bytes!
 
-    while (us_Written < i_Length)
+    if (us_Written < us_Length)
     {
-        // Get first
-        if (p_SDL2Context->c_Buffer.Retrieve(v_Chunk) == false)
-        {
-            SDL2_PLAYER_LOG("No playable chunks remain, zeroing remaining stream.");
-
-            // No audio left, zero and return
-            memset(&(p_Stream[us_Written]), 0, (i_Length - us_Written));
-            return;
-        }
-        else if (v_Chunk.empty() == true)
-        {
-            SDL2_PLAYER_LOG("Empty chunk received from playback buffer!");
-            continue;
-        }
-
-        // Get the size required to fill the buffer
-        size_t us_ChunkSize = v_Chunk.size() * sizeof(MRH_Sint16); // Bytes!
-        size_t us_ToWrite = i_Length - us_Written;
-
-        if (us_ChunkSize < us_ToWrite)
-        {
-            us_ToWrite = us_ChunkSize;
-        }
-
-        SDL2_PLAYER_LOG("Writing " +
-                        std::to_string(us_ToWrite) +
-                        " sample bytes from chunk with byte size " +
-                        std::to_string(us_ChunkSize) +
-                        " to stream.");
-
-        // Copy to buffer
-        memcpy(&(p_Stream[us_Written]), &(v_Chunk[0]), us_ToWrite);
+        memset(&(p_Stream[us_Written]), 0, (us_Length - us_Written));
+    }
 
-        // Remember size
-        us_Written += us_ToWrite;
+    if (us_Written > 0 && p_SDL2Context->b_FirstFrame.exchange(false) == true)
+    {
+        Latency::Singleton().Complete(*(p_SDL2Context->p_Marks),
+                                      Latency::MARK_MESSAGE_PLAYBACK,
+                                      Latency::STAGE_MESSAGE_FIRST_AUDIO);
+    }
 
-        // Re-add remaining buffer?
-        if (us_ToWrite < us_ChunkSize)
-        {
-            SDL2_PLAYER_LOG("Readding chunk with byte size " +
-                            std::to_string((us_ChunkSize - us_ToWrite)) +
-                            " to buffer.");
+    // Anything left to play?
+    if (us_Written == 0)
+    {
+        SDL2_PLAYER_LOG("No playable samples remain, stopping playback.");
 
-            v_Chunk.erase(v_Chunk.begin() + (us_ToWrite / sizeof(MRH_Sint16)));
-            p_SDL2Context->c_Buffer.Add(v_Chunk, true);
-        }
+        // No samples left, no longer playing
+        // @NOTE: PauseAudioDevice locks the audio device, which is already
+        //        held by the callback!
+        SDL_PauseAudioDevice(p_SDL2Context->u32_DeviceID, 1);
     }
 }
 
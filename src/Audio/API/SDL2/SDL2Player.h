@@ -39,9 +39,11 @@ public:
      *  Default constructor.
      *
      *  \param c_Configuration The configuration to setup with.
+     *  \param p_Marks The latency marks to complete with the first played frame.
      */
 
-    SDL2Player(Configuration::SDL2Player const& c_Configuration);
+    SDL2Player(Configuration::SDL2Player const& c_Configuration,
+               std::shared_ptr<Latency::Marks>& p_Marks);
 
     /**
      *  Default destructor.
@@ -59,6 +61,14 @@ public:
 
     void Start(AudioBuffer& c_Buffer) override;
 
+    /**
+     *  Append audio to the active playback. Playback is started if not active.
+     *
+     *  \param c_Buffer The audio buffer to append. The buffer is emptied.
+     */
+
+    void Append(AudioBuffer& c_Buffer) override;
+
     /**
      *  Stop playback.
      */
@@ -77,14 +87,13 @@ public:
 
     bool GetPlaying() const noexcept override;
 
-private:
-
     //*************************************************************************************
     // Callback
     //*************************************************************************************
 
     /**
-     *  Audio playback callback.
+     *  Audio playback callback. Called by SDL2 on the audio thread, public to
+     *  be driven without a device.
      *
      *  \param p_Context The callback context.
      *  \param p_Stream The audio stream bytes to write.
@@ -93,6 +102,8 @@ private:
 
     static void Callback(void* p_Context, Uint8* p_Stream, int i_Length) noexcept;
 
+private:
+
     //*************************************************************************************
     // Data
     //*************************************************************************************
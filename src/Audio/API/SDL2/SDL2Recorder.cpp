@@ -15,16 +15,18 @@
  */
 
 // C / C++
+#include <cstring>
 
 // External
 #include <SDL2/SDL.h>
 
 // Project
 #include "./SDL2Recorder.h"
+#include "../../../Latency.h"
 
 // Pre-defined
 #if SDL2_RECORDER_LOG_EXTENDED > 0
-    #define SDL2_RECORDER_LOG(X) Logger::Singleton().Log(Logger::INFO, X, "SDL2Recorder.cpp", __LINE__)
+    #define SDL2_RECORDER_LOG(X) MRH_LOG_INFO("{}", X)
 #else
     #define SDL2_RECORDER_LOG(X)
 #endif
@@ -42,6 +44,7 @@ SDL2Recorder::SDL2Recorder(Configuration::SDL2Recorder const& c_Configuration,
 {
     this->p_Context = new SDL2RecordingContext(c_Configuration.u32_KHz,
                                                c_Configuration.u32_TrailingFrameSize,
+                                               c_Configuration.u32_PreRollSize,
                                                c_Configuration.f32_Amplification,
                                                p_Context);
 }
@@ -74,29 +77,28 @@ void SDL2Recorder::Start(bool b_Clear)
     }
 
     // Clear old recording
-    p_Context->c_Buffer.Clear();
+    // @NOTE: The device is paused, the callback does not produce samples
+    p_Context->c_Queue.Clear();
+    p_Context->us_DroppedSamples = 0;
 
     // Flag context
     p_Context->p_Context->b_SpeechRecorded = false;
     p_Context->u32_TrailingFrameSizeCurrent = 0;
+    p_Context->c_PreRoll.Clear();
 
     // Open playback device if needed
     if (p_Context->u32_DeviceID == MRH_SDL2_AUDIO_DEVICE_ID_INVALID)
     {
-        Logger::Singleton().Log(Logger::INFO, "Opening recording device " +
-                                              s_DeviceName +
-                                              " (KHz: " +
-                                              std::to_string(p_Context->c_Buffer.GetKHz()) +
-                                              ", Frame Size: " +
-                                              std::to_string(u32_SamplesPerFrame) +
-                                              ") ...",
-                                "SDL2Recorder.cpp", __LINE__);
+        MRH_LOG_INFO("Opening recording device {} (KHz: {}, Frame Size: {}) ...",
+                     s_DeviceName,
+                     p_Context->u32_KHz,
+                     u32_SamplesPerFrame);
         SDL_AudioSpec c_Want;
         SDL_AudioSpec c_Have;
 
         SDL_zero(c_Want);
 
-        c_Want.freq = p_Context->c_Buffer.GetKHz();
+        c_Want.freq = p_Context->u32_KHz;
         c_Want.format = AUDIO_S16SYS;
         c_Want.channels = MRH_AUDIO_BUFFER_CHANNELS;
         c_Want.samples = u32_SamplesPerFrame;
@@ -126,27 +128,21 @@ void SDL2Recorder::Start(bool b_Clear)
         }
         else if (c_Have.samples != c_Want.samples)
         {
-            Logger::Singleton().Log(Logger::WARNING, "Sample rate changed by SDL2!",
-                                    "SDL2Recorder.cpp", __LINE__);
+            MRH_LOG_WARNING("Sample rate changed by SDL2!");
         }
 
         if (s_DeviceName.compare(MRH_SDL2_DEFAULT_DEVICE_NAME) == 0)
         {
-            Logger::Singleton().Log(Logger::INFO, "Opened system default recording device.",
-                                    "SDL2Recorder.cpp", __LINE__);
+            MRH_LOG_INFO("Opened system default recording device.");
         }
         else
         {
-            Logger::Singleton().Log(Logger::INFO, "Opened recording device: " +
-                                                  s_DeviceName +
-                                                  ".",
-                                    "SDL2Recorder.cpp", __LINE__);
+            MRH_LOG_INFO("Opened recording device: {}.", s_DeviceName);
         }
     }
 
     // Start recording
-    Logger::Singleton().Log(Logger::INFO, "Started audio recording.",
-                            "SDL2Recorder.cpp", __LINE__);
+    MRH_LOG_INFO("Started audio recording.");
 
     SDL_PauseAudioDevice(p_Context->u32_DeviceID, 0);
 }
@@ -158,13 +154,15 @@ void SDL2Recorder::Stop() noexcept
         return;
     }
 
-    Logger::Singleton().Log(Logger::INFO, "Stopped audio recording.",
-                            "SDL2Recorder.cpp", __LINE__);
+    MRH_LOG_INFO("Stopped audio recording.");
 
     SDL_PauseAudioDevice(p_Context->u32_DeviceID, 1);
     SDL_CloseAudioDevice(p_Context->u32_DeviceID);
 
     p_Context->u32_DeviceID = MRH_SDL2_AUDIO_DEVICE_ID_INVALID;
+
+    // Recorded speech has to be finished
+    p_Context->p_Context->p_EventQueue->Notify(EventQueue::EVENT_RECORDING_FINISHED, p_Context->p_Context->us_Channel);
 }
 
 //*************************************************************************************
@@ -180,66 +178,71 @@ void SDL2Recorder::Callback(void* p_Context, Uint8* p_Stream, int i_Length) noex
         return;
     }
 
-    MRH_Sint16* p_Audio = (MRH_Sint16*)p_Stream;
+    // @NOTE: Samples are amplified straight into the free queue region and
+    //        only committed if kept. The stream is amplified in place if the
+    //        free region is wrapped or too small, or before speech was found
+    //        when the pre-roll has to be added first.
+    const MRH_Sint16* p_Input = (const MRH_Sint16*)p_Stream;
     size_t us_Length = i_Length / sizeof(MRH_Sint16);
+    AudioBuffer::Region c_First;
+    AudioBuffer::Region c_Second;
 
-    AudioBuffer::AudioChunk v_Chunk(p_Audio,
-                                    p_Audio + us_Length);
+    p_SDL2Context->c_Queue.GetWriteRegions(c_First, c_Second);
 
-    SDL2_RECORDER_LOG("Amplifying recorded samples by " +
-                      std::to_string(p_SDL2Context->f32_Amplification) +
-                      ".");
+    bool b_Written = p_SDL2Context->p_Context->b_SpeechRecorded == true && c_First.us_Samples >= us_Length;
+    MRH_Sint16* p_Audio = b_Written ? c_First.p_Samples : (MRH_Sint16*)p_Stream;
 
-    for (auto& Sample : v_Chunk)
-    {
-        MRH_Sint32 s32_Sample = Sample * p_SDL2Context->f32_Amplification;
+    SpeechChecker* p_SpeechChecker = p_SDL2Context->p_Context->p_SpeechChecker.get();
 
-        if (s32_Sample > INT16_MAX)
-        {
-            Sample = INT16_MAX;
-        }
-        else if (s32_Sample < INT16_MIN)
-        {
-            Sample = INT16_MIN;
-        }
-        else
-        {
-            Sample = static_cast<MRH_Sint16>(s32_Sample);
-        }
-    }
+    // Convert, amplify and measure in one pass
+    AudioFeatures::Features c_Features = AudioFeatures::Amplify(p_Input,
+                                                                p_Audio,
+                                                                us_Length,
+                                                                p_SDL2Context->f32_Amplification,
+                                                                p_SpeechChecker->GetThreshold());
 
     try
     {
-        if (p_SDL2Context->p_Context->p_SpeechChecker->IsSpeech(v_Chunk) == true)
+        if (p_SpeechChecker->IsSpeechFeatures(p_Audio, us_Length, c_Features) == true)
         {
             SDL2_RECORDER_LOG("Speech recognized, adding chunk and resetting trailing sample count.");
 
-            p_SDL2Context->c_Buffer.Add(v_Chunk, false);
+            // Speech onset, start with the audio before the chunk
+            if (p_SDL2Context->p_Context->b_SpeechRecorded == false)
+            {
+                PushPreRoll(p_SDL2Context);
+            }
+
+            Add(p_SDL2Context, p_Audio, us_Length, b_Written);
 
             p_SDL2Context->p_Context->b_SpeechRecorded = true;
             p_SDL2Context->u32_TrailingFrameSizeCurrent = 0; // Reset, audio found again
 
+            // Accepted audio can be streamed for transcription
+            p_SDL2Context->p_Context->p_EventQueue->Notify(EventQueue::EVENT_RECORDING, p_SDL2Context->p_Context->us_Channel);
+
             return;
         }
     }
     catch (Exception& e)
     {
-        Logger::Singleton().Log(Logger::ERROR, e.what(),
-                                "SDL2Recorder.cpp", __LINE__);
+        MRH_LOG_ERROR("{}", e.what());
         return;
     }
 
     if (p_SDL2Context->p_Context->b_SpeechRecorded == false)
     {
+        p_SDL2Context->c_PreRoll.Add(p_Audio, us_Length);
         return;
     }
 
     // Add trailing frames?
     if (p_SDL2Context->u32_TrailingFrameSizeCurrent < p_SDL2Context->u32_TrailingFrameSizeMax)
     {
-        p_SDL2Context->c_Buffer.Add(v_Chunk, false);
+        Add(p_SDL2Context, p_Audio, us_Length, b_Written);
 
         p_SDL2Context->u32_TrailingFrameSizeCurrent += us_Length;
+        p_SDL2Context->p_Context->p_EventQueue->Notify(EventQueue::EVENT_RECORDING, p_SDL2Context->p_Context->us_Channel);
 
         SDL2_RECORDER_LOG("No speech found, add " +
                           std::to_string(us_Length) +
@@ -254,7 +257,38 @@ void SDL2Recorder::Callback(void* p_Context, Uint8* p_Stream, int i_Length) noex
 
     SDL_PauseAudioDevice(p_SDL2Context->u32_DeviceID, 1);
 
-    p_SDL2Context->p_Context->p_Notifier->Notify(false);
+    p_SDL2Context->p_Context->p_Marks->Set(Latency::MARK_SPEECH_END);
+    p_SDL2Context->p_Context->p_EventQueue->Notify(EventQueue::EVENT_RECORDING_FINISHED, p_SDL2Context->p_Context->us_Channel);
+}
+
+void SDL2Recorder::Add(SDL2RecordingContext* p_Context, const MRH_Sint16* p_Samples, size_t us_Samples, bool b_Written) noexcept
+{
+    if (b_Written == true)
+    {
+        p_Context->c_Queue.Commit(us_Samples);
+        return;
+    }
+
+    size_t us_Pushed = p_Context->c_Queue.Push(p_Samples, us_Samples);
+
+    // @NOTE: No logging here, the audio thread should never block
+    if (us_Pushed < us_Samples)
+    {
+        p_Context->us_DroppedSamples += (us_Samples - us_Pushed);
+    }
+}
+
+void SDL2Recorder::PushPreRoll(SDL2RecordingContext* p_Context) noexcept
+{
+    AudioBuffer::ConstRegion c_First;
+    AudioBuffer::ConstRegion c_Second;
+
+    p_Context->c_PreRoll.GetReadRegions(c_First, c_Second);
+
+    Add(p_Context, c_First.p_Samples, c_First.us_Samples, false);
+    Add(p_Context, c_Second.p_Samples, c_Second.us_Samples, false);
+
+    p_Context->c_PreRoll.Clear();
 }
 
 //*************************************************************************************
@@ -273,10 +307,15 @@ bool SDL2Recorder::GetRecording() const noexcept
 
 void SDL2Recorder::GetRecordedAudio(AudioBuffer& c_Buffer)
 {
-    if (GetRecording() == true)
+    // @NOTE: Draining is allowed while recording, the callback keeps
+    //        pushing into the queue
+    c_Buffer.Reset(p_Context->u32_KHz);
+    p_Context->c_Queue.Pop(c_Buffer);
+
+    size_t us_Dropped = p_Context->us_DroppedSamples.exchange(0);
+
+    if (us_Dropped > 0)
     {
-        throw Exception("Cannot get recorded audio while recording!");
+        MRH_LOG_WARNING("Recording queue full, dropped {} samples!", us_Dropped);
     }
-
-    c_Buffer.Reset(p_Context->c_Buffer);
 }
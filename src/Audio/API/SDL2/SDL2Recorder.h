@@ -82,29 +82,54 @@ public:
     bool GetRecording() const noexcept override;
 
     /**
-     *  Get all currently recorded audio.
+     *  Get all currently recorded audio. This function can be called while
+     *  recording.
      *
      *  \param c_Buffer The audio buffer to store in. The buffer is overwritten.
      */
 
     void GetRecordedAudio(AudioBuffer& c_Buffer) override;
 
-private:
-
     //*************************************************************************************
     // Callback
     //*************************************************************************************
 
     /**
-     *  Audio recording callback.
+     *  Audio recording callback. Called by SDL2 on the audio thread, public to
+     *  be driven without a device.
      *
      *  \param p_Context The callback context.
-     *  \param p_Stream The audio stream bytes to write.
-     *  \param i_Length The required length to write in bytes.
+     *  \param p_Stream The audio stream bytes to read.
+     *  \param i_Length The length of the audio stream in bytes.
      */
 
     static void Callback(void* p_Context, Uint8* p_Stream, int i_Length) noexcept;
 
+private:
+
+    //*************************************************************************************
+    // Callback
+    //*************************************************************************************
+
+    /**
+     *  Add recorded samples to the recording queue.
+     *
+     *  \param p_Context The recording context to add to.
+     *  \param p_Samples The samples to add.
+     *  \param us_Samples The amount of samples to add.
+     *  \param b_Written If the samples were written to the free queue region.
+     */
+
+    static void Add(SDL2RecordingContext* p_Context, const MRH_Sint16* p_Samples, size_t us_Samples, bool b_Written) noexcept;
+
+    /**
+     *  Move the pre-roll samples to the recording queue.
+     *
+     *  \param p_Context The recording context to move the samples for.
+     */
+
+    static void PushPreRoll(SDL2RecordingContext* p_Context) noexcept;
+
     //*************************************************************************************
     // Data
     //*************************************************************************************
@@ -18,15 +18,23 @@
 #define SDL2RecordingContext_h
 
 // C / C++
+#include <atomic>
+#include <vector>
 
 // External
 #include <SDL2/SDL.h>
 
 // Project
 #include "./SDL2Device.h"
-#include "../../AudioBuffer.h"
+#include "../../AudioQueue.h"
+#include "../../AudioPreRoll.h"
 #include "../../RecorderContext.h"
 
+// Pre-defined
+#ifndef MRH_SDL2_RECORDING_QUEUE_S
+    #define MRH_SDL2_RECORDING_QUEUE_S 10
+#endif
+
 
 struct SDL2RecordingContext
 {
@@ -41,29 +49,42 @@ public:
      *
      *  \param u32_KHz The recording KHz.
      *  \param u32_TrailingFrameSizeMax The amount of samples allowed to append with no speech.
+     *  \param u32_PreRollSize The amount of samples kept before speech is detected.
+     *  \param f32_Amplification The amplification applied to recorded samples.
      *  \param p_Context The recorder context to manage.
      */
 
     SDL2RecordingContext(MRH_Uint32 u32_KHz,
                          MRH_Uint32 u32_TrailingFrameSizeMax,
+                         MRH_Uint32 u32_PreRollSize,
                          MRH_Sfloat32 f32_Amplification,
-                         std::shared_ptr<RecorderContext>& p_Context) noexcept : c_Buffer(u32_KHz),
-                                                                                 u32_TrailingFrameSizeCurrent(0),
-                                                                                 u32_TrailingFrameSizeMax(u32_TrailingFrameSizeMax),
-                                                                                 f32_Amplification(f32_Amplification),
-                                                                                 u32_DeviceID(MRH_SDL2_AUDIO_DEVICE_ID_INVALID),
-                                                                                 p_Context(p_Context)
+                         std::shared_ptr<RecorderContext>& p_Context) : c_Queue(u32_KHz * MRH_SDL2_RECORDING_QUEUE_S),
+                                                                        us_DroppedSamples(0),
+                                                                        u32_KHz(u32_KHz),
+                                                                        u32_TrailingFrameSizeCurrent(0),
+                                                                        u32_TrailingFrameSizeMax(u32_TrailingFrameSizeMax),
+                                                                        c_PreRoll(u32_PreRollSize),
+                                                                        f32_Amplification(f32_Amplification),
+                                                                        u32_DeviceID(MRH_SDL2_AUDIO_DEVICE_ID_INVALID),
+                                                                        p_Context(p_Context)
     {}
 
     //*************************************************************************************
     // Data
     //*************************************************************************************
 
-    AudioBuffer c_Buffer;
+    // @NOTE: Written by the audio callback, read by the main thread
+    AudioQueue c_Queue;
+    std::atomic<size_t> us_DroppedSamples;
+
+    MRH_Uint32 u32_KHz;
 
     MRH_Uint32 u32_TrailingFrameSizeCurrent;
     MRH_Uint32 u32_TrailingFrameSizeMax;
 
+    // @NOTE: Latest samples without speech, only used by the audio callback
+    AudioPreRoll c_PreRoll;
+
     MRH_Sfloat32 f32_Amplification;
 
     SDL_AudioDeviceID u32_DeviceID;
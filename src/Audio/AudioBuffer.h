@@ -18,8 +18,8 @@
 #define AudioBuffer_h
 
 // C / C++
-#include <deque>
 #include <vector>
+#include <cstring>
 
 // External
 #include <MRH_Typedefs.h>
@@ -35,38 +35,46 @@ class AudioBuffer
 public:
 
     //*************************************************************************************
-    // Destructor
+    // Types
     //*************************************************************************************
 
-    typedef std::vector<MRH_Sint16> AudioChunk;
+    /**
+     *  A contiguous writable region of buffer samples.
+     */
 
-    //*************************************************************************************
-    // Constructor / Destructor
-    //*************************************************************************************
+    struct Region
+    {
+        MRH_Sint16* p_Samples;
+        size_t us_Samples;
+    };
 
     /**
-     *  Default constructor.
-     *
-     *  \param u32_KHz The KHz of the audio stored.
-     *  \param dq_Chunk The initial audio chunks.
+     *  A contiguous read-only region of buffer samples.
      */
 
-    AudioBuffer(MRH_Uint32 u32_KHz,
-                std::deque<AudioChunk> const& dq_Chunk = {}) noexcept : u32_KHz(u32_KHz),
-                                                                        dq_Chunk(dq_Chunk)
-    {}
+    struct ConstRegion
+    {
+        const MRH_Sint16* p_Samples;
+        size_t us_Samples;
+    };
+
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
 
     /**
-     *  Consume constructor.
+     *  Default constructor.
      *
      *  \param u32_KHz The KHz of the audio stored.
-     *  \param dq_Chunk The initial audio chunks. The deque is consumed.
+     *  \param us_Capacity The initial sample capacity. Rounded up to a power of two.
      */
 
     AudioBuffer(MRH_Uint32 u32_KHz,
-                std::deque<AudioChunk>& dq_Chunk) noexcept
+                size_t us_Capacity = 0) : us_Read(0),
+                                          us_Count(0),
+                                          u32_KHz(u32_KHz)
     {
-        Reset(u32_KHz, dq_Chunk);
+        Reserve(us_Capacity);
     }
 
     /**
@@ -81,38 +89,76 @@ public:
     //*************************************************************************************
 
     /**
-     *  Reset the audio buffer.
+     *  Reset the audio buffer. The allocated storage is kept.
      *
      *  \param u32_KHz The KHz of the audio stored.
-     *  \param dq_Chunk The initial audio chunks.
      */
 
-    void Reset(MRH_Uint32 u32_KHz, std::deque<AudioChunk>& dq_Chunk) noexcept
+    void Reset(MRH_Uint32 u32_KHz) noexcept
     {
         this->u32_KHz = u32_KHz;
-        this->dq_Chunk.swap(dq_Chunk);
 
-        dq_Chunk.clear();
+        Clear();
     }
 
     /**
      *  Reset the audio buffer.
      *
-     *  \param c_Buffer The buffer to reset with. The buffer data is consumed.
+     *  \param c_Buffer The buffer to reset with. The buffer data is consumed, the
+     *                  storage of this buffer is handed to it for reuse.
      */
 
     void Reset(AudioBuffer& c_Buffer) noexcept
     {
-        Reset(c_Buffer.u32_KHz, c_Buffer.dq_Chunk);
+        v_Sample.swap(c_Buffer.v_Sample);
+
+        us_Read = c_Buffer.us_Read;
+        us_Count = c_Buffer.us_Count;
+        u32_KHz = c_Buffer.u32_KHz;
+
+        c_Buffer.Clear();
     }
 
     /**
-     *  Clear the audio buffer.
+     *  Clear the audio buffer. The allocated storage is kept.
      */
 
     void Clear() noexcept
     {
-        dq_Chunk.clear();
+        us_Read = 0;
+        us_Count = 0;
+    }
+
+    //*************************************************************************************
+    // Reserve
+    //*************************************************************************************
+
+    /**
+     *  Ensure that the buffer can hold a given amount of samples without allocating.
+     *
+     *  \param us_Samples The amount of samples to hold.
+     */
+
+    void Reserve(size_t us_Samples)
+    {
+        if (us_Samples <= v_Sample.size())
+        {
+            return;
+        }
+
+        size_t us_Capacity = v_Sample.empty() ? 1 : v_Sample.size();
+
+        while (us_Capacity < us_Samples)
+        {
+            us_Capacity <<= 1;
+        }
+
+        // Linearize stored samples into the new storage
+        std::vector<MRH_Sint16> v_New(us_Capacity);
+        Copy(v_New.data(), us_Count);
+
+        v_Sample.swap(v_New);
+        us_Read = 0;
     }
 
     //*************************************************************************************
@@ -120,82 +166,214 @@ public:
     //*************************************************************************************
 
     /**
-     *  Add audio chunks to the buffer.
+     *  Add audio samples to the end of the buffer.
+     *
+     *  \param p_Samples The samples to add.
+     *  \param us_Samples The amount of samples to add.
+     */
+
+    void Add(const MRH_Sint16* p_Samples, size_t us_Samples)
+    {
+        AddBytes(reinterpret_cast<const char*>(p_Samples), us_Samples);
+    }
+
+    /**
+     *  Add native endian audio sample bytes to the end of the buffer.
      *
-     *  \param dq_Chunk The chunks to add. The deque is consumed.
+     *  \param p_Bytes The sample bytes to add. No alignment is required.
+     *  \param us_Samples The amount of samples to add.
      */
 
-    void Add(std::deque<AudioChunk>& dq_Chunk) noexcept
+    void AddBytes(const char* p_Bytes, size_t us_Samples)
     {
-        if (dq_Chunk.empty() == false)
+        if (us_Samples == 0)
         {
-            Append(dq_Chunk, this->dq_Chunk);
+            return;
         }
+
+        Region c_First;
+        Region c_Second;
+
+        GetWriteRegions(c_First, c_Second, us_Samples);
+
+        std::memcpy(c_First.p_Samples, p_Bytes, c_First.us_Samples * sizeof(MRH_Sint16));
+
+        if (c_Second.us_Samples > 0)
+        {
+            std::memcpy(c_Second.p_Samples, p_Bytes + (c_First.us_Samples * sizeof(MRH_Sint16)), c_Second.us_Samples * sizeof(MRH_Sint16));
+        }
+
+        Commit(us_Samples);
     }
 
     /**
-     *  Add a audio chunk to the buffer.
+     *  Add the audio of another buffer to the end of this buffer.
      *
-     *  \param v_Chunk The audio chunk to add. The chunk is consumed.
-     *  \param b_ToFront If the buffer should be added in the front or back.
+     *  \param c_Buffer The buffer to add. The buffer is emptied.
      */
 
-    void Add(AudioChunk& v_Chunk, bool b_ToFront) noexcept
+    void Add(AudioBuffer& c_Buffer)
     {
-        if (v_Chunk.empty() == true)
+        ConstRegion c_First;
+        ConstRegion c_Second;
+
+        c_Buffer.GetReadRegions(c_First, c_Second);
+
+        Reserve(us_Count + c_First.us_Samples + c_Second.us_Samples);
+
+        Add(c_First.p_Samples, c_First.us_Samples);
+        Add(c_Second.p_Samples, c_Second.us_Samples);
+
+        c_Buffer.Clear();
+    }
+
+    /**
+     *  Get the writable regions following the stored samples. The buffer grows if
+     *  the requested amount does not fit.
+     *
+     *  \param c_First The first writable region.
+     *  \param c_Second The second writable region, wrapped to the buffer start.
+     *  \param us_Samples The amount of samples to write.
+     */
+
+    void GetWriteRegions(Region& c_First, Region& c_Second, size_t us_Samples)
+    {
+        Reserve(us_Count + us_Samples);
+
+        if (us_Samples == 0)
         {
+            c_First = { NULL, 0 };
+            c_Second = { NULL, 0 };
             return;
         }
 
-        if (b_ToFront == true)
+        size_t us_Mask = v_Sample.size() - 1;
+        size_t us_Write = (us_Read + us_Count) & us_Mask;
+        size_t us_Contiguous = v_Sample.size() - us_Write;
+
+        if (us_Contiguous >= us_Samples)
         {
-            dq_Chunk.emplace_front();
-            dq_Chunk.front().swap(v_Chunk);
+            c_First = { &(v_Sample[us_Write]), us_Samples };
+            c_Second = { NULL, 0 };
         }
         else
         {
-            dq_Chunk.emplace_back();
-            dq_Chunk.back().swap(v_Chunk);
+            c_First = { &(v_Sample[us_Write]), us_Contiguous };
+            c_Second = { &(v_Sample[0]), us_Samples - us_Contiguous };
         }
     }
 
+    /**
+     *  Append samples written to the regions returned by GetWriteRegions().
+     *
+     *  \param us_Samples The amount of samples written.
+     */
+
+    void Commit(size_t us_Samples) noexcept
+    {
+        us_Count += us_Samples;
+    }
+
     //*************************************************************************************
     // Retrieve
     //*************************************************************************************
 
     /**
-     *  Retrieve all currently stored audio chunks.
+     *  Retrieve stored audio samples from the front of the buffer.
+     *
+     *  \param p_Samples The sample array to copy to.
+     *  \param us_Samples The maximum amount of samples to retrieve.
      *
-     *  \param dq_Chunk The chunks to append to.
+     *  \return The amount of samples retrieved.
      */
 
-    void Retrieve(std::deque<AudioChunk>& dq_Chunk) noexcept
+    size_t Retrieve(MRH_Sint16* p_Samples, size_t us_Samples) noexcept
     {
-        if (this->dq_Chunk.empty() == false)
+        if (us_Samples > us_Count)
         {
-            Append(this->dq_Chunk, dq_Chunk);
+            us_Samples = us_Count;
         }
+
+        Copy(p_Samples, us_Samples);
+        Consume(us_Samples);
+
+        return us_Samples;
     }
 
     /**
-     *  Retrieve a stored audio chunk.
+     *  Retrieve stored audio samples from the front of the buffer as native 
+     *  endian bytes.
      *
-     *  \param v_Chunk The chunk to retrieve. The chunk is removed from the buffer.
+     *  \param p_Bytes The byte array to copy to. No alignment is required.
+     *  \param us_Samples The maximum amount of samples to retrieve.
      *
-     *  \return true if a chunk was retrieved, false if not.
+     *  \return The amount of samples retrieved.
      */
 
-    bool Retrieve(AudioChunk& v_Chunk) noexcept
+    size_t RetrieveBytes(char* p_Bytes, size_t us_Samples) noexcept
     {
-        if (dq_Chunk.empty() == true)
+        if (us_Samples > us_Count)
+        {
+            us_Samples = us_Count;
+        }
+
+        Copy(p_Bytes, us_Samples);
+        Consume(us_Samples);
+
+        return us_Samples;
+    }
+
+    /**
+     *  Get the readable regions of all stored samples.
+     *
+     *  \param c_First The first readable region.
+     *  \param c_Second The second readable region, wrapped to the buffer start.
+     *
+     *  \return The total amount of readable samples.
+     */
+
+    size_t GetReadRegions(ConstRegion& c_First, ConstRegion& c_Second) const noexcept
+    {
+        if (us_Count == 0)
+        {
+            c_First = { NULL, 0 };
+            c_Second = { NULL, 0 };
+
+            return 0;
+        }
+
+        size_t us_Contiguous = v_Sample.size() - us_Read;
+
+        if (us_Contiguous >= us_Count)
         {
-            return false;
+            c_First = { &(v_Sample[us_Read]), us_Count };
+            c_Second = { NULL, 0 };
         }
+        else
+        {
+            c_First = { &(v_Sample[us_Read]), us_Contiguous };
+            c_Second = { &(v_Sample[0]), us_Count - us_Contiguous };
+        }
+
+        return us_Count;
+    }
+
+    /**
+     *  Remove samples from the front of the buffer.
+     *
+     *  \param us_Samples The amount of samples to remove.
+     */
 
-        dq_Chunk.front().swap(v_Chunk);
-        dq_Chunk.pop_front();
+    void Consume(size_t us_Samples) noexcept
+    {
+        if (us_Samples >= us_Count)
+        {
+            Clear();
+            return;
+        }
 
-        return true;
+        us_Read = (us_Read + us_Samples) & (v_Sample.size() - 1);
+        us_Count -= us_Samples;
     }
 
     //*************************************************************************************
@@ -214,40 +392,70 @@ public:
     }
 
     /**
-     *  Get the amount of audio chunks.
+     *  Get the amount of stored samples.
      *
-     *  \return The amount of audio chunks.
+     *  \return The amount of stored samples.
      */
 
-    size_t GetChunkCount() noexcept
+    size_t GetSampleCount() const noexcept
     {
-        return dq_Chunk.size();
+        return us_Count;
+    }
+
+    /**
+     *  Get the amount of samples which can be stored without allocating.
+     *
+     *  \return The sample capacity.
+     */
+
+    size_t GetCapacity() const noexcept
+    {
+        return v_Sample.size();
     }
 
 private:
 
     //*************************************************************************************
-    // Append
+    // Copy
     //*************************************************************************************
 
     /**
-     *  Append a given chunk deque to the enf of a target deque.
+     *  Copy samples from the front of the buffer without removing them.
      *
-     *  \param dq_Src The chunk deque to append. The deque is consumed.
-     *  \param dq_Dst The chunk deque to append to.
+     *  \param p_Destination The memory to copy to. No alignment is required.
+     *  \param us_Samples The amount of samples to copy. Must not exceed the stored amount.
      */
 
-    inline void Append(std::deque<AudioChunk>& dq_Src, std::deque<AudioChunk>& dq_Dst)
+    inline void Copy(void* p_Destination, size_t us_Samples) const noexcept
     {
-        std::move(dq_Src.begin(), dq_Src.end(), std::back_inserter(dq_Dst));
-        dq_Src.clear();
+        if (us_Samples == 0)
+        {
+            return;
+        }
+
+        char* p_Bytes = static_cast<char*>(p_Destination);
+        size_t us_Contiguous = v_Sample.size() - us_Read;
+
+        if (us_Contiguous >= us_Samples)
+        {
+            std::memcpy(p_Bytes, &(v_Sample[us_Read]), us_Samples * sizeof(MRH_Sint16));
+        }
+        else
+        {
+            std::memcpy(p_Bytes, &(v_Sample[us_Read]), us_Contiguous * sizeof(MRH_Sint16));
+            std::memcpy(p_Bytes + (us_Contiguous * sizeof(MRH_Sint16)), &(v_Sample[0]), (us_Samples - us_Contiguous) * sizeof(MRH_Sint16));
+        }
     }
 
     //*************************************************************************************
     // Data
     //*************************************************************************************
 
-    std::deque<AudioChunk> dq_Chunk;
+    // @NOTE: The sample storage size is always 0 or a power of two
+    std::vector<MRH_Sint16> v_Sample;
+    size_t us_Read;
+    size_t us_Count;
+
     MRH_Uint32 u32_KHz;
 
 protected:
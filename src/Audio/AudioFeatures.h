@@ -0,0 +1,513 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef AudioFeatures_h
+#define AudioFeatures_h
+
+// C / C++
+#include <cstddef>
+
+// External
+#include <MRH_Typedefs.h>
+#if defined(__AVX2__) || defined(__SSE2__)
+    #include <immintrin.h>
+#elif defined(__ARM_NEON)
+    #include <arm_neon.h>
+#endif
+
+// Project
+
+// Pre-defined
+#if defined(__AVX2__)
+    #define MRH_AUDIO_FEATURES_SIMD "AVX2"
+#elif defined(__SSE2__)
+    #define MRH_AUDIO_FEATURES_SIMD "SSE2"
+#elif defined(__ARM_NEON)
+    #define MRH_AUDIO_FEATURES_SIMD "NEON"
+#else
+    #define MRH_AUDIO_FEATURES_SIMD "None"
+#endif
+#define MRH_AUDIO_FEATURES_BLOCK_SAMPLES 16384 // 16 bit lane counters cannot overflow
+
+
+namespace AudioFeatures
+{
+    //*************************************************************************************
+    // Types
+    //*************************************************************************************
+
+    /**
+     *  Features of a audio chunk used for speech checks.
+     */
+
+    struct Features
+    {
+        size_t us_Samples; // Measured samples
+        size_t us_Loud; // Samples with a absolute amplitude >= the threshold
+        size_t us_Crossings; // Sign changes between neighbouring samples
+        MRH_Uint64 u64_Energy; // Sum of squared samples
+    };
+
+    //*************************************************************************************
+    // Threshold
+    //*************************************************************************************
+
+    /**
+     *  Get the sample amplitude threshold for a volume.
+     *
+     *  \param f32_Volume The volume in the range of 0.0 to 1.0.
+     *
+     *  \return The amplitude threshold.
+     */
+
+    inline MRH_Sint16 GetThreshold(MRH_Sfloat32 f32_Volume) noexcept
+    {
+        // @NOTE: 0 would count every sample, 32768 is not representable
+        MRH_Sfloat32 f32_Threshold = 32768.f * f32_Volume;
+
+        if (f32_Threshold < 1.f)
+        {
+            return 1;
+        }
+        else if (f32_Threshold > 32767.f)
+        {
+            return 32767;
+        }
+
+        return (MRH_Sint16)f32_Threshold;
+    }
+
+    //*************************************************************************************
+    // Scalar
+    //*************************************************************************************
+
+    /**
+     *  Apply gain to a sample with saturation.
+     *
+     *  \param s16_Sample The sample to amplify.
+     *  \param f32_Gain The gain to apply.
+     *
+     *  \return The amplified sample.
+     */
+
+    inline MRH_Sint16 Amplify(MRH_Sint16 s16_Sample, MRH_Sfloat32 f32_Gain) noexcept
+    {
+        MRH_Sfloat32 f32_Sample = s16_Sample * f32_Gain;
+
+        if (f32_Sample > 32767.f)
+        {
+            return 32767;
+        }
+        else if (f32_Sample < -32768.f)
+        {
+            return -32768;
+        }
+
+        return (MRH_Sint16)f32_Sample; // Truncated, same as the vector conversion
+    }
+
+    /**
+     *  Add the features of a sample.
+     *
+     *  \param c_Features The features to add to.
+     *  \param s16_Sample The sample to measure.
+     *  \param s16_Threshold The amplitude threshold, in the range of 1 to 32767.
+     *  \param s16_Previous The sample before the measured sample.
+     */
+
+    inline void Add(Features& c_Features, MRH_Sint16 s16_Sample, MRH_Sint16 s16_Threshold, MRH_Sint16 s16_Previous) noexcept
+    {
+        MRH_Sint32 s32_Sample = s16_Sample;
+
+        if (s32_Sample >= s16_Threshold || s32_Sample <= -s16_Threshold)
+        {
+            c_Features.us_Loud += 1;
+        }
+
+        if ((s32_Sample < 0) != (s16_Previous < 0))
+        {
+            c_Features.us_Crossings += 1;
+        }
+
+        c_Features.u64_Energy += (MRH_Uint64)(s32_Sample * s32_Sample);
+        c_Features.us_Samples += 1;
+    }
+
+    /**
+     *  Measure the features of samples with the scalar implementation. Used as
+     *  the reference for the vectorized implementation.
+     *
+     *  \param p_Samples The samples to measure.
+     *  \param us_Samples The amount of samples to measure.
+     *  \param s16_Threshold The amplitude threshold, in the range of 1 to 32767.
+     *
+     *  \return The measured features.
+     */
+
+    inline Features MeasureScalar(const MRH_Sint16* p_Samples, size_t us_Samples, MRH_Sint16 s16_Threshold) noexcept
+    {
+        Features c_Features = { 0, 0, 0, 0 };
+
+        for (size_t i = 0; i < us_Samples; ++i)
+        {
+            Add(c_Features, p_Samples[i], s16_Threshold, p_Samples[i > 0 ? i - 1 : 0]);
+        }
+
+        return c_Features;
+    }
+
+    /**
+     *  Amplify samples and measure the amplified features with the scalar
+     *  implementation. Used as the reference for the vectorized implementation.
+     *
+     *  \param p_Input The samples to amplify.
+     *  \param p_Output The amplified samples. May be the input.
+     *  \param us_Samples The amount of samples to amplify.
+     *  \param f32_Gain The gain to apply.
+     *  \param s16_Threshold The amplitude threshold, in the range of 1 to 32767.
+     *
+     *  \return The measured features.
+     */
+
+    inline Features AmplifyScalar(const MRH_Sint16* p_Input, MRH_Sint16* p_Output, size_t us_Samples, MRH_Sfloat32 f32_Gain, MRH_Sint16 s16_Threshold) noexcept
+    {
+        Features c_Features = { 0, 0, 0, 0 };
+        MRH_Sint16 s16_Previous = 0;
+
+        for (size_t i = 0; i < us_Samples; ++i)
+        {
+            MRH_Sint16 s16_Sample = Amplify(p_Input[i], f32_Gain);
+
+            Add(c_Features, s16_Sample, s16_Threshold, i > 0 ? s16_Previous : s16_Sample);
+
+            p_Output[i] = s16_Sample;
+            s16_Previous = s16_Sample;
+        }
+
+        return c_Features;
+    }
+
+    //*************************************************************************************
+    // Vector
+    //*************************************************************************************
+
+    /**
+     *  Process samples in a single pass. Samples are optionally amplified and
+     *  stored, the features of the resulting samples are measured.
+     *
+     *  \param p_Input The samples to process.
+     *  \param p_Output The processed samples. May be the input, ignored if not storing.
+     *  \param us_Samples The amount of samples to process.
+     *  \param f32_Gain The gain to apply, ignored if not amplifying.
+     *  \param s16_Threshold The amplitude threshold, in the range of 1 to 32767.
+     *
+     *  \return The measured features.
+     */
+
+    template<bool b_Amplify, bool b_Store>
+    inline Features Process(const MRH_Sint16* p_Input, MRH_Sint16* p_Output, size_t us_Samples, MRH_Sfloat32 f32_Gain, MRH_Sint16 s16_Threshold) noexcept
+    {
+        Features c_Features = { 0, 0, 0, 0 };
+
+        if (us_Samples == 0)
+        {
+            return c_Features;
+        }
+
+        // @NOTE: The first sample has no predecessor and counts as its own
+        MRH_Sint16 s16_First = b_Amplify ? Amplify(p_Input[0], f32_Gain) : p_Input[0];
+        size_t i = 0;
+
+        // @NOTE: Crossings compare each vector with the previous processed samples
+        //        shifted in by one lane, the input may be overwritten by the output
+#if defined(__AVX2__)
+        const __m256i c_Above = _mm256_set1_epi16(s16_Threshold - 1);
+        const __m256i c_Below = _mm256_set1_epi16(-(s16_Threshold - 1));
+        const __m256i c_Zero = _mm256_setzero_si256();
+        const __m256i c_One = _mm256_set1_epi16(1);
+        const __m256 c_Gain = _mm256_set1_ps(f32_Gain);
+        const __m256 c_Max = _mm256_set1_ps(32767.f);
+        const __m256 c_Min = _mm256_set1_ps(-32768.f);
+        __m256i c_Last = _mm256_set1_epi16(s16_First);
+        __m256i c_Energy = _mm256_setzero_si256();
+
+        while (i + 16 <= us_Samples)
+        {
+            size_t us_End = i + MRH_AUDIO_FEATURES_BLOCK_SAMPLES;
+            __m256i c_Loud = _mm256_setzero_si256();
+            __m256i c_Crossings = _mm256_setzero_si256();
+
+            for (; i + 16 <= us_Samples && i < us_End; i += 16)
+            {
+                __m256i c_Sample = _mm256_loadu_si256((const __m256i*)(p_Input + i));
+
+                if (b_Amplify)
+                {
+                    __m256 c_Low = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm256_castsi256_si128(c_Sample)));
+                    __m256 c_High = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm256_extracti128_si256(c_Sample, 1)));
+
+                    c_Low = _mm256_max_ps(_mm256_min_ps(_mm256_mul_ps(c_Low, c_Gain), c_Max), c_Min);
+                    c_High = _mm256_max_ps(_mm256_min_ps(_mm256_mul_ps(c_High, c_Gain), c_Max), c_Min);
+
+                    // Pack works per 128 bit lane, restore the sample order
+                    c_Sample = _mm256_packs_epi32(_mm256_cvttps_epi32(c_Low), _mm256_cvttps_epi32(c_High));
+                    c_Sample = _mm256_permute4x64_epi64(c_Sample, 0xD8);
+                }
+
+                if (b_Store)
+                {
+                    _mm256_storeu_si256((__m256i*)(p_Output + i), c_Sample);
+                }
+
+                __m256i c_Previous = _mm256_alignr_epi8(c_Sample, _mm256_permute2x128_si256(c_Last, c_Sample, 0x21), 14);
+                c_Last = c_Sample;
+
+                // Compare results are -1 per matching lane
+                __m256i c_IsLoud = _mm256_or_si256(_mm256_cmpgt_epi16(c_Sample, c_Above),
+                                                   _mm256_cmpgt_epi16(c_Below, c_Sample));
+                __m256i c_IsCrossing = _mm256_xor_si256(_mm256_srai_epi16(c_Sample, 15),
+                                                        _mm256_srai_epi16(c_Previous, 15));
+
+                c_Loud = _mm256_sub_epi16(c_Loud, c_IsLoud);
+                c_Crossings = _mm256_sub_epi16(c_Crossings, c_IsCrossing);
+
+                // Pair sums of squares are at most 2^31, unsigned 32 bit
+                __m256i c_Square = _mm256_madd_epi16(c_Sample, c_Sample);
+
+                c_Energy = _mm256_add_epi64(c_Energy, _mm256_unpacklo_epi32(c_Square, c_Zero));
+                c_Energy = _mm256_add_epi64(c_Energy, _mm256_unpackhi_epi32(c_Square, c_Zero));
+            }
+
+            MRH_Sint32 p_Count[8];
+
+            _mm256_storeu_si256((__m256i*)p_Count, _mm256_madd_epi16(c_Loud, c_One));
+            for (int j = 0; j < 8; ++j)
+            {
+                c_Features.us_Loud += p_Count[j];
+            }
+
+            _mm256_storeu_si256((__m256i*)p_Count, _mm256_madd_epi16(c_Crossings, c_One));
+            for (int j = 0; j < 8; ++j)
+            {
+                c_Features.us_Crossings += p_Count[j];
+            }
+        }
+
+        MRH_Uint64 p_Energy[4];
+
+        _mm256_storeu_si256((__m256i*)p_Energy, c_Energy);
+        c_Features.u64_Energy += p_Energy[0] + p_Energy[1] + p_Energy[2] + p_Energy[3];
+        MRH_Sint16 s16_Previous = (MRH_Sint16)_mm256_extract_epi16(c_Last, 15);
+#elif defined(__SSE2__)
+        const __m128i c_Above = _mm_set1_epi16(s16_Threshold - 1);
+        const __m128i c_Below = _mm_set1_epi16(-(s16_Threshold - 1));
+        const __m128i c_Zero = _mm_setzero_si128();
+        const __m128i c_One = _mm_set1_epi16(1);
+        const __m128 c_Gain = _mm_set1_ps(f32_Gain);
+        const __m128 c_Max = _mm_set1_ps(32767.f);
+        const __m128 c_Min = _mm_set1_ps(-32768.f);
+        __m128i c_Last = _mm_set1_epi16(s16_First);
+        __m128i c_Energy = _mm_setzero_si128();
+
+        while (i + 8 <= us_Samples)
+        {
+            size_t us_End = i + MRH_AUDIO_FEATURES_BLOCK_SAMPLES;
+            __m128i c_Loud = _mm_setzero_si128();
+            __m128i c_Crossings = _mm_setzero_si128();
+
+            for (; i + 8 <= us_Samples && i < us_End; i += 8)
+            {
+                __m128i c_Sample = _mm_loadu_si128((const __m128i*)(p_Input + i));
+
+                if (b_Amplify)
+                {
+                    // Sign extend by unpacking into the upper half and shifting back
+                    __m128 c_Low = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(c_Sample, c_Sample), 16));
+                    __m128 c_High = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(c_Sample, c_Sample), 16));
+
+                    c_Low = _mm_max_ps(_mm_min_ps(_mm_mul_ps(c_Low, c_Gain), c_Max), c_Min);
+                    c_High = _mm_max_ps(_mm_min_ps(_mm_mul_ps(c_High, c_Gain), c_Max), c_Min);
+
+                    c_Sample = _mm_packs_epi32(_mm_cvttps_epi32(c_Low), _mm_cvttps_epi32(c_High));
+                }
+
+                if (b_Store)
+                {
+                    _mm_storeu_si128((__m128i*)(p_Output + i), c_Sample);
+                }
+
+                __m128i c_Previous = _mm_or_si128(_mm_slli_si128(c_Sample, 2), _mm_srli_si128(c_Last, 14));
+                c_Last = c_Sample;
+
+                // Compare results are -1 per matching lane
+                __m128i c_IsLoud = _mm_or_si128(_mm_cmpgt_epi16(c_Sample, c_Above),
+                                                _mm_cmplt_epi16(c_Sample, c_Below));
+                __m128i c_IsCrossing = _mm_xor_si128(_mm_srai_epi16(c_Sample, 15),
+                                                     _mm_srai_epi16(c_Previous, 15));
+
+                c_Loud = _mm_sub_epi16(c_Loud, c_IsLoud);
+                c_Crossings = _mm_sub_epi16(c_Crossings, c_IsCrossing);
+
+                // Pair sums of squares are at most 2^31, unsigned 32 bit
+                __m128i c_Square = _mm_madd_epi16(c_Sample, c_Sample);
+
+                c_Energy = _mm_add_epi64(c_Energy, _mm_unpacklo_epi32(c_Square, c_Zero));
+                c_Energy = _mm_add_epi64(c_Energy, _mm_unpackhi_epi32(c_Square, c_Zero));
+            }
+
+            MRH_Sint32 p_Count[4];
+
+            _mm_storeu_si128((__m128i*)p_Count, _mm_madd_epi16(c_Loud, c_One));
+            c_Features.us_Loud += p_Count[0] + p_Count[1] + p_Count[2] + p_Count[3];
+
+            _mm_storeu_si128((__m128i*)p_Count, _mm_madd_epi16(c_Crossings, c_One));
+            c_Features.us_Crossings += p_Count[0] + p_Count[1] + p_Count[2] + p_Count[3];
+        }
+
+        MRH_Uint64 p_Energy[2];
+
+        _mm_storeu_si128((__m128i*)p_Energy, c_Energy);
+        c_Features.u64_Energy += p_Energy[0] + p_Energy[1];
+        MRH_Sint16 s16_Previous = (MRH_Sint16)_mm_extract_epi16(c_Last, 7);
+#elif defined(__ARM_NEON)
+        const int16x8_t c_Threshold = vdupq_n_s16(s16_Threshold);
+        const float32x4_t c_Max = vdupq_n_f32(32767.f);
+        const float32x4_t c_Min = vdupq_n_f32(-32768.f);
+        int16x8_t c_Last = vdupq_n_s16(s16_First);
+        uint64x2_t c_Energy = vdupq_n_u64(0);
+
+        while (i + 8 <= us_Samples)
+        {
+            size_t us_End = i + MRH_AUDIO_FEATURES_BLOCK_SAMPLES;
+            uint16x8_t c_Loud = vdupq_n_u16(0);
+            uint16x8_t c_Crossings = vdupq_n_u16(0);
+
+            for (; i + 8 <= us_Samples && i < us_End; i += 8)
+            {
+                int16x8_t c_Sample = vld1q_s16(p_Input + i);
+
+                if (b_Amplify)
+                {
+                    float32x4_t c_Low = vcvtq_f32_s32(vmovl_s16(vget_low_s16(c_Sample)));
+                    float32x4_t c_High = vcvtq_f32_s32(vmovl_s16(vget_high_s16(c_Sample)));
+
+                    c_Low = vmaxq_f32(vminq_f32(vmulq_n_f32(c_Low, f32_Gain), c_Max), c_Min);
+                    c_High = vmaxq_f32(vminq_f32(vmulq_n_f32(c_High, f32_Gain), c_Max), c_Min);
+
+                    c_Sample = vcombine_s16(vqmovn_s32(vcvtq_s32_f32(c_Low)), vqmovn_s32(vcvtq_s32_f32(c_High)));
+                }
+
+                if (b_Store)
+                {
+                    vst1q_s16(p_Output + i, c_Sample);
+                }
+
+                int16x8_t c_Previous = vextq_s16(c_Last, c_Sample, 7);
+                c_Last = c_Sample;
+
+                // Saturating abs maps -32768 to 32767, the threshold is at most 32767
+                uint16x8_t c_IsLoud = vcgeq_s16(vqabsq_s16(c_Sample), c_Threshold);
+                uint16x8_t c_IsCrossing = vreinterpretq_u16_s16(veorq_s16(vshrq_n_s16(c_Sample, 15),
+                                                                          vshrq_n_s16(c_Previous, 15)));
+
+                c_Loud = vsubq_u16(c_Loud, c_IsLoud);
+                c_Crossings = vsubq_u16(c_Crossings, c_IsCrossing);
+
+                // Squares are at most 2^30, pair sums fit unsigned 32 bit
+                uint32x4_t c_Square = vreinterpretq_u32_s32(vmull_s16(vget_low_s16(c_Sample), vget_low_s16(c_Sample)));
+                c_Energy = vpadalq_u32(c_Energy, c_Square);
+
+                c_Square = vreinterpretq_u32_s32(vmull_s16(vget_high_s16(c_Sample), vget_high_s16(c_Sample)));
+                c_Energy = vpadalq_u32(c_Energy, c_Square);
+            }
+
+            uint64x2_t c_Count = vpaddlq_u32(vpaddlq_u16(c_Loud));
+            c_Features.us_Loud += vgetq_lane_u64(c_Count, 0) + vgetq_lane_u64(c_Count, 1);
+
+            c_Count = vpaddlq_u32(vpaddlq_u16(c_Crossings));
+            c_Features.us_Crossings += vgetq_lane_u64(c_Count, 0) + vgetq_lane_u64(c_Count, 1);
+        }
+
+        c_Features.u64_Energy += vgetq_lane_u64(c_Energy, 0) + vgetq_lane_u64(c_Energy, 1);
+        MRH_Sint16 s16_Previous = vgetq_lane_s16(c_Last, 7);
+#else
+        MRH_Sint16 s16_Previous = s16_First;
+#endif
+
+        // Remaining tail
+        c_Features.us_Samples = i;
+
+        for (; i < us_Samples; ++i)
+        {
+            MRH_Sint16 s16_Sample = b_Amplify ? Amplify(p_Input[i], f32_Gain) : p_Input[i];
+
+            if (b_Store)
+            {
+                p_Output[i] = s16_Sample;
+            }
+
+            Add(c_Features, s16_Sample, s16_Threshold, s16_Previous);
+            s16_Previous = s16_Sample;
+        }
+
+        return c_Features;
+    }
+
+    /**
+     *  Measure the features of samples in a single pass.
+     *
+     *  \param p_Samples The samples to measure.
+     *  \param us_Samples The amount of samples to measure.
+     *  \param s16_Threshold The amplitude threshold, in the range of 1 to 32767.
+     *
+     *  \return The measured features.
+     */
+
+    inline Features Measure(const MRH_Sint16* p_Samples, size_t us_Samples, MRH_Sint16 s16_Threshold) noexcept
+    {
+        return Process<false, false>(p_Samples, NULL, us_Samples, 1.f, s16_Threshold);
+    }
+
+    /**
+     *  Amplify samples with saturation and measure the amplified features in a
+     *  single pass. The samples are copied without multiplying for a gain of 1.
+     *
+     *  \param p_Input The samples to amplify.
+     *  \param p_Output The amplified samples. May be the input.
+     *  \param us_Samples The amount of samples to amplify.
+     *  \param f32_Gain The gain to apply.
+     *  \param s16_Threshold The amplitude threshold, in the range of 1 to 32767.
+     *
+     *  \return The measured features.
+     */
+
+    inline Features Amplify(const MRH_Sint16* p_Input, MRH_Sint16* p_Output, size_t us_Samples, MRH_Sfloat32 f32_Gain, MRH_Sint16 s16_Threshold) noexcept
+    {
+        if (f32_Gain == 1.f)
+        {
+            if (p_Input == p_Output)
+            {
+                return Process<false, false>(p_Input, NULL, us_Samples, f32_Gain, s16_Threshold);
+            }
+
+            return Process<false, true>(p_Input, p_Output, us_Samples, f32_Gain, s16_Threshold);
+        }
+
+        return Process<true, true>(p_Input, p_Output, us_Samples, f32_Gain, s16_Threshold);
+    }
+}
+
+#endif /* AudioFeatures_h */
@@ -0,0 +1,182 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef AudioPreRoll_h
+#define AudioPreRoll_h
+
+// C / C++
+#include <vector>
+#include <cstring>
+
+// External
+
+// Project
+#include "./AudioBuffer.h"
+
+
+/**
+ *  Fixed ring of the latest recorded samples before speech was detected.
+ *  Adding samples never allocates, the ring can be used by audio callbacks.
+ */
+
+class AudioPreRoll
+{
+public:
+
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+
+    /**
+     *  Default constructor.
+     *
+     *  \param us_Size The amount of samples kept. 0 keeps no samples.
+     */
+
+    AudioPreRoll(size_t us_Size) : v_Sample(us_Size),
+                                   us_Write(0),
+                                   us_Count(0)
+    {}
+
+    /**
+     *  Default destructor.
+     */
+
+    ~AudioPreRoll() noexcept
+    {}
+
+    //*************************************************************************************
+    // Clear
+    //*************************************************************************************
+
+    /**
+     *  Remove all kept samples.
+     */
+
+    void Clear() noexcept
+    {
+        us_Write = 0;
+        us_Count = 0;
+    }
+
+    //*************************************************************************************
+    // Add
+    //*************************************************************************************
+
+    /**
+     *  Keep samples, replacing the oldest samples once the ring is full.
+     *
+     *  \param p_Samples The samples to keep.
+     *  \param us_Samples The amount of samples to keep.
+     */
+
+    void Add(const MRH_Sint16* p_Samples, size_t us_Samples) noexcept
+    {
+        size_t us_Size = v_Sample.size();
+
+        if (us_Size == 0 || us_Samples == 0)
+        {
+            return;
+        }
+
+        // Only the latest samples fit
+        if (us_Samples > us_Size)
+        {
+            p_Samples += us_Samples - us_Size;
+            us_Samples = us_Size;
+        }
+
+        size_t us_First = us_Size - us_Write;
+
+        if (us_First > us_Samples)
+        {
+            us_First = us_Samples;
+        }
+
+        std::memcpy(&(v_Sample[us_Write]), p_Samples, us_First * sizeof(MRH_Sint16));
+
+        if (us_Samples > us_First)
+        {
+            std::memcpy(&(v_Sample[0]), p_Samples + us_First, (us_Samples - us_First) * sizeof(MRH_Sint16));
+        }
+
+        us_Write = (us_Write + us_Samples) % us_Size;
+        us_Count += us_Samples;
+
+        if (us_Count > us_Size)
+        {
+            us_Count = us_Size;
+        }
+    }
+
+    //*************************************************************************************
+    // Getters
+    //*************************************************************************************
+
+    /**
+     *  Get the regions of the kept samples, oldest sample first.
+     *
+     *  \param c_First The first region.
+     *  \param c_Second The second region, wrapped to the ring start.
+     *
+     *  \return The total amount of kept samples.
+     */
+
+    size_t GetReadRegions(AudioBuffer::ConstRegion& c_First, AudioBuffer::ConstRegion& c_Second) const noexcept
+    {
+        size_t us_Size = v_Sample.size();
+        size_t us_Read = us_Size > 0 ? (us_Write + us_Size - us_Count) % us_Size : 0;
+        size_t us_First = us_Size - us_Read;
+
+        if (us_First > us_Count)
+        {
+            us_First = us_Count;
+        }
+
+        c_First.p_Samples = v_Sample.data() + us_Read;
+        c_First.us_Samples = us_First;
+        c_Second.p_Samples = v_Sample.data();
+        c_Second.us_Samples = us_Count - us_First;
+
+        return us_Count;
+    }
+
+    /**
+     *  Get the amount of kept samples.
+     *
+     *  \return The kept sample count.
+     */
+
+    size_t GetSampleCount() const noexcept
+    {
+        return us_Count;
+    }
+
+private:
+
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+
+    std::vector<MRH_Sint16> v_Sample;
+    size_t us_Write;
+    size_t us_Count;
+
+protected:
+
+};
+
+#endif /* AudioPreRoll_h */
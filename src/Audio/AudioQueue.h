@@ -0,0 +1,387 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef AudioQueue_h
+#define AudioQueue_h
+
+// C / C++
+#include <atomic>
+#include <vector>
+#include <cstring>
+
+// External
+
+// Project
+#include "./AudioBuffer.h"
+
+// Pre-defined
+#define MRH_AUDIO_QUEUE_CACHE_LINE_SIZE 64
+
+
+/**
+ *  Wait-free single producer, single consumer sample queue. One thread may
+ *  push samples while another thread pops them, neither side blocks or
+ *  allocates.
+ */
+
+class AudioQueue
+{
+public:
+
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+
+    /**
+     *  Default constructor.
+     *
+     *  \param us_Capacity The sample capacity. Rounded up to a power of two.
+     */
+
+    AudioQueue(size_t us_Capacity) : us_Write(0),
+                                     us_Read(0)
+    {
+        Reset(us_Capacity);
+    }
+
+    /**
+     *  Default destructor.
+     */
+
+    ~AudioQueue() noexcept
+    {}
+
+    //*************************************************************************************
+    // Reset
+    //*************************************************************************************
+
+    /**
+     *  Reset the queue with a new capacity. All stored samples are removed.
+     *
+     *  @NOTE: Not thread safe, neither producer nor consumer may be active!
+     *
+     *  \param us_Capacity The sample capacity. Rounded up to a power of two.
+     */
+
+    void Reset(size_t us_Capacity)
+    {
+        size_t us_Size = 1;
+
+        while (us_Size < us_Capacity)
+        {
+            us_Size <<= 1;
+        }
+
+        if (v_Sample.size() != us_Size)
+        {
+            std::vector<MRH_Sint16>(us_Size).swap(v_Sample);
+        }
+
+        us_Write.store(0, std::memory_order_relaxed);
+        us_Read.store(0, std::memory_order_relaxed);
+    }
+
+    //*************************************************************************************
+    // Producer
+    //*************************************************************************************
+
+    /**
+     *  Get the free regions which can be written by the producer.
+     *
+     *  \param c_First The first free region.
+     *  \param c_Second The second free region, wrapped to the queue start.
+     *
+     *  \return The total amount of writable samples.
+     */
+
+    size_t GetWriteRegions(AudioBuffer::Region& c_First, AudioBuffer::Region& c_Second) noexcept
+    {
+        size_t us_Write = this->us_Write.load(std::memory_order_relaxed);
+        size_t us_Free = v_Sample.size() - (us_Write - us_Read.load(std::memory_order_acquire));
+
+        GetRegions(us_Write, us_Free, c_First.p_Samples, c_First.us_Samples, c_Second.p_Samples, c_Second.us_Samples);
+
+        return us_Free;
+    }
+
+    /**
+     *  Publish samples written to the regions returned by GetWriteRegions().
+     *
+     *  \param us_Samples The amount of samples written.
+     */
+
+    void Commit(size_t us_Samples) noexcept
+    {
+        us_Write.store(us_Write.load(std::memory_order_relaxed) + us_Samples, std::memory_order_release);
+    }
+
+    /**
+     *  Push samples to the queue. Samples which do not fit are discarded.
+     *
+     *  \param p_Samples The samples to push.
+     *  \param us_Samples The amount of samples to push.
+     *
+     *  \return The amount of samples pushed.
+     */
+
+    size_t Push(const MRH_Sint16* p_Samples, size_t us_Samples) noexcept
+    {
+        AudioBuffer::Region c_First;
+        AudioBuffer::Region c_Second;
+
+        size_t us_Free = GetWriteRegions(c_First, c_Second);
+
+        if (us_Samples > us_Free)
+        {
+            us_Samples = us_Free;
+        }
+
+        size_t us_First = us_Samples < c_First.us_Samples ? us_Samples : c_First.us_Samples;
+
+        if (us_First > 0)
+        {
+            std::memcpy(c_First.p_Samples, p_Samples, us_First * sizeof(MRH_Sint16));
+        }
+
+        if (us_Samples > us_First)
+        {
+            std::memcpy(c_Second.p_Samples, p_Samples + us_First, (us_Samples - us_First) * sizeof(MRH_Sint16));
+        }
+
+        Commit(us_Samples);
+
+        return us_Samples;
+    }
+
+    /**
+     *  Push the samples of a audio buffer to the queue.
+     *
+     *  \param c_Buffer The buffer to push. Pushed samples are removed from the buffer.
+     *
+     *  \return The amount of samples pushed.
+     */
+
+    size_t Push(AudioBuffer& c_Buffer) noexcept
+    {
+        AudioBuffer::ConstRegion c_First;
+        AudioBuffer::ConstRegion c_Second;
+
+        c_Buffer.GetReadRegions(c_First, c_Second);
+
+        size_t us_Pushed = Push(c_First.p_Samples, c_First.us_Samples);
+
+        if (us_Pushed == c_First.us_Samples)
+        {
+            us_Pushed += Push(c_Second.p_Samples, c_Second.us_Samples);
+        }
+
+        c_Buffer.Consume(us_Pushed);
+
+        return us_Pushed;
+    }
+
+    //*************************************************************************************
+    // Consumer
+    //*************************************************************************************
+
+    /**
+     *  Get the regions which can be read by the consumer.
+     *
+     *  \param c_First The first readable region.
+     *  \param c_Second The second readable region, wrapped to the queue start.
+     *
+     *  \return The total amount of readable samples.
+     */
+
+    size_t GetReadRegions(AudioBuffer::ConstRegion& c_First, AudioBuffer::ConstRegion& c_Second) noexcept
+    {
+        size_t us_Read = this->us_Read.load(std::memory_order_relaxed);
+        size_t us_Available = us_Write.load(std::memory_order_acquire) - us_Read;
+        MRH_Sint16* p_First;
+        MRH_Sint16* p_Second;
+
+        GetRegions(us_Read, us_Available, p_First, c_First.us_Samples, p_Second, c_Second.us_Samples);
+
+        c_First.p_Samples = p_First;
+        c_Second.p_Samples = p_Second;
+
+        return us_Available;
+    }
+
+    /**
+     *  Release samples read from the regions returned by GetReadRegions().
+     *
+     *  \param us_Samples The amount of samples read.
+     */
+
+    void Consume(size_t us_Samples) noexcept
+    {
+        us_Read.store(us_Read.load(std::memory_order_relaxed) + us_Samples, std::memory_order_release);
+    }
+
+    /**
+     *  Pop samples from the queue.
+     *
+     *  \param p_Samples The sample array to copy to.
+     *  \param us_Samples The maximum amount of samples to pop.
+     *
+     *  \return The amount of samples popped.
+     */
+
+    size_t Pop(MRH_Sint16* p_Samples, size_t us_Samples) noexcept
+    {
+        AudioBuffer::ConstRegion c_First;
+        AudioBuffer::ConstRegion c_Second;
+
+        size_t us_Available = GetReadRegions(c_First, c_Second);
+
+        if (us_Samples > us_Available)
+        {
+            us_Samples = us_Available;
+        }
+
+        size_t us_First = us_Samples < c_First.us_Samples ? us_Samples : c_First.us_Samples;
+
+        if (us_First > 0)
+        {
+            std::memcpy(p_Samples, c_First.p_Samples, us_First * sizeof(MRH_Sint16));
+        }
+
+        if (us_Samples > us_First)
+        {
+            std::memcpy(p_Samples + us_First, c_Second.p_Samples, (us_Samples - us_First) * sizeof(MRH_Sint16));
+        }
+
+        Consume(us_Samples);
+
+        return us_Samples;
+    }
+
+    /**
+     *  Pop all available samples to a audio buffer.
+     *
+     *  \param c_Buffer The buffer to append the samples to.
+     *
+     *  \return The amount of samples popped.
+     */
+
+    size_t Pop(AudioBuffer& c_Buffer)
+    {
+        AudioBuffer::ConstRegion c_First;
+        AudioBuffer::ConstRegion c_Second;
+
+        size_t us_Available = GetReadRegions(c_First, c_Second);
+
+        c_Buffer.Reserve(c_Buffer.GetSampleCount() + us_Available);
+        c_Buffer.Add(c_First.p_Samples, c_First.us_Samples);
+        c_Buffer.Add(c_Second.p_Samples, c_Second.us_Samples);
+
+        Consume(us_Available);
+
+        return us_Available;
+    }
+
+    /**
+     *  Remove all available samples. Only callable by the consumer.
+     */
+
+    void Clear() noexcept
+    {
+        us_Read.store(us_Write.load(std::memory_order_acquire), std::memory_order_release);
+    }
+
+    //*************************************************************************************
+    // Getters
+    //*************************************************************************************
+
+    /**
+     *  Get the amount of samples available for reading.
+     *
+     *  \return The amount of stored samples.
+     */
+
+    size_t GetSampleCount() const noexcept
+    {
+        return us_Write.load(std::memory_order_acquire) - us_Read.load(std::memory_order_acquire);
+    }
+
+    /**
+     *  Get the queue sample capacity.
+     *
+     *  \return The sample capacity.
+     */
+
+    size_t GetCapacity() const noexcept
+    {
+        return v_Sample.size();
+    }
+
+private:
+
+    //*************************************************************************************
+    // Regions
+    //*************************************************************************************
+
+    /**
+     *  Split a sample range into its contiguous regions.
+     *
+     *  \param us_Start The unmasked range start position.
+     *  \param us_Samples The amount of samples in the range.
+     *  \param p_First The first region start.
+     *  \param us_First The first region size.
+     *  \param p_Second The second region start.
+     *  \param us_Second The second region size.
+     */
+
+    inline void GetRegions(size_t us_Start, size_t us_Samples, MRH_Sint16*& p_First, size_t& us_First, MRH_Sint16*& p_Second, size_t& us_Second) noexcept
+    {
+        size_t us_Pos = us_Start & (v_Sample.size() - 1);
+        size_t us_Contiguous = v_Sample.size() - us_Pos;
+
+        p_First = &(v_Sample[us_Pos]);
+        p_Second = &(v_Sample[0]);
+
+        if (us_Contiguous >= us_Samples)
+        {
+            us_First = us_Samples;
+            us_Second = 0;
+        }
+        else
+        {
+            us_First = us_Contiguous;
+            us_Second = us_Samples - us_Contiguous;
+        }
+    }
+
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+
+    // @NOTE: Positions are unmasked and wrap on overflow, the sample storage
+    //        size is always a power of two
+    std::vector<MRH_Sint16> v_Sample;
+
+    // @NOTE: Keep producer and consumer positions on separate cache lines
+    std::atomic<size_t> us_Write;
+    char p_WritePadding[MRH_AUDIO_QUEUE_CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+    std::atomic<size_t> us_Read;
+    char p_ReadPadding[MRH_AUDIO_QUEUE_CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+
+protected:
+
+};
+
+#endif /* AudioQueue_h */
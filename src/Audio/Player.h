@@ -23,6 +23,7 @@
 
 // Project
 #include "./AudioBuffer.h"
+#include "../Latency.h"
 #include "../Logger.h"
 #include "../Exception.h"
 
@@ -57,6 +58,17 @@ public:
         throw Exception("Default Start() function called!");
     }
 
+    /**
+     *  Append audio to the active playback. Playback is started if not active.
+     *
+     *  \param c_Buffer The audio buffer to append. The buffer is emptied.
+     */
+
+    virtual void Append(AudioBuffer& c_Buffer)
+    {
+        throw Exception("Default Append() function called!");
+    }
+
     /**
      *  Stop playback.
      */
@@ -101,15 +113,21 @@ protected:
      *  Default constructor.
      *
      *  \param s_Identifier The player identifier.
+     *  \param p_Marks The latency marks to complete with the first played frame.
      */
 
-    Player(std::string const& s_Identifier) noexcept : s_Identifier(s_Identifier)
+    Player(std::string const& s_Identifier,
+           std::shared_ptr<Latency::Marks>& p_Marks) noexcept : s_Identifier(s_Identifier),
+                                                                p_Marks(p_Marks)
     {
-        Logger::Singleton().Log(Logger::INFO, "Created [ " +
-                                              s_Identifier +
-                                              " ] player API.",
-                                "Player.h", __LINE__);
+        MRH_LOG_INFO("Created [ {} ] player API.", s_Identifier);
     }
+
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+
+    std::shared_ptr<Latency::Marks> p_Marks;
 };
 
 #endif /* Player_h */
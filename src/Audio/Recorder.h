@@ -89,7 +89,8 @@ public:
     }
 
     /**
-     *  Get all currently recorded audio.
+     *  Get all currently recorded audio. This function can be called while
+     *  recording.
      *
      *  \param c_Buffer The audio buffer to store in. The buffer is overwritten.
      */
@@ -128,10 +129,7 @@ protected:
              std::shared_ptr<RecorderContext>& p_Context) noexcept : s_Identifier(s_Identifier),
                                                                      p_Context(p_Context)
     {
-        Logger::Singleton().Log(Logger::INFO, "Created [ " +
-                                              s_Identifier +
-                                              " ] recorder API.",
-                                "Recorder.h", __LINE__);
+        MRH_LOG_INFO("Created [ {} ] recorder API.", s_Identifier);
     }
 
     //*************************************************************************************
@@ -25,7 +25,8 @@
 
 // Project
 #include "./SpeechChecker.h"
-#include "../DataNotifier.h"
+#include "../EventQueue.h"
+#include "../Latency.h"
 
 
 struct RecorderContext
@@ -39,14 +40,20 @@ public:
     /**
      *  Default constructor.
      *
-     *  \param p_Notifier The notifier to trigger for new recording data.
+     *  \param p_EventQueue The event queue to notify of recording events.
+     *  \param us_Channel The event queue channel to notify.
      *  \param p_SpeechChecker The speech checker used to detect voice audio.
+     *  \param p_Marks The latency marks to set once speech ended.
      */
 
-    RecorderContext(std::shared_ptr<DataNotifier>& p_Notifier,
-                    std::shared_ptr<SpeechChecker>& p_SpeechChecker) noexcept : b_SpeechRecorded(false),
-                                                                                p_Notifier(p_Notifier),
-                                                                                p_SpeechChecker(p_SpeechChecker)
+    RecorderContext(std::shared_ptr<EventQueue>& p_EventQueue,
+                    size_t us_Channel,
+                    std::shared_ptr<SpeechChecker>& p_SpeechChecker,
+                    std::shared_ptr<Latency::Marks>& p_Marks) noexcept : b_SpeechRecorded(false),
+                                                                         p_EventQueue(p_EventQueue),
+                                                                         us_Channel(us_Channel),
+                                                                         p_SpeechChecker(p_SpeechChecker),
+                                                                         p_Marks(p_Marks)
     {}
 
     //*************************************************************************************
@@ -55,8 +62,10 @@ public:
 
     std::atomic<bool> b_SpeechRecorded;
 
-    std::shared_ptr<DataNotifier> p_Notifier;
+    std::shared_ptr<EventQueue> p_EventQueue;
+    size_t us_Channel;
     std::shared_ptr<SpeechChecker> p_SpeechChecker;
+    std::shared_ptr<Latency::Marks> p_Marks;
 };
 
 
@@ -23,6 +23,7 @@
 
 // Project
 #include "./AudioBuffer.h"
+#include "./AudioFeatures.h"
 #include "../Logger.h"
 #include "../Exception.h"
 
@@ -49,16 +50,48 @@ public:
     /**
      *  Check if a audio chunk contains speech.
      *
-     *  \param v_Chunk The chunk to check.
+     *  \param p_Samples The chunk samples to check.
+     *  \param us_Samples The amount of chunk samples.
      *
      *  \return true if speech was found, false if not.
      */
 
-    virtual bool IsSpeech(AudioBuffer::AudioChunk const& v_Chunk)
+    virtual bool IsSpeech(const MRH_Sint16* p_Samples, size_t us_Samples)
     {
         throw Exception("Default IsSpeech() function called!");
     }
 
+    /**
+     *  Check if a audio chunk contains speech with features measured while
+     *  recording the chunk.
+     *
+     *  \param p_Samples The chunk samples to check.
+     *  \param us_Samples The amount of chunk samples.
+     *  \param c_Features The chunk features, measured with the threshold of GetThreshold().
+     *
+     *  \return true if speech was found, false if not.
+     */
+
+    virtual bool IsSpeechFeatures(const MRH_Sint16* p_Samples, size_t us_Samples, AudioFeatures::Features const& /* c_Features */)
+    {
+        return IsSpeech(p_Samples, us_Samples);
+    }
+
+    //*************************************************************************************
+    // Getters
+    //*************************************************************************************
+
+    /**
+     *  Get the amplitude threshold to measure chunk features with.
+     *
+     *  \return The amplitude threshold, in the range of 1 to 32767.
+     */
+
+    virtual MRH_Sint16 GetThreshold() const noexcept
+    {
+        return 32767;
+    }
+
     //*************************************************************************************
     // Data
     //*************************************************************************************
@@ -85,10 +118,7 @@ protected:
 
     SpeechChecker(std::string const& s_Identifier) noexcept : s_Identifier(s_Identifier)
     {
-        Logger::Singleton().Log(Logger::INFO, "Created [ " +
-                                              s_Identifier +
-                                              " ] speech checker API.",
-                                "SpeechChecker.h", __LINE__);
+        MRH_LOG_INFO("Created [ {} ] speech checker API.", s_Identifier);
     }
 };
 
@@ -0,0 +1,187 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+#include <cstdio>
+#include <algorithm>
+#include <vector>
+
+// External
+
+// Project
+#include "./BenchWorker.h"
+#include "../Audio/API/CreateAudioAPI.h"
+#include "../STT/API/CreateSTTAPI.h"
+#include "../Logger.h"
+#include "../Latency.h"
+#include "../Revision.h"
+
+// Pre-defined
+#ifndef MRH_SPEECHD_CONFIGURATION_PATH
+    #define MRH_SPEECHD_CONFIGURATION_PATH "/usr/share/mrh/speechd/speechd.conf"
+#endif
+
+
+//*************************************************************************************
+// Report
+//*************************************************************************************
+
+static void Report(Corpus const& c_Corpus, MRH_Uint64 u64_WallUS) noexcept
+{
+    std::vector<MRH_Uint64> v_Latency;
+    MRH_Uint64 u64_AudioUS = 0;
+    size_t us_WordErrors = 0;
+    size_t us_ReferenceWords = 0;
+    size_t us_Failed = 0;
+
+    std::printf("File\tAudio (ms)\tSpeech Check (ms)\tTranscribe (ms)\tSpeech Chunks\tWER\tTranscript\n");
+
+    for (size_t i = 0; i < c_Corpus.GetCount(); ++i)
+    {
+        Corpus::Utterance const& c_Utterance = c_Corpus.GetUtterance(i);
+        Corpus::Result const& c_Result = c_Corpus.GetResults()[i];
+
+        if (c_Result.b_Failed == true)
+        {
+            std::printf("%s\tFAILED: %s\n", c_Utterance.s_FilePath.c_str(), c_Result.s_Error.c_str());
+
+            ++us_Failed;
+            continue;
+        }
+
+        std::printf("%s\t%.1f\t%.1f\t%.1f\t%zu/%zu\t",
+                    c_Utterance.s_FilePath.c_str(),
+                    c_Result.u64_AudioUS / 1000.0,
+                    c_Result.u64_SpeechCheckUS / 1000.0,
+                    c_Result.u64_TranscribeUS / 1000.0,
+                    c_Result.us_SpeechChunks,
+                    c_Result.us_Chunks);
+
+        if (c_Utterance.s_Reference.empty() == true)
+        {
+            std::printf("-");
+        }
+        else
+        {
+            std::printf("%.3f", c_Result.us_ReferenceWords > 0 ? static_cast<double>(c_Result.us_WordErrors) / c_Result.us_ReferenceWords : 0.0);
+
+            us_WordErrors += c_Result.us_WordErrors;
+            us_ReferenceWords += c_Result.us_ReferenceWords;
+        }
+
+        std::printf("\t%s\n", c_Result.s_Transcript.c_str());
+
+        v_Latency.push_back(c_Result.u64_TranscribeUS);
+        u64_AudioUS += c_Result.u64_AudioUS;
+    }
+
+    /**
+     *  Summary
+     */
+
+    std::printf("\nUtterances: %zu (%zu failed)\n", c_Corpus.GetCount(), us_Failed);
+    std::printf("Audio: %.2f s, Wall: %.2f s\n", u64_AudioUS / 1000000.0, u64_WallUS / 1000000.0);
+    std::printf("Throughput: %.2f audio s / wall s\n", u64_WallUS > 0 ? static_cast<double>(u64_AudioUS) / u64_WallUS : 0.0);
+
+    if (v_Latency.empty() == false)
+    {
+        std::sort(v_Latency.begin(), v_Latency.end());
+
+        std::printf("Transcribe Latency: p50 %.1f ms, p95 %.1f ms, max %.1f ms\n",
+                    v_Latency[(v_Latency.size() - 1) / 2] / 1000.0,
+                    v_Latency[((v_Latency.size() - 1) * 95) / 100] / 1000.0,
+                    v_Latency.back() / 1000.0);
+    }
+
+    if (us_ReferenceWords > 0)
+    {
+        std::printf("WER: %.3f (%zu errors, %zu reference words)\n",
+                    static_cast<double>(us_WordErrors) / us_ReferenceWords,
+                    us_WordErrors,
+                    us_ReferenceWords);
+    }
+}
+
+//*************************************************************************************
+// Main
+//*************************************************************************************
+
+int main(int argc, const char* argv[])
+{
+    if (argc < 2)
+    {
+        std::printf("Usage: %s <corpus list> [threads] [configuration file]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    MRH_LOG_INFO("= Started MRH Speech Bench ({})", VERSION_NUMBER);
+
+    Configuration c_Configuration(argc > 3 ? argv[3] : MRH_SPEECHD_CONFIGURATION_PATH);
+    size_t us_Threads = c_Configuration.c_Worker.u32_Threads;
+
+    std::shared_ptr<Corpus> p_Corpus;
+    std::vector<std::shared_ptr<BenchWorker>> v_Worker;
+    std::shared_ptr<WorkerPool> p_WorkerPool;
+
+    try
+    {
+        if (argc > 2)
+        {
+            us_Threads = static_cast<size_t>(std::stoull(argv[2]));
+        }
+
+        p_Corpus = std::make_shared<Corpus>(argv[1]);
+
+        CreateAudioAPI::Init(c_Configuration);
+        CreateSTTAPI::Init(c_Configuration);
+
+        // @NOTE: One engine instance per thread, each worker task only runs 
+        //        on one thread at a time
+        for (size_t i = 0; i < us_Threads; ++i)
+        {
+            v_Worker.emplace_back(std::make_shared<BenchWorker>(c_Configuration, p_Corpus));
+        }
+
+        p_WorkerPool = std::make_shared<WorkerPool>(us_Threads);
+    }
+    catch (std::exception& e)
+    {
+        std::printf("Failed to create components: %s\n", e.what());
+        return EXIT_FAILURE;
+    }
+
+    MRH_Uint64 u64_Start = Latency::GetTime();
+
+    for (auto& Worker : v_Worker)
+    {
+        p_WorkerPool->Schedule(Worker);
+    }
+
+    p_Corpus->Wait();
+
+    MRH_Uint64 u64_End = Latency::GetTime();
+
+    // Workers are joined before their APIs are destroyed
+    p_WorkerPool.reset();
+    v_Worker.clear();
+
+    CreateAudioAPI::Destroy(c_Configuration);
+    CreateSTTAPI::Destroy(c_Configuration);
+
+    Report(*p_Corpus, u64_End - u64_Start);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,150 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+
+// External
+
+// Project
+#include "./BenchWorker.h"
+#include "../Audio/API/CreateAudioAPI.h"
+#include "../STT/API/CreateSTTAPI.h"
+#include "../Latency.h"
+
+// Pre-defined
+#define MRH_SPEECHD_BENCH_CHUNK_SAMPLES 2048 // Default recorder frame size
+
+
+//*************************************************************************************
+// Constructor / Destructor
+//*************************************************************************************
+
+BenchWorker::BenchWorker(Configuration const& c_Configuration,
+                         std::shared_ptr<Corpus>& p_Corpus) : p_Corpus(p_Corpus),
+                                                              c_Buffer(16000)
+{
+    p_STT = CreateSTTAPI::CreateSTT(c_Configuration);
+    p_SpeechChecker = CreateAudioAPI::CreateSpeechChecker(c_Configuration);
+}
+
+BenchWorker::~BenchWorker() noexcept
+{}
+
+//*************************************************************************************
+// Run
+//*************************************************************************************
+
+bool BenchWorker::Run() noexcept
+{
+    size_t us_Index;
+
+    if (p_Corpus->Next(us_Index) == false)
+    {
+        return false;
+    }
+
+    Corpus::Result c_Result;
+
+    try
+    {
+        Process(p_Corpus->GetUtterance(us_Index), c_Result);
+    }
+    catch (Exception& e)
+    {
+        c_Result.b_Failed = true;
+        c_Result.s_Error = e.what2();
+    }
+    catch (std::exception& e)
+    {
+        c_Result.b_Failed = true;
+        c_Result.s_Error = e.what();
+    }
+
+    p_Corpus->SetResult(us_Index, c_Result);
+
+    return true;
+}
+
+//*************************************************************************************
+// Process
+//*************************************************************************************
+
+void BenchWorker::Process(Corpus::Utterance const& c_Utterance, Corpus::Result& c_Result)
+{
+    Corpus::LoadAudio(c_Utterance.s_FilePath, c_Buffer);
+
+    if (c_Buffer.GetSampleCount() == 0)
+    {
+        throw Exception("No audio samples in " +
+                        c_Utterance.s_FilePath +
+                        "!");
+    }
+
+    c_Result.u64_AudioUS = (static_cast<MRH_Uint64>(c_Buffer.GetSampleCount()) * 1000000) / c_Buffer.GetKHz();
+
+    // Speech check first, transcription empties the buffer
+    MRH_Uint64 u64_Check = Latency::GetTime();
+
+    CheckSpeech(c_Result);
+
+    MRH_Uint64 u64_Transcribe = Latency::GetTime();
+
+    p_STT->Transcribe(c_Buffer, c_STTResult);
+
+    MRH_Uint64 u64_Transcribed = Latency::GetTime();
+
+    c_Result.u64_SpeechCheckUS = u64_Transcribe - u64_Check;
+    c_Result.u64_TranscribeUS = u64_Transcribed - u64_Transcribe;
+    c_Result.s_Transcript = c_STTResult.s_Transcript;
+
+    if (c_Utterance.s_Reference.empty() == false)
+    {
+        c_Result.us_WordErrors = Corpus::GetWordErrors(c_Utterance.s_Reference,
+                                                       c_Result.s_Transcript,
+                                                       c_Result.us_ReferenceWords);
+    }
+
+    c_Result.b_Failed = false;
+}
+
+void BenchWorker::CheckSpeech(Corpus::Result& c_Result)
+{
+    AudioBuffer::ConstRegion p_Region[2];
+
+    c_Buffer.GetReadRegions(p_Region[0], p_Region[1]);
+
+    // @NOTE: Chunks do not span regions, the last chunk of a region may be shorter
+    for (size_t i = 0; i < 2; ++i)
+    {
+        const MRH_Sint16* p_Samples = p_Region[i].p_Samples;
+        size_t us_Samples = p_Region[i].us_Samples;
+
+        while (us_Samples > 0)
+        {
+            size_t us_Chunk = us_Samples < MRH_SPEECHD_BENCH_CHUNK_SAMPLES ? us_Samples : MRH_SPEECHD_BENCH_CHUNK_SAMPLES;
+
+            if (p_SpeechChecker->IsSpeech(p_Samples, us_Chunk) == true)
+            {
+                ++(c_Result.us_SpeechChunks);
+            }
+
+            ++(c_Result.us_Chunks);
+
+            p_Samples += us_Chunk;
+            us_Samples -= us_Chunk;
+        }
+    }
+}
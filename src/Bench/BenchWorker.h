@@ -0,0 +1,110 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef BenchWorker_h
+#define BenchWorker_h
+
+// C / C++
+#include <memory>
+
+// External
+
+// Project
+#include "./Corpus.h"
+#include "../Worker/WorkerPool.h"
+#include "../Audio/SpeechChecker.h"
+#include "../STT/STT.h"
+#include "../Configuration.h"
+
+
+class BenchWorker : public WorkerPool::Task
+{
+public:
+
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+
+    /**
+     *  Default constructor. The worker creates its own STT and speech 
+     *  checker instance.
+     *
+     *  \param c_Configuration The configuration to create the APIs with.
+     *  \param p_Corpus The corpus to process.
+     */
+
+    BenchWorker(Configuration const& c_Configuration,
+                std::shared_ptr<Corpus>& p_Corpus);
+
+    /**
+     *  Default destructor.
+     */
+
+    ~BenchWorker() noexcept;
+
+    //*************************************************************************************
+    // Run
+    //*************************************************************************************
+
+    /**
+     *  Process the next unclaimed corpus utterance.
+     *
+     *  \return true if more utterances might be available, false if not.
+     */
+
+    bool Run() noexcept override;
+
+private:
+
+    //*************************************************************************************
+    // Process
+    //*************************************************************************************
+
+    /**
+     *  Check and transcribe a single utterance.
+     *
+     *  \param c_Utterance The utterance to process.
+     *  \param c_Result The result to set.
+     */
+
+    void Process(Corpus::Utterance const& c_Utterance, Corpus::Result& c_Result);
+
+    /**
+     *  Run the speech checker over the loaded audio.
+     *
+     *  \param c_Result The result to set.
+     */
+
+    void CheckSpeech(Corpus::Result& c_Result);
+
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+
+    std::shared_ptr<Corpus> p_Corpus;
+
+    std::shared_ptr<STT> p_STT;
+    std::shared_ptr<SpeechChecker> p_SpeechChecker;
+
+    // @NOTE: Kept between utterances to reuse allocations
+    AudioBuffer c_Buffer;
+    STTResult c_STTResult;
+
+protected:
+
+};
+
+#endif /* BenchWorker_h */
@@ -0,0 +1,243 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+#include <fcntl.h>
+#include <fstream>
+#include <cctype>
+#include <algorithm>
+
+// External
+
+// Project
+#include "./Corpus.h"
+#include "../Audio/API/File/FileDevice.h"
+#include "../Exception.h"
+
+
+//*************************************************************************************
+// Constructor / Destructor
+//*************************************************************************************
+
+Corpus::Corpus(std::string const& s_ListPath) : us_Next(0),
+                                                 us_Finished(0)
+{
+    std::ifstream f_File(s_ListPath);
+    std::string s_Line;
+
+    if (f_File.is_open() == false)
+    {
+        throw Exception("Failed to open corpus list " +
+                        s_ListPath +
+                        "!");
+    }
+
+    while (getline(f_File, s_Line))
+    {
+        if (s_Line.empty() == true || s_Line[0] == '#')
+        {
+            continue;
+        }
+
+        size_t us_Tab = s_Line.find('\t');
+
+        if (us_Tab == std::string::npos)
+        {
+            v_Utterance.push_back({ s_Line, "" });
+        }
+        else
+        {
+            v_Utterance.push_back({ s_Line.substr(0, us_Tab), s_Line.substr(us_Tab + 1) });
+        }
+    }
+
+    f_File.close();
+
+    if (v_Utterance.empty() == true)
+    {
+        throw Exception("Corpus list " +
+                        s_ListPath +
+                        " contains no utterances!");
+    }
+
+    v_Result.resize(v_Utterance.size());
+}
+
+Corpus::~Corpus() noexcept
+{}
+
+//*************************************************************************************
+// Utterance
+//*************************************************************************************
+
+bool Corpus::Next(size_t& us_Index) noexcept
+{
+    us_Index = us_Next.fetch_add(1);
+
+    return us_Index < v_Utterance.size();
+}
+
+void Corpus::SetResult(size_t us_Index, Result& c_Result) noexcept
+{
+    {
+        std::lock_guard<std::mutex> c_Guard(c_Mutex);
+
+        v_Result[us_Index] = std::move(c_Result);
+        ++us_Finished;
+    }
+
+    c_Condition.notify_all();
+}
+
+void Corpus::Wait() noexcept
+{
+    std::unique_lock<std::mutex> c_Lock(c_Mutex);
+
+    c_Condition.wait(c_Lock, [this]() { return us_Finished == v_Utterance.size(); });
+}
+
+//*************************************************************************************
+// Audio
+//*************************************************************************************
+
+void Corpus::LoadAudio(std::string const& s_FilePath, AudioBuffer& c_Buffer)
+{
+    int i_FD = open(s_FilePath.c_str(), O_RDONLY | O_CLOEXEC);
+
+    if (i_FD < 0)
+    {
+        throw Exception("Failed to open audio file " +
+                        s_FilePath +
+                        "!");
+    }
+
+    try
+    {
+        MRH_Uint32 u32_KHz = 0;
+        size_t us_Samples = FileDevice::ReadWAVHeader(i_FD, u32_KHz) / sizeof(MRH_Sint16);
+
+        // Read directly into the buffer storage
+        AudioBuffer::Region c_First;
+        AudioBuffer::Region c_Second;
+
+        c_Buffer.Reset(u32_KHz);
+        c_Buffer.GetWriteRegions(c_First, c_Second, us_Samples);
+
+        size_t us_Read = FileDevice::Read(i_FD, c_First.p_Samples, c_First.us_Samples * sizeof(MRH_Sint16));
+
+        if (us_Read == c_First.us_Samples * sizeof(MRH_Sint16) && c_Second.us_Samples > 0)
+        {
+            us_Read += FileDevice::Read(i_FD, c_Second.p_Samples, c_Second.us_Samples * sizeof(MRH_Sint16));
+        }
+
+        c_Buffer.Commit(us_Read / sizeof(MRH_Sint16));
+    }
+    catch (...)
+    {
+        close(i_FD);
+        throw;
+    }
+
+    close(i_FD);
+}
+
+//*************************************************************************************
+// Word Error Rate
+//*************************************************************************************
+
+std::vector<std::string> Corpus::GetWords(std::string const& s_String)
+{
+    std::vector<std::string> v_Word;
+    std::string s_Word;
+
+    for (char c : s_String)
+    {
+        unsigned char u8_Char = static_cast<unsigned char>(c);
+
+        if (std::isspace(u8_Char) != 0)
+        {
+            if (s_Word.empty() == false)
+            {
+                v_Word.emplace_back(std::move(s_Word));
+                s_Word.clear();
+            }
+        }
+        else if (u8_Char >= 0x80 || std::isalnum(u8_Char) != 0 || c == '\'')
+        {
+            // @NOTE: UTF-8 multi byte characters are kept as they are
+            s_Word += static_cast<char>(std::tolower(u8_Char));
+        }
+    }
+
+    if (s_Word.empty() == false)
+    {
+        v_Word.emplace_back(std::move(s_Word));
+    }
+
+    return v_Word;
+}
+
+size_t Corpus::GetWordErrors(std::string const& s_Reference, std::string const& s_Transcript, size_t& us_ReferenceWords)
+{
+    std::vector<std::string> v_Reference = GetWords(s_Reference);
+    std::vector<std::string> v_Transcript = GetWords(s_Transcript);
+
+    us_ReferenceWords = v_Reference.size();
+
+    // Levenshtein distance over words, one row at a time
+    std::vector<size_t> v_Previous(v_Transcript.size() + 1);
+    std::vector<size_t> v_Current(v_Transcript.size() + 1);
+
+    for (size_t j = 0; j <= v_Transcript.size(); ++j)
+    {
+        v_Previous[j] = j;
+    }
+
+    for (size_t i = 1; i <= v_Reference.size(); ++i)
+    {
+        v_Current[0] = i;
+
+        for (size_t j = 1; j <= v_Transcript.size(); ++j)
+        {
+            size_t us_Substitute = v_Previous[j - 1] + (v_Reference[i - 1] == v_Transcript[j - 1] ? 0 : 1);
+
+            v_Current[j] = std::min(us_Substitute, std::min(v_Previous[j], v_Current[j - 1]) + 1);
+        }
+
+        v_Previous.swap(v_Current);
+    }
+
+    return v_Previous[v_Transcript.size()];
+}
+
+//*************************************************************************************
+// Getters
+//*************************************************************************************
+
+Corpus::Utterance const& Corpus::GetUtterance(size_t us_Index) const noexcept
+{
+    return v_Utterance[us_Index];
+}
+
+std::vector<Corpus::Result> const& Corpus::GetResults() const noexcept
+{
+    return v_Result;
+}
+
+size_t Corpus::GetCount() const noexcept
+{
+    return v_Utterance.size();
+}
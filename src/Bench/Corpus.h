@@ -0,0 +1,206 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef Corpus_h
+#define Corpus_h
+
+// C / C++
+#include <vector>
+#include <string>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+
+// External
+#include <MRH_Typedefs.h>
+
+// Project
+#include "../Audio/AudioBuffer.h"
+
+
+class Corpus
+{
+public:
+
+    //*************************************************************************************
+    // Types
+    //*************************************************************************************
+
+    struct Utterance
+    {
+        std::string s_FilePath;
+        std::string s_Reference; // Empty if no reference is known
+    };
+
+    struct Result
+    {
+        bool b_Failed = true;
+        std::string s_Error = "";
+        std::string s_Transcript = "";
+
+        MRH_Uint64 u64_AudioUS = 0;
+        MRH_Uint64 u64_SpeechCheckUS = 0;
+        MRH_Uint64 u64_TranscribeUS = 0;
+
+        size_t us_Chunks = 0;
+        size_t us_SpeechChunks = 0;
+
+        size_t us_WordErrors = 0;
+        size_t us_ReferenceWords = 0;
+    };
+
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+
+    /**
+     *  Default constructor.
+     *
+     *  \param s_ListPath The corpus list file. Each line contains a WAV file path, 
+     *                    optionally followed by a tab and the reference transcript.
+     */
+
+    Corpus(std::string const& s_ListPath);
+
+    /**
+     *  Default destructor.
+     */
+
+    ~Corpus() noexcept;
+
+    //*************************************************************************************
+    // Utterance
+    //*************************************************************************************
+
+    /**
+     *  Claim the next utterance to process.
+     *
+     *  \param us_Index The claimed utterance index.
+     *
+     *  \return true if a utterance was claimed, false if none are left.
+     */
+
+    bool Next(size_t& us_Index) noexcept;
+
+    /**
+     *  Set the result of a claimed utterance.
+     *
+     *  \param us_Index The utterance index.
+     *  \param c_Result The utterance result. The result is moved.
+     */
+
+    void SetResult(size_t us_Index, Result& c_Result) noexcept;
+
+    /**
+     *  Wait until all utterances have a result.
+     */
+
+    void Wait() noexcept;
+
+    //*************************************************************************************
+    // Audio
+    //*************************************************************************************
+
+    /**
+     *  Load a 16 bit mono PCM WAV file.
+     *
+     *  \param s_FilePath The WAV file to load.
+     *  \param c_Buffer The buffer to load into. The buffer is overwritten.
+     */
+
+    static void LoadAudio(std::string const& s_FilePath, AudioBuffer& c_Buffer);
+
+    //*************************************************************************************
+    // Word Error Rate
+    //*************************************************************************************
+
+    /**
+     *  Get the word level edit distance between a reference and a transcript. 
+     *  Words are compared case insensitive without punctuation.
+     *
+     *  \param s_Reference The reference transcript.
+     *  \param s_Transcript The transcript to compare.
+     *  \param us_ReferenceWords The amount of words in the reference.
+     *
+     *  \return The amount of substituted, deleted and inserted words.
+     */
+
+    static size_t GetWordErrors(std::string const& s_Reference, std::string const& s_Transcript, size_t& us_ReferenceWords);
+
+    //*************************************************************************************
+    // Getters
+    //*************************************************************************************
+
+    /**
+     *  Get a utterance.
+     *
+     *  \param us_Index The utterance index.
+     *
+     *  \return The utterance.
+     */
+
+    Utterance const& GetUtterance(size_t us_Index) const noexcept;
+
+    /**
+     *  Get all results. Only valid after Wait() returned.
+     *
+     *  \return The utterance results, in corpus order.
+     */
+
+    std::vector<Result> const& GetResults() const noexcept;
+
+    /**
+     *  Get the amount of utterances.
+     *
+     *  \return The utterance count.
+     */
+
+    size_t GetCount() const noexcept;
+
+private:
+
+    //*************************************************************************************
+    // Word Error Rate
+    //*************************************************************************************
+
+    /**
+     *  Split a transcript into normalized words.
+     *
+     *  \param s_String The transcript to split.
+     *
+     *  \return The lowercase words without punctuation.
+     */
+
+    static std::vector<std::string> GetWords(std::string const& s_String);
+
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+
+    std::vector<Utterance> v_Utterance;
+    std::vector<Result> v_Result;
+
+    std::atomic<size_t> us_Next;
+
+    std::mutex c_Mutex;
+    std::condition_variable c_Condition;
+    size_t us_Finished;
+
+protected:
+
+};
+
+#endif /* Corpus_h */
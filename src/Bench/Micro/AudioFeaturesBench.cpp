@@ -0,0 +1,99 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// External
+
+// Project
+#include "./MicroBench.h"
+#include "../../Audio/AudioFeatures.h"
+
+// Pre-defined
+#define MICRO_BENCH_AUDIO_FEATURES_SAMPLES 2048 // Default recording frame size
+#define MICRO_BENCH_AUDIO_FEATURES_ITERATIONS 20000
+#define MICRO_BENCH_AUDIO_FEATURES_GAIN 1.5f
+#define MICRO_BENCH_AUDIO_FEATURES_THRESHOLD 1000
+
+// Namespace
+namespace
+{
+    // @NOTE: Results are kept to stop the compiler from removing the measured calls
+    volatile size_t us_Sink = 0;
+
+    template<typename Function>
+    void Run(std::string const& s_Case, Function&& Call)
+    {
+        using MicroBench::GetTimeNS;
+
+        size_t us_Loud = 0;
+
+        MRH_Uint64 u64_Start = GetTimeNS();
+
+        for (int i = 0; i < MICRO_BENCH_AUDIO_FEATURES_ITERATIONS; ++i)
+        {
+            us_Loud += Call().us_Loud;
+        }
+
+        MRH_Uint64 u64_End = GetTimeNS();
+
+        us_Sink = us_Sink + us_Loud;
+
+        double f64_Seconds = (u64_End - u64_Start) / 1000000000.0;
+        char p_Note[64];
+        std::snprintf(p_Note, sizeof(p_Note), "%.1f MSamples/s", f64_Seconds > 0.0 ? (static_cast<double>(MICRO_BENCH_AUDIO_FEATURES_SAMPLES) * MICRO_BENCH_AUDIO_FEATURES_ITERATIONS) / f64_Seconds / 1000000.0 : 0.0);
+
+        MicroBench::Report("AudioFeatures",
+                           s_Case + ", " + std::to_string(MICRO_BENCH_AUDIO_FEATURES_SAMPLES) + " samples",
+                           MICRO_BENCH_AUDIO_FEATURES_ITERATIONS,
+                           u64_End - u64_Start,
+                           p_Note);
+    }
+}
+
+
+//*************************************************************************************
+// AudioFeatures
+//*************************************************************************************
+
+void MicroBench::AudioFeatures()
+{
+    using namespace ::AudioFeatures;
+
+    std::mt19937 c_Random(8);
+    std::uniform_int_distribution<int> c_Sample(-32768, 32767);
+
+    std::vector<MRH_Sint16> v_Input(MICRO_BENCH_AUDIO_FEATURES_SAMPLES);
+    std::vector<MRH_Sint16> v_Output(MICRO_BENCH_AUDIO_FEATURES_SAMPLES);
+
+    for (auto& Sample : v_Input)
+    {
+        Sample = static_cast<MRH_Sint16>(c_Sample(c_Random));
+    }
+
+    const MRH_Sint16* p_Input = v_Input.data();
+    MRH_Sint16* p_Output = v_Output.data();
+    std::string s_SIMD = MRH_AUDIO_FEATURES_SIMD;
+
+    Run("Measure (" + s_SIMD + ")", [&]() { return Measure(p_Input, MICRO_BENCH_AUDIO_FEATURES_SAMPLES, MICRO_BENCH_AUDIO_FEATURES_THRESHOLD); });
+    Run("MeasureScalar", [&]() { return MeasureScalar(p_Input, MICRO_BENCH_AUDIO_FEATURES_SAMPLES, MICRO_BENCH_AUDIO_FEATURES_THRESHOLD); });
+
+    Run("Process<true, true> (" + s_SIMD + ")", [&]() { return Process<true, true>(p_Input, p_Output, MICRO_BENCH_AUDIO_FEATURES_SAMPLES, MICRO_BENCH_AUDIO_FEATURES_GAIN, MICRO_BENCH_AUDIO_FEATURES_THRESHOLD); });
+    Run("AmplifyScalar", [&]() { return AmplifyScalar(p_Input, p_Output, MICRO_BENCH_AUDIO_FEATURES_SAMPLES, MICRO_BENCH_AUDIO_FEATURES_GAIN, MICRO_BENCH_AUDIO_FEATURES_THRESHOLD); });
+}
@@ -0,0 +1,321 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+#include <sys/stat.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <fstream>
+#include <new>
+
+// External
+#include <google/cloud/texttospeech/v1/cloud_tts.grpc.pb.h>
+#include <grpcpp/grpcpp.h>
+#include <libmrhvt/String/MRH_LocalisedPath.h>
+
+// Project
+#include "./MicroBench.h"
+#include "../../TTS/API/GoogleCloudTTS/GoogleCloudTTS.h"
+#include "../../GoogleCloud/GoogleCloudChannel.h"
+#include "../../Exception.h"
+
+// Pre-defined
+#define MICRO_BENCH_GOOGLE_CLOUD_TTS_CHANNEL "texttospeech.googleapis.com" // Target used by GoogleCloudTTS
+#ifndef MICRO_BENCH_GOOGLE_CLOUD_TTS_BCP_DIR_PATH
+    #define MICRO_BENCH_GOOGLE_CLOUD_TTS_BCP_DIR_PATH "/tmp/mrhspeechd-microbench-gcloud/"
+#endif
+#define MICRO_BENCH_GOOGLE_CLOUD_TTS_KHZ 16000
+#define MICRO_BENCH_GOOGLE_CLOUD_TTS_ITERATIONS 200 // Syntheses per case
+
+// Namespace
+using google::cloud::texttospeech::v1::TextToSpeech;
+using google::cloud::texttospeech::v1::SynthesizeSpeechRequest;
+using google::cloud::texttospeech::v1::SynthesizeSpeechResponse;
+using google::cloud::texttospeech::v1::AudioEncoding;
+using google::cloud::texttospeech::v1::SsmlVoiceGender;
+
+namespace
+{
+    // @NOTE: Only allocations made by the measuring thread are counted, the
+    //        fake server and the gRPC threads are excluded
+    thread_local bool b_CountAllocations = false;
+    thread_local MRH_Uint64 u64_Allocations = 0;
+    thread_local MRH_Uint64 u64_AllocatedBytes = 0;
+
+    void* Allocate(std::size_t us_Size)
+    {
+        if (b_CountAllocations == true)
+        {
+            ++u64_Allocations;
+            u64_AllocatedBytes += us_Size;
+        }
+
+        void* p_Memory = std::malloc(us_Size > 0 ? us_Size : 1);
+
+        if (p_Memory == NULL)
+        {
+            throw std::bad_alloc();
+        }
+
+        return p_Memory;
+    }
+
+    const MRH_Uint32 p_Seconds[] = { 1, 4, 16 }; // Synthesized audio per call
+
+    class FakeTextToSpeech : public TextToSpeech::Service
+    {
+    public:
+
+        //*************************************************************************************
+        // Constructor / Destructor
+        //*************************************************************************************
+
+        FakeTextToSpeech() : i_Port(0)
+        {
+            grpc::ServerBuilder c_Builder;
+
+            c_Builder.AddListeningPort("127.0.0.1:0", grpc::InsecureServerCredentials(), &i_Port);
+            c_Builder.RegisterService(this);
+
+            p_Server = c_Builder.BuildAndStart();
+
+            if (p_Server == NULL || i_Port == 0)
+            {
+                throw Exception("Failed to start fake text to speech server!");
+            }
+        }
+
+        ~FakeTextToSpeech() noexcept
+        {
+            p_Server->Shutdown(std::chrono::system_clock::now());
+            p_Server->Wait();
+        }
+
+        //*************************************************************************************
+        // Service
+        //*************************************************************************************
+
+        grpc::Status SynthesizeSpeech(grpc::ServerContext* p_Context,
+                                      const SynthesizeSpeechRequest* p_Request,
+                                      SynthesizeSpeechResponse* p_Response) override
+        {
+            (void)p_Context;
+            (void)p_Request;
+
+            p_Response->set_audio_content(s_Audio);
+
+            return grpc::Status::OK;
+        }
+
+        //*************************************************************************************
+        // Getters
+        //*************************************************************************************
+
+        std::string GetAddress() const noexcept
+        {
+            return "127.0.0.1:" + std::to_string(i_Port);
+        }
+
+        //*************************************************************************************
+        // Setters
+        //*************************************************************************************
+
+        // @NOTE: Only set while no call is running
+        void SetAudio(MRH_Uint32 u32_Seconds)
+        {
+            s_Audio.assign(u32_Seconds * MICRO_BENCH_GOOGLE_CLOUD_TTS_KHZ * sizeof(MRH_Sint16), '\x01');
+        }
+
+    private:
+
+        //*************************************************************************************
+        // Data
+        //*************************************************************************************
+
+        std::unique_ptr<grpc::Server> p_Server;
+        int i_Port;
+
+        std::string s_Audio;
+
+    protected:
+
+    };
+
+    void CreateLocaleFile(Configuration::GoogleCloudTTS const& c_Configuration)
+    {
+        std::string s_FilePath = MRH::VT::LocalisedPath::GetPath(c_Configuration.s_BCPDirPath, c_Configuration.s_BCPFileName);
+
+        // The localised path might add directories below the given one
+        for (size_t us_Pos = s_FilePath.find('/', 1); us_Pos != std::string::npos; us_Pos = s_FilePath.find('/', us_Pos + 1))
+        {
+            if (mkdir(s_FilePath.substr(0, us_Pos).c_str(), 0700) < 0 && errno != EEXIST)
+            {
+                throw Exception("Failed to create " + s_FilePath.substr(0, us_Pos) + "!");
+            }
+        }
+
+        std::ofstream f_File(s_FilePath, std::ios::trunc);
+
+        if (f_File.is_open() == false)
+        {
+            throw Exception("Failed to create " + s_FilePath + "!");
+        }
+
+        f_File << "en-US" << std::endl;
+    }
+
+    // @NOTE: Previous synthesis path, messages are created and configured for
+    //        every call
+    void SynthesizeFresh(TextToSpeech::Stub& c_Stub, std::string const& s_String, AudioBuffer& c_Buffer)
+    {
+        SynthesizeSpeechRequest c_Request;
+
+        auto* p_AudioConfig = c_Request.mutable_audio_config();
+        p_AudioConfig->set_audio_encoding(AudioEncoding::LINEAR16);
+        p_AudioConfig->set_sample_rate_hertz(MICRO_BENCH_GOOGLE_CLOUD_TTS_KHZ);
+
+        auto* p_VoiceConfig = c_Request.mutable_voice();
+        p_VoiceConfig->set_ssml_gender(SsmlVoiceGender::FEMALE);
+        p_VoiceConfig->set_language_code("en-US");
+
+        c_Request.mutable_input()->set_text(s_String);
+
+        grpc::ClientContext c_Context;
+        GoogleCloudChannel::SetDeadline(c_Context, 10000);
+
+        SynthesizeSpeechResponse c_Response;
+        grpc::Status c_RPCStatus = c_Stub.SynthesizeSpeech(&c_Context, c_Request, &c_Response);
+
+        if (c_RPCStatus.ok() == false)
+        {
+            throw Exception("Failed to synthesise: " + c_RPCStatus.error_message());
+        }
+
+        c_Buffer.Reset(MICRO_BENCH_GOOGLE_CLOUD_TTS_KHZ);
+        c_Buffer.AddBytes(c_Response.audio_content().data(), c_Response.audio_content().size() / sizeof(MRH_Sint16));
+    }
+
+    template<typename Synthesize>
+    void Run(const char* p_Case, MRH_Uint32 u32_Seconds, Synthesize&& Call)
+    {
+        using MicroBench::GetTimeNS;
+
+        // Warm up, reused storage is sized by the first call
+        Call();
+
+        u64_Allocations = 0;
+        u64_AllocatedBytes = 0;
+        b_CountAllocations = true;
+
+        MRH_Uint64 u64_Start = GetTimeNS();
+
+        for (int i = 0; i < MICRO_BENCH_GOOGLE_CLOUD_TTS_ITERATIONS; ++i)
+        {
+            Call();
+        }
+
+        MRH_Uint64 u64_End = GetTimeNS();
+
+        b_CountAllocations = false;
+
+        // @NOTE: Each synthesis copies the audio once into the playback buffer,
+        //        further copies show up as allocated payload bytes
+        double f64_Seconds = static_cast<double>(u32_Seconds) * MICRO_BENCH_GOOGLE_CLOUD_TTS_ITERATIONS;
+        char p_Note[128];
+        std::snprintf(p_Note, sizeof(p_Note), "%.1f allocs/op, %.1f allocs/s synthesized, %.1f KiB allocated/s synthesized, %.2f buffer copies/s synthesized",
+                      static_cast<double>(u64_Allocations) / MICRO_BENCH_GOOGLE_CLOUD_TTS_ITERATIONS,
+                      u64_Allocations / f64_Seconds,
+                      (u64_AllocatedBytes / 1024.0) / f64_Seconds,
+                      MICRO_BENCH_GOOGLE_CLOUD_TTS_ITERATIONS / f64_Seconds);
+
+        MicroBench::Report("GoogleCloudTTS",
+                           std::string(p_Case) + ", " + std::to_string(u32_Seconds) + " s",
+                           MICRO_BENCH_GOOGLE_CLOUD_TTS_ITERATIONS,
+                           u64_End - u64_Start,
+                           p_Note);
+    }
+}
+
+//*************************************************************************************
+// Allocation
+//*************************************************************************************
+
+void* operator new(std::size_t us_Size)
+{
+    return Allocate(us_Size);
+}
+
+void* operator new[](std::size_t us_Size)
+{
+    return Allocate(us_Size);
+}
+
+void operator delete(void* p_Memory) noexcept
+{
+    std::free(p_Memory);
+}
+
+void operator delete[](void* p_Memory) noexcept
+{
+    std::free(p_Memory);
+}
+
+void operator delete(void* p_Memory, std::size_t) noexcept
+{
+    std::free(p_Memory);
+}
+
+void operator delete[](void* p_Memory, std::size_t) noexcept
+{
+    std::free(p_Memory);
+}
+
+//*************************************************************************************
+// GoogleCloudTTS
+//*************************************************************************************
+
+void MicroBench::GoogleCloudTTS()
+{
+    FakeTextToSpeech c_Server;
+    c_Server.SetAudio(p_Seconds[0]);
+
+    // Both paths share the stand-in channel to the fake server
+    GoogleCloudChannel::SetStandIn(MICRO_BENCH_GOOGLE_CLOUD_TTS_CHANNEL, c_Server.GetAddress());
+
+    Configuration::GoogleCloudTTS c_Configuration;
+    c_Configuration.s_BCPDirPath = MICRO_BENCH_GOOGLE_CLOUD_TTS_BCP_DIR_PATH;
+    c_Configuration.u32_KHz = MICRO_BENCH_GOOGLE_CLOUD_TTS_KHZ;
+
+    CreateLocaleFile(c_Configuration);
+
+    ::GoogleCloudTTS c_TTS(c_Configuration);
+    std::unique_ptr<TextToSpeech::Stub> p_Stub = TextToSpeech::NewStub(GoogleCloudChannel::GetChannel(MICRO_BENCH_GOOGLE_CLOUD_TTS_CHANNEL));
+
+    std::string s_String = "The quick brown fox jumps over the lazy dog.";
+
+    for (auto& Seconds : p_Seconds)
+    {
+        c_Server.SetAudio(Seconds);
+
+        // Preallocated, playback buffer growth is not measured
+        AudioBuffer c_Buffer(MICRO_BENCH_GOOGLE_CLOUD_TTS_KHZ, Seconds * MICRO_BENCH_GOOGLE_CLOUD_TTS_KHZ);
+
+        Run("Fresh messages", Seconds, [&]() { SynthesizeFresh(*p_Stub, s_String, c_Buffer); });
+        Run("Reused messages", Seconds, [&]() { c_TTS.Synthesize(s_String, c_Buffer); });
+    }
+}
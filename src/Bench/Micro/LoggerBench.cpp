@@ -0,0 +1,92 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+
+// External
+
+// Project
+#include "./MicroBench.h"
+#include "../../Logger.h"
+
+// Pre-defined
+#define MICRO_BENCH_LOGGER_ITERATIONS 100000
+
+
+//*************************************************************************************
+// Logger
+//*************************************************************************************
+
+void MicroBench::Logger()
+{
+    // Create the logger and its threads before measuring
+    ::Logger::Singleton();
+
+    std::string s_Name = "Session";
+    MRH_Uint64 u64_Start;
+    MRH_Uint64 u64_End;
+
+    /**
+     *  Enabled
+     */
+
+    // @NOTE: Formatted and queued on the calling thread, written by the
+    //        logger thread
+    u64_Start = GetTimeNS();
+
+    for (int i = 0; i < MICRO_BENCH_LOGGER_ITERATIONS; ++i)
+    {
+        MRH_LOG_INFO("Bench message {} for {}.", i, s_Name);
+    }
+
+    u64_End = GetTimeNS();
+
+    Report("Logger", "MRH_LOG_INFO", MICRO_BENCH_LOGGER_ITERATIONS, u64_End - u64_Start, "Logged");
+
+    /**
+     *  Filtered
+     */
+
+    // @NOTE: Below the runtime level, the arguments are never formatted
+    u64_Start = GetTimeNS();
+
+    for (int i = 0; i < MICRO_BENCH_LOGGER_ITERATIONS; ++i)
+    {
+        MRH_LOG(spdlog::level::debug, "Bench message {} for {}.", i, s_Name);
+    }
+
+    u64_End = GetTimeNS();
+
+    Report("Logger", "MRH_LOG (debug)", MICRO_BENCH_LOGGER_ITERATIONS, u64_End - u64_Start, "Filtered at runtime");
+
+    /**
+     *  Message
+     */
+
+    // Built message strings, as logged before the macros
+    u64_Start = GetTimeNS();
+
+    for (int i = 0; i < MICRO_BENCH_LOGGER_ITERATIONS; ++i)
+    {
+        ::Logger::Singleton().Log(::Logger::INFO,
+                                  "Bench message " + std::to_string(i) + " for " + s_Name + ".",
+                                  __FILE__, __LINE__);
+    }
+
+    u64_End = GetTimeNS();
+
+    Report("Logger", "Log()", MICRO_BENCH_LOGGER_ITERATIONS, u64_End - u64_Start, "Logged, message built by caller");
+}
@@ -0,0 +1,107 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef MicroBench_h
+#define MicroBench_h
+
+// C / C++
+#include <string>
+
+// External
+#include <MRH_Typedefs.h>
+
+// Project
+
+
+namespace MicroBench
+{
+    //*************************************************************************************
+    // Benchmarks
+    //*************************************************************************************
+
+    /**
+     *  Measure the per call cost of the logging macros for logged and filtered 
+     *  levels.
+     */
+
+    void Logger();
+
+    /**
+     *  Measure the UTF-8 stream read and write throughput for both framings 
+     *  over a local socket.
+     */
+
+    void UTF8Stream();
+
+    /**
+     *  Measure the vectorized audio feature processing against the scalar 
+     *  reference for a recording frame.
+     */
+
+    void AudioFeatures();
+
+#if MRH_SPEECHD_SOUND_IO_API_SDL2 > 0
+    /**
+     *  Measure the SDL2 player callback for frame sizes from 256 to 8192 
+     *  frames without a audio device.
+     */
+
+    void SDL2Player();
+#endif
+
+#if MRH_SPEECHD_TTS_API_GGOGLE_CLOUD > 0
+    /**
+     *  Measure the Google Cloud TTS synthesis against a local fake server, 
+     *  with allocations and copies per synthesized second.
+     */
+
+    void GoogleCloudTTS();
+#endif
+
+    //*************************************************************************************
+    // Time
+    //*************************************************************************************
+
+    /**
+     *  Get the current steady clock time.
+     *
+     *  \return The current time in nanoseconds.
+     */
+
+    MRH_Uint64 GetTimeNS() noexcept;
+
+    //*************************************************************************************
+    // Report
+    //*************************************************************************************
+
+    /**
+     *  Print the result of a measured case.
+     *
+     *  \param s_Benchmark The benchmark the case belongs to.
+     *  \param s_Case The measured case.
+     *  \param u64_Iterations The number of measured iterations.
+     *  \param u64_TimeNS The time taken by all iterations in nanoseconds.
+     *  \param s_Note Additional information about the case. 
+     */
+
+    void Report(std::string const& s_Benchmark,
+                std::string const& s_Case,
+                MRH_Uint64 u64_Iterations,
+                MRH_Uint64 u64_TimeNS,
+                std::string const& s_Note = "") noexcept;
+};
+
+#endif /* MicroBench_h */
@@ -0,0 +1,117 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <exception>
+
+// External
+
+// Project
+#include "./MicroBench.h"
+#include "../../Revision.h"
+
+// Namespace
+namespace
+{
+    struct Benchmark
+    {
+        const char* p_Name;
+        void (*Run)();
+    };
+
+    const Benchmark p_Benchmark[] =
+    {
+        { "Logger", MicroBench::Logger },
+        { "UTF8Stream", MicroBench::UTF8Stream },
+        { "AudioFeatures", MicroBench::AudioFeatures },
+#if MRH_SPEECHD_SOUND_IO_API_SDL2 > 0
+        { "SDL2Player", MicroBench::SDL2Player },
+#endif
+#if MRH_SPEECHD_TTS_API_GGOGLE_CLOUD > 0
+        { "GoogleCloudTTS", MicroBench::GoogleCloudTTS },
+#endif
+    };
+}
+
+
+//*************************************************************************************
+// Time
+//*************************************************************************************
+
+MRH_Uint64 MicroBench::GetTimeNS() noexcept
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//*************************************************************************************
+// Report
+//*************************************************************************************
+
+void MicroBench::Report(std::string const& s_Benchmark,
+                        std::string const& s_Case,
+                        MRH_Uint64 u64_Iterations,
+                        MRH_Uint64 u64_TimeNS,
+                        std::string const& s_Note) noexcept
+{
+    std::printf("%s\t%s\t%llu\t%.1f\t%s\n",
+                s_Benchmark.c_str(),
+                s_Case.c_str(),
+                static_cast<unsigned long long>(u64_Iterations),
+                u64_Iterations > 0 ? static_cast<double>(u64_TimeNS) / u64_Iterations : 0.0,
+                s_Note.c_str());
+    std::fflush(stdout);
+}
+
+//*************************************************************************************
+// Main
+//*************************************************************************************
+
+int main(int argc, const char* argv[])
+{
+    std::printf("MRH Speech Micro Bench (%s)\n\n", VERSION_NUMBER);
+    std::printf("Benchmark\tCase\tIterations\tns/op\tNote\n");
+
+    // @NOTE: All benchmarks run if none are given
+    for (auto& Benchmark : p_Benchmark)
+    {
+        bool b_Run = (argc < 2);
+
+        for (int i = 1; i < argc && b_Run == false; ++i)
+        {
+            b_Run = (std::strcmp(argv[i], Benchmark.p_Name) == 0);
+        }
+
+        if (b_Run == false)
+        {
+            continue;
+        }
+
+        try
+        {
+            Benchmark.Run();
+        }
+        catch (std::exception& e)
+        {
+            std::printf("%s\tFAILED: %s\n", Benchmark.p_Name, e.what());
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
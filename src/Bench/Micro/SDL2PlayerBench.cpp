@@ -0,0 +1,82 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+#include <vector>
+
+// External
+
+// Project
+#include "./MicroBench.h"
+#include "../../Audio/API/SDL2/SDL2Player.h"
+
+// Pre-defined
+#define MICRO_BENCH_SDL2_PLAYER_CALLBACKS 20000 // Callbacks per frame size
+#define MICRO_BENCH_SDL2_PLAYER_BATCH 15 // Callbacks per queue refill
+
+// Namespace
+namespace
+{
+    const size_t p_Frames[] = { 256, 512, 1024, 2048, 4096, 8192 };
+}
+
+
+//*************************************************************************************
+// SDL2Player
+//*************************************************************************************
+
+void MicroBench::SDL2Player()
+{
+    std::shared_ptr<Latency::Marks> p_Marks = std::make_shared<Latency::Marks>();
+
+    for (auto& Frames : p_Frames)
+    {
+        // @NOTE: Mono 16 bit, one sample per frame. Half a frame stays queued
+        //        between batches, callbacks read across queue wraps
+        SDL2PlaybackContext c_Context(p_Marks);
+        c_Context.c_Queue.Reset(Frames * (MICRO_BENCH_SDL2_PLAYER_BATCH + 1));
+
+        std::vector<MRH_Sint16> v_Source(Frames * MICRO_BENCH_SDL2_PLAYER_BATCH, 1);
+        std::vector<Uint8> v_Stream(Frames * sizeof(MRH_Sint16));
+        int i_Length = static_cast<int>(v_Stream.size());
+
+        c_Context.c_Queue.Push(v_Source.data(), Frames / 2);
+
+        MRH_Uint64 u64_TimeNS = 0;
+        MRH_Uint64 u64_Callbacks = 0;
+
+        while (u64_Callbacks < MICRO_BENCH_SDL2_PLAYER_CALLBACKS)
+        {
+            c_Context.c_Queue.Push(v_Source.data(), v_Source.size());
+
+            MRH_Uint64 u64_Start = GetTimeNS();
+
+            for (int i = 0; i < MICRO_BENCH_SDL2_PLAYER_BATCH; ++i)
+            {
+                ::SDL2Player::Callback(&c_Context, v_Stream.data(), i_Length);
+            }
+
+            u64_TimeNS += GetTimeNS() - u64_Start;
+            u64_Callbacks += MICRO_BENCH_SDL2_PLAYER_BATCH;
+        }
+
+        Report("SDL2Player",
+               "Callback, " + std::to_string(Frames) + " frames",
+               u64_Callbacks,
+               u64_TimeNS,
+               std::to_string(Frames * sizeof(MRH_Sint16)) + " B per callback");
+    }
+}
@@ -0,0 +1,260 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <thread>
+
+// External
+
+// Project
+#include "./MicroBench.h"
+#include "../../Stream/UTF8Stream.h"
+
+// Pre-defined
+#ifndef MICRO_BENCH_UTF8_STREAM_SOCKET_PATH
+    #define MICRO_BENCH_UTF8_STREAM_SOCKET_PATH "/tmp/mrhspeechd-microbench.sock"
+#endif
+#define MICRO_BENCH_UTF8_STREAM_QUEUE_SIZE (64 * 1024 * 1024)
+#define MICRO_BENCH_UTF8_STREAM_IO_SIZE (64 * 1024) // Bytes per peer socket call
+
+// Namespace
+namespace
+{
+    struct Case
+    {
+        size_t us_Size;
+        size_t us_Count;
+    };
+
+    // @NOTE: NUL terminated messages are limited to the event string size
+    const Case p_TerminatedCase[] =
+    {
+        { 64, 100000 },
+        { 1024, 20000 }
+    };
+
+    const Case p_LengthCase[] =
+    {
+        { 64, 100000 },
+        { 1024, 20000 },
+        { 256 * 1024, 64 }
+    };
+
+    void Frame(std::string& s_Buffer, std::string const& s_Message, UTF8Stream::Framing e_Framing) noexcept
+    {
+        if (e_Framing == UTF8Stream::FRAMING_LENGTH)
+        {
+            MRH_Uint32 u32_Length = static_cast<MRH_Uint32>(s_Message.size());
+
+            s_Buffer += static_cast<char>(1);
+
+            for (int i = 0; i < 4; ++i)
+            {
+                s_Buffer += static_cast<char>((u32_Length >> (8 * i)) & 0xFF);
+            }
+
+            s_Buffer += s_Message;
+        }
+        else
+        {
+            s_Buffer += s_Message;
+            s_Buffer += '\0';
+        }
+    }
+
+    std::string GetNote(size_t us_Bytes, MRH_Uint64 u64_TimeNS) noexcept
+    {
+        char p_Note[64];
+        std::snprintf(p_Note, sizeof(p_Note), "%.1f MiB/s", u64_TimeNS > 0 ? (us_Bytes / (1024.0 * 1024.0)) / (u64_TimeNS / 1000000000.0) : 0.0);
+
+        return p_Note;
+    }
+
+    void Run(UTF8Stream::Framing e_Framing, const char* p_Framing, Case const& c_Case)
+    {
+        using MicroBench::GetTimeNS;
+
+        std::string s_Message(c_Case.us_Size, 'a');
+        std::string s_Case = std::string(p_Framing) + ", " + std::to_string(c_Case.us_Size) + " B";
+
+        // Listen first, the stream connects on creation
+        unlink(MICRO_BENCH_UTF8_STREAM_SOCKET_PATH);
+
+        int i_ListenFD = socket(AF_UNIX, SOCK_STREAM, 0);
+        struct sockaddr_un c_Address;
+
+        std::memset(&c_Address, 0, sizeof(c_Address));
+        c_Address.sun_family = AF_UNIX;
+        std::strncpy(c_Address.sun_path, MICRO_BENCH_UTF8_STREAM_SOCKET_PATH, sizeof(c_Address.sun_path) - 1);
+
+        if (i_ListenFD < 0 ||
+            bind(i_ListenFD, (struct sockaddr*)&c_Address, sizeof(c_Address)) < 0 ||
+            listen(i_ListenFD, 1) < 0)
+        {
+            std::printf("UTF8Stream\t%s\tFAILED: %s\n", s_Case.c_str(), std::strerror(errno));
+
+            if (i_ListenFD >= 0)
+            {
+                close(i_ListenFD);
+            }
+            return;
+        }
+
+        std::shared_ptr<EventQueue> p_EventQueue = std::make_shared<EventQueue>(std::vector<int>(), 1);
+        std::shared_ptr<Latency::Marks> p_Marks = std::make_shared<Latency::Marks>();
+        UTF8Stream c_Stream(MICRO_BENCH_UTF8_STREAM_SOCKET_PATH,
+                            e_Framing,
+                            MICRO_BENCH_UTF8_STREAM_QUEUE_SIZE,
+                            0,
+                            "null",
+                            p_EventQueue,
+                            0,
+                            p_Marks);
+
+        int i_PeerFD = accept(i_ListenFD, NULL, NULL);
+
+        if (i_PeerFD < 0)
+        {
+            std::printf("UTF8Stream\t%s\tFAILED: %s\n", s_Case.c_str(), std::strerror(errno));
+
+            close(i_ListenFD);
+            return;
+        }
+
+        std::vector<MRH_Uint32> v_Events;
+        std::vector<int> v_Signal;
+
+        while (c_Stream.IsConnected() == false)
+        {
+            p_EventQueue->Wait(v_Events, v_Signal);
+        }
+
+        /**
+         *  Read
+         */
+
+        // @NOTE: The peer writes all messages, the stream thread parses and
+        //        the calling thread takes them
+        std::string s_Framed;
+        s_Framed.reserve((c_Case.us_Size + 5) * c_Case.us_Count);
+
+        for (size_t i = 0; i < c_Case.us_Count; ++i)
+        {
+            Frame(s_Framed, s_Message, e_Framing);
+        }
+
+        MRH_Uint64 u64_Start = GetTimeNS();
+
+        std::thread c_Writer([&]()
+        {
+            for (size_t us_Written = 0; us_Written < s_Framed.size();)
+            {
+                ssize_t ss_Result = write(i_PeerFD,
+                                          s_Framed.data() + us_Written,
+                                          std::min<size_t>(s_Framed.size() - us_Written, MICRO_BENCH_UTF8_STREAM_IO_SIZE));
+
+                if (ss_Result <= 0)
+                {
+                    break;
+                }
+
+                us_Written += ss_Result;
+            }
+        });
+
+        size_t us_Received = 0;
+
+        while (us_Received < c_Case.us_Count)
+        {
+            p_EventQueue->Wait(v_Events, v_Signal);
+
+            while (c_Stream.GetAvailable() == true)
+            {
+                c_Stream.GetMessage();
+                ++us_Received;
+            }
+        }
+
+        MRH_Uint64 u64_End = GetTimeNS();
+        c_Writer.join();
+
+        MicroBench::Report("UTF8Stream", "Read " + s_Case, c_Case.us_Count, u64_End - u64_Start, GetNote(s_Framed.size(), u64_End - u64_Start));
+
+        /**
+         *  Write
+         */
+
+        // @NOTE: Queued by the calling thread, framed and sent by the stream 
+        //        thread, the peer reads until all bytes arrived
+        u64_Start = GetTimeNS();
+
+        std::thread c_Reader([&]()
+        {
+            std::vector<char> v_Buffer(MICRO_BENCH_UTF8_STREAM_IO_SIZE);
+
+            for (size_t us_Read = 0; us_Read < s_Framed.size();)
+            {
+                ssize_t ss_Result = read(i_PeerFD, v_Buffer.data(), v_Buffer.size());
+
+                if (ss_Result <= 0)
+                {
+                    break;
+                }
+
+                us_Read += ss_Result;
+            }
+        });
+
+        for (size_t i = 0; i < c_Case.us_Count; ++i)
+        {
+            c_Stream.Write(s_Message);
+        }
+
+        c_Reader.join();
+        u64_End = GetTimeNS();
+
+        MicroBench::Report("UTF8Stream", "Write " + s_Case, c_Case.us_Count, u64_End - u64_Start, GetNote(s_Framed.size(), u64_End - u64_Start));
+
+        close(i_PeerFD);
+        close(i_ListenFD);
+        unlink(MICRO_BENCH_UTF8_STREAM_SOCKET_PATH);
+    }
+}
+
+
+//*************************************************************************************
+// UTF8Stream
+//*************************************************************************************
+
+void MicroBench::UTF8Stream()
+{
+    for (auto& Case : p_TerminatedCase)
+    {
+        Run(::UTF8Stream::FRAMING_TERMINATED, "Terminated", Case);
+    }
+
+    for (auto& Case : p_LengthCase)
+    {
+        Run(::UTF8Stream::FRAMING_LENGTH, "Length", Case);
+    }
+}
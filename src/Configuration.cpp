@@ -39,10 +39,29 @@ namespace
         BLOCK_GOOGLE_CLOUD_TTS = 6,
         BLOCK_GOOGLE_CLOUD_STT = 7,
         BLOCK_PICOVOICE_LEOPARD,
+        BLOCK_TTS_CACHE,
+        BLOCK_FILE_RECORDER,
+        BLOCK_FILE_PLAYER,
+        BLOCK_SESSION,
+        BLOCK_WORKER,
+        BLOCK_ESPEAK_NG_TTS,
 
         // Service Key
         SERVICE_SOCKET_PATH,
 
+        // Session Key
+        SESSION_SOCKET_PATH,
+        SESSION_RECORDING_DEVICE,
+        SESSION_PLAYBACK_DEVICE,
+        SESSION_FRAMING,
+        SESSION_QUEUE_SIZE,
+        SESSION_QUEUE_MAX_AGE,
+        SESSION_QUEUE_FILE_PATH,
+        SESSION_AUDIO_SOCKET_PATH,
+
+        // Worker Key
+        WORKER_THREADS,
+
         // API Key
         API_RECORDING_API,
         API_PLAYBACK_API,
@@ -55,38 +74,70 @@ namespace
         SDL2_RECORDER_KHZ,
         SDL2_RECORDER_SAMPLES_PER_FRAME,
         SDL2_RECORDER_TRAILING_FRAME_SIZE,
+        SDL2_RECORDER_PRE_ROLL_SIZE,
         SDL2_RECORDER_AMPLIFICATION,
 
         // SDL2 Player Key
         SDL2_PLAYER_DEVICE_NAME,
         SDL2_PLAYER_SAMPLES_PER_FRAME,
 
+        // File Recorder Key
+        FILE_RECORDER_FILE_PATH,
+        FILE_RECORDER_KHZ,
+        FILE_RECORDER_SAMPLES_PER_FRAME,
+        FILE_RECORDER_TRAILING_FRAME_SIZE,
+        FILE_RECORDER_PRE_ROLL_SIZE,
+        FILE_RECORDER_SPEED,
+        FILE_RECORDER_LOOP,
+
+        // File Player Key
+        FILE_PLAYER_FILE_PATH,
+        FILE_PLAYER_SAMPLES_PER_FRAME,
+        FILE_PLAYER_SPEED,
+
         // Chunk Volume Key
+        CHUNK_VOLUME_MODE,
         CHUNK_VOLUME_MIN_VOLUME,
         CHUNK_VOLUME_MIN_SAMPLES,
+        CHUNK_VOLUME_MAX_CROSSING_RATE,
 
         // Picovoice Cobra Key
         PICOVOICE_COBRA_ACCESS_KEY_PATH,
         PICOVOICE_COBRA_MIN_CONFIDENCE,
 
+        // TTS Cache Key
+        TTS_CACHE_MEMORY_SIZE,
+        TTS_CACHE_DISK_SIZE,
+        TTS_CACHE_DIRECTORY_PATH,
+
         // Google Cloud TTS Key
         GOOGLE_CLOUD_TTS_BCP_DIRECTORY_PATH,
         GOOGLE_CLOUD_TTS_BCP_FILE_NAME,
         GOOGLE_CLOUD_TTS_VOICE_GENDER,
         GOOGLE_CLOUD_TTS_KHZ,
-        GOOGLE_CLOUD_TTS_CHUNK_SAMPLES,
+        GOOGLE_CLOUD_TTS_DEADLINE_MS,
 
         // Google Cloud STT Key
         GOOGLE_CLOUD_STT_BCP_DIRECTORY_PATH,
         GOOGLE_CLOUD_STT_BCP_FILE_NAME,
+        GOOGLE_CLOUD_STT_DEADLINE_MS,
+        GOOGLE_CLOUD_STT_MAX_ALTERNATIVES,
+        GOOGLE_CLOUD_STT_WORD_TIME_OFFSETS,
 
         // Picovoice Leopard Key
         PICOVOICE_LEOPARD_ACCESS_KEY_PATH,
         PICOVOICE_LEOPARD_MODEL_DIRECTORY_PATH,
         PICOVOICE_LEOPARD_MODEL_FILE_NAME,
 
+        // eSpeak NG TTS Key
+        ESPEAK_NG_TTS_DATA_PATH,
+        ESPEAK_NG_TTS_VOICE_DIRECTORY_PATH,
+        ESPEAK_NG_TTS_VOICE_FILE_NAME,
+        ESPEAK_NG_TTS_RATE,
+        ESPEAK_NG_TTS_PITCH,
+
         // Bounds
-        IDENTIFIER_MAX = PICOVOICE_LEOPARD_MODEL_FILE_NAME,
+        IDENTIFIER_MAX = ESPEAK_NG_TTS_PITCH,
 
         IDENTIFIER_COUNT = IDENTIFIER_MAX + 1
     };
@@ -103,10 +154,29 @@ namespace
         "GoogleCloudTTS",
         "GoogleCloudSTT",
         "PicovoiceLeopard",
+        "TTSCache",
+        "FileRecorder",
+        "FilePlayer",
+        "Session",
+        "Worker",
+        "ESpeakNGTTS",
 
         // Service
         "SocketPath",
 
+        // Session Key
+        "SocketPath",
+        "RecordingDevice",
+        "PlaybackDevice",
+        "Framing",
+        "QueueSize",
+        "QueueMaxAge",
+        "QueueFilePath",
+        "AudioSocketPath",
+
+        // Worker Key
+        "Threads",
+
         // API Key
         "Recording",
         "Playback",
@@ -119,35 +189,67 @@ namespace
         "KHz",
         "SamplesPerFrame",
         "TrailingFrameSize",
+        "PreRollSize",
         "Amplification",
 
         // SDL2 Player Key
         "DeviceName",
         "SamplesPerFrame",
 
+        // File Recorder Key
+        "FilePath",
+        "KHz",
+        "SamplesPerFrame",
+        "TrailingFrameSize",
+        "PreRollSize",
+        "Speed",
+        "Loop",
+
+        // File Player Key
+        "FilePath",
+        "SamplesPerFrame",
+        "Speed",
+
         // Chunk Volume Key
+        "Mode",
         "MinVolume",
         "MinSamples",
+        "MaxCrossingRate",
 
         // Picovoice Cobra Key
         "AccessKeyPath",
         "MinConfidence",
 
+        // TTS Cache Key
+        "MemorySize",
+        "DiskSize",
+        "DirectoryPath",
+
         // Google Cloud TTS Key
         "BCPDirectoryPath",
         "BCPFileName",
         "VoiceGender",
         "KHz",
-        "ChunkSamples",
+        "DeadlineMS",
 
         // Google Cloud STT Key
         "BCPDirectoryPath",
         "BCPFileName",
+        "DeadlineMS",
+        "MaxAlternatives",
+        "WordTimeOffsets",
 
         // Picovoice Leopard Key
         "AccessKeyPath",
         "ModelDirectoryPath",
-        "ModelFileName"
+        "ModelFileName",
+
+        // eSpeak NG TTS Key
+        "DataPath",
+        "VoiceDirectoryPath",
+        "VoiceFileName",
+        "Rate",
+        "Pitch"
     };
 }
 
@@ -175,6 +277,34 @@ Configuration::Configuration(std::string const& s_FilePath) noexcept
                 continue;
             }
 
+            /**
+             *  Session
+             */
+
+            if (Block.GetName().compare(p_Identifier[BLOCK_SESSION]) == 0)
+            {
+                Session c_Session;
+                c_Session.s_SocketPath = Block.GetValue(p_Identifier[SESSION_SOCKET_PATH]);
+                c_Session.s_RecordingDevice = Block.GetValue(p_Identifier[SESSION_RECORDING_DEVICE]);
+                c_Session.s_PlaybackDevice = Block.GetValue(p_Identifier[SESSION_PLAYBACK_DEVICE]);
+                c_Session.u8_Framing = static_cast<MRH_Uint8>(std::stoi(Block.GetValue(p_Identifier[SESSION_FRAMING])));
+                c_Session.us_QueueSize = static_cast<size_t>(std::stoull(Block.GetValue(p_Identifier[SESSION_QUEUE_SIZE])));
+                c_Session.u32_QueueMaxAgeS = static_cast<MRH_Uint32>(std::stoull(Block.GetValue(p_Identifier[SESSION_QUEUE_MAX_AGE])));
+                c_Session.s_QueueFilePath = Block.GetValue(p_Identifier[SESSION_QUEUE_FILE_PATH]);
+                c_Session.s_AudioSocketPath = Block.GetValue(p_Identifier[SESSION_AUDIO_SOCKET_PATH]);
+
+                v_Session.emplace_back(c_Session);
+
+                continue;
+            }
+
+            if (Block.GetName().compare(p_Identifier[BLOCK_WORKER]) == 0)
+            {
+                c_Worker.u32_Threads = static_cast<MRH_Uint32>(std::stoull(Block.GetValue(p_Identifier[WORKER_THREADS])));
+
+                continue;
+            }
+
             /**
              *  API
              */
@@ -201,11 +331,27 @@ Configuration::Configuration(std::string const& s_FilePath) noexcept
                 c_SDL2Recorder.u32_KHz = static_cast<MRH_Uint32>(std::stoull(Block.GetValue(p_Identifier[SDL2_RECORDER_KHZ])));
                 c_SDL2Recorder.u32_SamplesPerFrame = static_cast<MRH_Uint32>(std::stoull(Block.GetValue(p_Identifier[SDL2_RECORDER_SAMPLES_PER_FRAME])));
                 c_SDL2Recorder.u32_TrailingFrameSize = static_cast<MRH_Uint32>(std::stoull(Block.GetValue(p_Identifier[SDL2_RECORDER_TRAILING_FRAME_SIZE])));
+                c_SDL2Recorder.u32_PreRollSize = static_cast<MRH_Uint32>(std::stoull(Block.GetValue(p_Identifier[SDL2_RECORDER_PRE_ROLL_SIZE])));
                 c_SDL2Recorder.f32_Amplification = std::stof(Block.GetValue(p_Identifier[SDL2_RECORDER_AMPLIFICATION]));
 
                 continue;
             }
 #endif
+
+#if MRH_SPEECHD_SOUND_IO_API_FILE > 0
+            if (Block.GetName().compare(p_Identifier[BLOCK_FILE_RECORDER]) == 0)
+            {
+                c_FileRecorder.s_FilePath = Block.GetValue(p_Identifier[FILE_RECORDER_FILE_PATH]);
+                c_FileRecorder.u32_KHz = static_cast<MRH_Uint32>(std::stoull(Block.GetValue(p_Identifier[FILE_RECORDER_KHZ])));
+                c_FileRecorder.u32_SamplesPerFrame = static_cast<MRH_Uint32>(std::stoull(Block.GetValue(p_Identifier[FILE_RECORDER_SAMPLES_PER_FRAME])));
+                c_FileRecorder.u32_TrailingFrameSize = static_cast<MRH_Uint32>(std::stoull(Block.GetValue(p_Identifier[FILE_RECORDER_TRAILING_FRAME_SIZE])));
+                c_FileRecorder.u32_PreRollSize = static_cast<MRH_Uint32>(std::stoull(Block.GetValue(p_Identifier[FILE_RECORDER_PRE_ROLL_SIZE])));
+                c_FileRecorder.f32_Speed = std::stof(Block.GetValue(p_Identifier[FILE_RECORDER_SPEED]));
+                c_FileRecorder.b_Loop = std::stoi(Block.GetValue(p_Identifier[FILE_RECORDER_LOOP])) != 0;
+
+                continue;
+            }
+#endif
             
             /**
              *  Playback
@@ -221,14 +367,27 @@ Configuration::Configuration(std::string const& s_FilePath) noexcept
             }
 #endif
 
+#if MRH_SPEECHD_SOUND_IO_API_FILE > 0
+            if (Block.GetName().compare(p_Identifier[BLOCK_FILE_PLAYER]) == 0)
+            {
+                c_FilePlayer.s_FilePath = Block.GetValue(p_Identifier[FILE_PLAYER_FILE_PATH]);
+                c_FilePlayer.u32_SamplesPerFrame = static_cast<MRH_Uint32>(std::stoull(Block.GetValue(p_Identifier[FILE_PLAYER_SAMPLES_PER_FRAME])));
+                c_FilePlayer.f32_Speed = std::stof(Block.GetValue(p_Identifier[FILE_PLAYER_SPEED]));
+
+                continue;
+            }
+#endif
+
             /**
              *  Speech Check
              */
 
             if (Block.GetName().compare(p_Identifier[BLOCK_CHUNK_VOLUME]) == 0)
             {
+                c_ChunkVolume.u8_Mode = static_cast<MRH_Uint8>(std::stoi(Block.GetValue(p_Identifier[CHUNK_VOLUME_MODE])));
                 c_ChunkVolume.f32_MinVolume = std::stof(Block.GetValue(p_Identifier[CHUNK_VOLUME_MIN_VOLUME]));
-                c_ChunkVolume.f32_MinVolume = std::stof(Block.GetValue(p_Identifier[CHUNK_VOLUME_MIN_SAMPLES]));
+                c_ChunkVolume.f32_MinSamples = std::stof(Block.GetValue(p_Identifier[CHUNK_VOLUME_MIN_SAMPLES]));
+                c_ChunkVolume.f32_MaxCrossingRate = std::stof(Block.GetValue(p_Identifier[CHUNK_VOLUME_MAX_CROSSING_RATE]));
 
                 continue;
             }
@@ -247,6 +406,15 @@ Configuration::Configuration(std::string const& s_FilePath) noexcept
              *  TTS
              */
 
+            if (Block.GetName().compare(p_Identifier[BLOCK_TTS_CACHE]) == 0)
+            {
+                c_TTSCache.us_MemorySize = static_cast<size_t>(std::stoull(Block.GetValue(p_Identifier[TTS_CACHE_MEMORY_SIZE])));
+                c_TTSCache.us_DiskSize = static_cast<size_t>(std::stoull(Block.GetValue(p_Identifier[TTS_CACHE_DISK_SIZE])));
+                c_TTSCache.s_DirectoryPath = Block.GetValue(p_Identifier[TTS_CACHE_DIRECTORY_PATH]);
+
+                continue;
+            }
+
 #if MRH_SPEECHD_TTS_API_GGOGLE_CLOUD > 0
             if (Block.GetName().compare(p_Identifier[BLOCK_GOOGLE_CLOUD_TTS]) == 0)
             {
@@ -254,7 +422,20 @@ Configuration::Configuration(std::string const& s_FilePath) noexcept
                 c_GoogleCloudTTS.s_BCPFileName = Block.GetValue(p_Identifier[GOOGLE_CLOUD_TTS_BCP_FILE_NAME]);
                 c_GoogleCloudTTS.u8_VoiceGender = static_cast<MRH_Uint8>(std::stoull(Block.GetValue(p_Identifier[GOOGLE_CLOUD_TTS_VOICE_GENDER])));
                 c_GoogleCloudTTS.u32_KHz = static_cast<MRH_Uint32>(std::stoull(Block.GetValue(p_Identifier[GOOGLE_CLOUD_TTS_KHZ])));
-                c_GoogleCloudTTS.u32_ChunkSamples = static_cast<MRH_Uint32>(std::stoull(Block.GetValue(p_Identifier[GOOGLE_CLOUD_TTS_CHUNK_SAMPLES])));
+                c_GoogleCloudTTS.u32_DeadlineMS = static_cast<MRH_Uint32>(std::stoull(Block.GetValue(p_Identifier[GOOGLE_CLOUD_TTS_DEADLINE_MS])));
+
+                continue;
+            }
+#endif
+
+#if MRH_SPEECHD_TTS_API_ESPEAK_NG > 0
+            if (Block.GetName().compare(p_Identifier[BLOCK_ESPEAK_NG_TTS]) == 0)
+            {
+                c_ESpeakNGTTS.s_DataPath = Block.GetValue(p_Identifier[ESPEAK_NG_TTS_DATA_PATH]);
+                c_ESpeakNGTTS.s_VoiceDirPath = Block.GetValue(p_Identifier[ESPEAK_NG_TTS_VOICE_DIRECTORY_PATH]);
+                c_ESpeakNGTTS.s_VoiceFileName = Block.GetValue(p_Identifier[ESPEAK_NG_TTS_VOICE_FILE_NAME]);
+                c_ESpeakNGTTS.u32_Rate = static_cast<MRH_Uint32>(std::stoull(Block.GetValue(p_Identifier[ESPEAK_NG_TTS_RATE])));
+                c_ESpeakNGTTS.u32_Pitch = static_cast<MRH_Uint32>(std::stoull(Block.GetValue(p_Identifier[ESPEAK_NG_TTS_PITCH])));
 
                 continue;
             }
@@ -269,6 +450,9 @@ Configuration::Configuration(std::string const& s_FilePath) noexcept
             {
                 c_GoogleCloudSTT.s_BCPDirPath = Block.GetValue(p_Identifier[GOOGLE_CLOUD_STT_BCP_DIRECTORY_PATH]);
                 c_GoogleCloudSTT.s_BCPFileName = Block.GetValue(p_Identifier[GOOGLE_CLOUD_STT_BCP_FILE_NAME]);
+                c_GoogleCloudSTT.u32_DeadlineMS = static_cast<MRH_Uint32>(std::stoull(Block.GetValue(p_Identifier[GOOGLE_CLOUD_STT_DEADLINE_MS])));
+                c_GoogleCloudSTT.u32_MaxAlternatives = static_cast<MRH_Uint32>(std::stoull(Block.GetValue(p_Identifier[GOOGLE_CLOUD_STT_MAX_ALTERNATIVES])));
+                c_GoogleCloudSTT.b_WordTimeOffsets = std::stoi(Block.GetValue(p_Identifier[GOOGLE_CLOUD_STT_WORD_TIME_OFFSETS])) != 0;
 
                 continue;
             }
@@ -288,9 +472,16 @@ Configuration::Configuration(std::string const& s_FilePath) noexcept
     }
     catch (std::exception& e)
     {
-        Logger::Singleton().Log(Logger::WARNING, "Could not read configuration: " +
-                                                 std::string(e.what()),
-                                "Configuration.cpp", __LINE__);
+        MRH_LOG_WARNING("Could not read configuration: {}", e.what());
+    }
+
+    // No session blocks, use the service socket and API devices
+    if (v_Session.empty() == true)
+    {
+        Session c_Session;
+        c_Session.s_SocketPath = c_Service.s_SocketPath;
+
+        v_Session.emplace_back(c_Session);
     }
 }
 
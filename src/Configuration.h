@@ -18,6 +18,7 @@
 #define Configuration_h
 
 // C / C++
+#include <vector>
 
 // External
 #include <MRH_Typedefs.h>
@@ -46,6 +47,27 @@ public:
         std::string s_SocketPath = "/tmp/mrh/mrhpsspeech_audio.sock";
     };
 
+    /**
+     *  Session
+     */
+
+    struct Session
+    {
+        std::string s_SocketPath = "/tmp/mrh/mrhpsspeech_audio.sock";
+        std::string s_RecordingDevice = ""; // Empty uses the recording API block
+        std::string s_PlaybackDevice = ""; // Empty uses the playback API block
+        MRH_Uint8 u8_Framing = 0;
+        size_t us_QueueSize = 1048576; // 1 MiB
+        MRH_Uint32 u32_QueueMaxAgeS = 300;
+        std::string s_QueueFilePath = "null";
+        std::string s_AudioSocketPath = "null"; // null disables the audio stream
+    };
+
+    struct Worker
+    {
+        MRH_Uint32 u32_Threads = 2;
+    };
+
     /**
      *  API
      */
@@ -70,10 +92,24 @@ public:
         MRH_Uint32 u32_KHz = 16000;
         MRH_Uint32 u32_SamplesPerFrame = 2048;
         MRH_Uint32 u32_TrailingFrameSize = 32000;
+        MRH_Uint32 u32_PreRollSize = 8000;
         MRH_Sfloat32 f32_Amplification = 1.f;
     };
 #endif
 
+#if MRH_SPEECHD_SOUND_IO_API_FILE > 0
+    struct FileRecorder
+    {
+        std::string s_FilePath = "/tmp/mrh/mrhspeechd_input.wav";
+        MRH_Uint32 u32_KHz = 16000;
+        MRH_Uint32 u32_SamplesPerFrame = 2048;
+        MRH_Uint32 u32_TrailingFrameSize = 32000;
+        MRH_Uint32 u32_PreRollSize = 8000;
+        MRH_Sfloat32 f32_Speed = 1.f;
+        bool b_Loop = false;
+    };
+#endif
+
     /**
      *  Playback
      */
@@ -86,14 +122,25 @@ public:
     };
 #endif
 
+#if MRH_SPEECHD_SOUND_IO_API_FILE > 0
+    struct FilePlayer
+    {
+        std::string s_FilePath = "null";
+        MRH_Uint32 u32_SamplesPerFrame = 2048;
+        MRH_Sfloat32 f32_Speed = 1.f;
+    };
+#endif
+
     /**
      *  Speech Check
      */
 
     struct ChunkVolume
     {
+        MRH_Uint8 u8_Mode = 0;
         MRH_Sfloat32 f32_MinVolume = 0.5f;
         MRH_Sfloat32 f32_MinSamples = 0.2f;
+        MRH_Sfloat32 f32_MaxCrossingRate = 0.25f;
     };
 
 #if MRH_SPEECHD_SPEECH_CHECKER_API_PICOVOICE_COBRA > 0
@@ -108,6 +155,13 @@ public:
      *  TTS
      */
 
+    struct TTSCache
+    {
+        size_t us_MemorySize = 33554432; // 32 MiB
+        size_t us_DiskSize = 0;
+        std::string s_DirectoryPath = "/var/cache/mrh/speechd/tts/";
+    };
+
 #if MRH_SPEECHD_TTS_API_GGOGLE_CLOUD > 0
     struct GoogleCloudTTS
     {
@@ -115,7 +169,18 @@ public:
         std::string s_BCPFileName = "locale.conf";
         MRH_Uint8 u8_VoiceGender = 0;
         MRH_Uint32 u32_KHz = 16000;
-        MRH_Uint32 u32_ChunkSamples = 2048;
+        MRH_Uint32 u32_DeadlineMS = 10000;
+    };
+#endif
+
+#if MRH_SPEECHD_TTS_API_ESPEAK_NG > 0
+    struct ESpeakNGTTS
+    {
+        std::string s_DataPath = "null";
+        std::string s_VoiceDirPath = "/usr/share/mrh/speechd/espeakng/";
+        std::string s_VoiceFileName = "voice.conf";
+        MRH_Uint32 u32_Rate = 175;
+        MRH_Uint32 u32_Pitch = 50;
     };
 #endif
 
@@ -128,6 +193,9 @@ public:
     {
         std::string s_BCPDirPath = "/usr/share/mrh/speechd/gcloud/";
         std::string s_BCPFileName = "locale.conf";
+        MRH_Uint32 u32_DeadlineMS = 10000;
+        MRH_Uint32 u32_MaxAlternatives = 1;
+        bool b_WordTimeOffsets = false;
     };
 #endif
 
@@ -168,6 +236,13 @@ public:
 
     Service c_Service;
 
+    /**
+     *  Session
+     */
+
+    std::vector<Session> v_Session; // At least one session
+    Worker c_Worker;
+
     /**
      *  API
      */
@@ -181,6 +256,9 @@ public:
 #if MRH_SPEECHD_SOUND_IO_API_SDL2 > 0
     SDL2Recorder c_SDL2Recorder;
 #endif
+#if MRH_SPEECHD_SOUND_IO_API_FILE > 0
+    FileRecorder c_FileRecorder;
+#endif
 
     /**
      *  Playback
@@ -189,6 +267,9 @@ public:
 #if MRH_SPEECHD_SOUND_IO_API_SDL2 > 0
     SDL2Player c_SDL2Player;
 #endif
+#if MRH_SPEECHD_SOUND_IO_API_FILE > 0
+    FilePlayer c_FilePlayer;
+#endif
 
     /**
      *  Speech Check
@@ -203,9 +284,13 @@ public:
      *  TTS
      */
 
+    TTSCache c_TTSCache;
 #if MRH_SPEECHD_TTS_API_GGOGLE_CLOUD > 0
     GoogleCloudTTS c_GoogleCloudTTS;
 #endif
+#if MRH_SPEECHD_TTS_API_ESPEAK_NG > 0
+    ESpeakNGTTS c_ESpeakNGTTS;
+#endif
 
     /**
      *  STT
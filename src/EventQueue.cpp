@@ -0,0 +1,218 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/signalfd.h>
+#include <unistd.h>
+#include <csignal>
+#include <cstring>
+#include <cerrno>
+
+// External
+
+// Project
+#include "./EventQueue.h"
+#include "./Logger.h"
+#include "./Exception.h"
+
+
+//*************************************************************************************
+// Constructor / Destructor
+//*************************************************************************************
+
+EventQueue::EventQueue(std::vector<int> const& v_Signal, size_t us_Channels) : i_EpollFD(-1),
+                                                                                i_EventFD(-1),
+                                                                                i_SignalFD(-1),
+                                                                                v_Pending(us_Channels > 0 ? us_Channels : 1)
+{
+    for (auto& Pending : v_Pending)
+    {
+        Pending.store(0, std::memory_order_relaxed);
+    }
+
+    sigset_t c_Set;
+    sigemptyset(&c_Set);
+
+    for (auto& Signal : v_Signal)
+    {
+        sigaddset(&c_Set, Signal);
+    }
+
+    // @NOTE: Blocked signals are only delivered to the signal file descriptor
+    if (pthread_sigmask(SIG_BLOCK, &c_Set, NULL) != 0)
+    {
+        throw Exception("Failed to block signals!");
+    }
+
+    struct epoll_event c_Event;
+    std::memset(&c_Event, 0, sizeof(c_Event));
+    c_Event.events = EPOLLIN;
+
+    if ((i_EpollFD = epoll_create1(EPOLL_CLOEXEC)) < 0 ||
+        (i_EventFD = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) < 0 ||
+        (i_SignalFD = signalfd(-1, &c_Set, SFD_NONBLOCK | SFD_CLOEXEC)) < 0)
+    {
+        std::string s_Error = std::strerror(errno);
+
+        Close();
+
+        throw Exception("Failed to create event queue: " +
+                        s_Error);
+    }
+
+    c_Event.data.fd = i_EventFD;
+
+    if (epoll_ctl(i_EpollFD, EPOLL_CTL_ADD, i_EventFD, &c_Event) < 0)
+    {
+        std::string s_Error = std::strerror(errno);
+
+        Close();
+
+        throw Exception("Failed to add event descriptor: " +
+                        s_Error);
+    }
+
+    c_Event.data.fd = i_SignalFD;
+
+    if (epoll_ctl(i_EpollFD, EPOLL_CTL_ADD, i_SignalFD, &c_Event) < 0)
+    {
+        std::string s_Error = std::strerror(errno);
+
+        Close();
+
+        throw Exception("Failed to add signal descriptor: " +
+                        s_Error);
+    }
+}
+
+EventQueue::~EventQueue() noexcept
+{
+    Close();
+}
+
+void EventQueue::Close() noexcept
+{
+    if (i_SignalFD >= 0)
+    {
+        close(i_SignalFD);
+        i_SignalFD = -1;
+    }
+
+    if (i_EventFD >= 0)
+    {
+        close(i_EventFD);
+        i_EventFD = -1;
+    }
+
+    if (i_EpollFD >= 0)
+    {
+        close(i_EpollFD);
+        i_EpollFD = -1;
+    }
+}
+
+//*************************************************************************************
+// Notify
+//*************************************************************************************
+
+void EventQueue::Notify(Event e_Event, size_t us_Channel) noexcept
+{
+    MRH_Uint32 u32_Event = 1u << e_Event;
+
+    if (us_Channel >= v_Pending.size() ||
+        v_Pending[us_Channel].fetch_or(u32_Event, std::memory_order_acq_rel) != 0)
+    {
+        return;
+    }
+
+    // @NOTE: No logging here, the audio thread should never block
+    uint64_t u64_Value = 1;
+    ssize_t ss_Result;
+
+    do
+    {
+        ss_Result = write(i_EventFD, &u64_Value, sizeof(u64_Value));
+    }
+    while (ss_Result < 0 && errno == EINTR);
+}
+
+//*************************************************************************************
+// Wait
+//*************************************************************************************
+
+void EventQueue::Wait(std::vector<MRH_Uint32>& v_Events, std::vector<int>& v_Signal) noexcept
+{
+    struct epoll_event p_Event[2];
+    uint64_t u64_Value;
+
+    v_Events.resize(v_Pending.size());
+
+    while (true)
+    {
+        // Reset the event descriptor before taking events, events added
+        // afterwards wake the next wait
+        while (read(i_EventFD, &u64_Value, sizeof(u64_Value)) < 0 && errno == EINTR)
+        {}
+
+        ReadSignals(v_Signal);
+
+        bool b_Events = false;
+
+        for (size_t i = 0; i < v_Pending.size(); ++i)
+        {
+            if ((v_Events[i] = v_Pending[i].exchange(0, std::memory_order_acq_rel)) != 0)
+            {
+                b_Events = true;
+            }
+        }
+
+        if (b_Events == true || v_Signal.empty() == false)
+        {
+            return;
+        }
+
+        if (epoll_wait(i_EpollFD, p_Event, 2, -1) < 0 && errno != EINTR)
+        {
+            MRH_LOG_ERROR("Failed to wait for events: {}", std::strerror(errno));
+            return;
+        }
+    }
+}
+
+void EventQueue::ReadSignals(std::vector<int>& v_Signal) noexcept
+{
+    struct signalfd_siginfo c_Info;
+
+    while (true)
+    {
+        ssize_t ss_Result = read(i_SignalFD, &c_Info, sizeof(c_Info));
+
+        if (ss_Result == sizeof(c_Info))
+        {
+            v_Signal.emplace_back(static_cast<int>(c_Info.ssi_signo));
+        }
+        else if (ss_Result < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        else
+        {
+            break;
+        }
+    }
+}
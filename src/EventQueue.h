@@ -0,0 +1,159 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef EventQueue_h
+#define EventQueue_h
+
+// C / C++
+#include <atomic>
+#include <vector>
+
+// External
+#include <MRH_Typedefs.h>
+
+// Project
+
+
+class EventQueue
+{
+public:
+
+    //*************************************************************************************
+    // Types
+    //*************************************************************************************
+
+    typedef enum
+    {
+        EVENT_MESSAGE = 0, // Socket message received
+        EVENT_CONNECTION = 1, // Socket connected or disconnected
+        EVENT_RECORDING = 2, // Recorded audio available
+        EVENT_RECORDING_FINISHED = 3, // Recording ended
+        EVENT_SYNTHESIZED = 4, // Synthesized output audio available
+
+        // Bounds
+        EVENT_MAX = EVENT_SYNTHESIZED,
+
+        EVENT_COUNT = EVENT_MAX + 1
+
+    }Event;
+
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+
+    /**
+     *  Default constructor. The given signals are blocked for the calling
+     *  thread and received by the queue instead. Threads created afterwards
+     *  inherit the blocked signals, the queue should be created first.
+     *
+     *  \param v_Signal The signals to receive.
+     *  \param us_Channels The number of independent event channels.
+     */
+
+    EventQueue(std::vector<int> const& v_Signal, size_t us_Channels);
+
+    /**
+     *  Default destructor.
+     */
+
+    ~EventQueue() noexcept;
+
+    //*************************************************************************************
+    // Notify
+    //*************************************************************************************
+
+    /**
+     *  Add an event. Events of the same type are merged until received. This
+     *  function is lock free and can be called from audio callbacks.
+     *
+     *  \param e_Event The event to add.
+     *  \param us_Channel The channel to add the event to.
+     */
+
+    void Notify(Event e_Event, size_t us_Channel) noexcept;
+
+    //*************************************************************************************
+    // Wait
+    //*************************************************************************************
+
+    /**
+     *  Wait for events or signals. Returns immediately if signals are
+     *  already given.
+     *
+     *  \param v_Events The received events for each channel.
+     *  \param v_Signal The received signals in the order they were read. Signals are
+     *                  appended.
+     */
+
+    void Wait(std::vector<MRH_Uint32>& v_Events, std::vector<int>& v_Signal) noexcept;
+
+    /**
+     *  Receive pending signals without waiting.
+     *
+     *  \param v_Signal The received signals in the order they were read. Signals are
+     *                  appended.
+     */
+
+    void ReadSignals(std::vector<int>& v_Signal) noexcept;
+
+    //*************************************************************************************
+    // Getters
+    //*************************************************************************************
+
+    /**
+     *  Check if received events contain an event.
+     *
+     *  \param u32_Events The received events.
+     *  \param e_Event The event to check.
+     *
+     *  \return true if contained, false if not.
+     */
+
+    static inline bool GetEvent(MRH_Uint32 u32_Events, Event e_Event) noexcept
+    {
+        return (u32_Events & (1u << e_Event)) != 0;
+    }
+
+private:
+
+    //*************************************************************************************
+    // Close
+    //*************************************************************************************
+
+    /**
+     *  Close all file descriptors.
+     */
+
+    void Close() noexcept;
+
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+
+    int i_EpollFD;
+    int i_EventFD;
+    int i_SignalFD;
+
+    // @NOTE: The event file descriptor is only written if no event was
+    //        pending for the channel, the waiting thread is woken once for 
+    //        all merged events
+    std::vector<std::atomic<MRH_Uint32>> v_Pending;
+
+protected:
+
+};
+
+#endif /* EventQueue_h */
@@ -0,0 +1,153 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+#include <mutex>
+#include <map>
+#include <chrono>
+
+// External
+
+// Project
+#include "./GoogleCloudChannel.h"
+#include "../Logger.h"
+#include "../Exception.h"
+
+// Pre-defined
+#ifndef GOOGLE_CLOUD_KEEPALIVE_TIME_MS
+    #define GOOGLE_CLOUD_KEEPALIVE_TIME_MS 30000
+#endif
+#ifndef GOOGLE_CLOUD_KEEPALIVE_TIMEOUT_MS
+    #define GOOGLE_CLOUD_KEEPALIVE_TIMEOUT_MS 10000
+#endif
+#ifndef GOOGLE_CLOUD_RECONNECT_BACKOFF_MIN_MS
+    #define GOOGLE_CLOUD_RECONNECT_BACKOFF_MIN_MS 250
+#endif
+#ifndef GOOGLE_CLOUD_RECONNECT_BACKOFF_MAX_MS
+    #define GOOGLE_CLOUD_RECONNECT_BACKOFF_MAX_MS 10000
+#endif
+
+// Namespace
+namespace
+{
+    std::mutex c_Mutex;
+    std::shared_ptr<grpc::ChannelCredentials> p_Credentials;
+    std::map<std::string, std::shared_ptr<grpc::Channel>> m_Channel;
+    std::map<std::string, std::string> m_StandIn;
+}
+
+
+//*************************************************************************************
+// Channel
+//*************************************************************************************
+
+std::shared_ptr<grpc::Channel> GoogleCloudChannel::GetChannel(std::string const& s_Target)
+{
+    std::lock_guard<std::mutex> c_Guard(c_Mutex);
+
+    auto Channel = m_Channel.find(s_Target);
+
+    if (Channel != m_Channel.end())
+    {
+        return Channel->second;
+    }
+
+    std::string s_Address = s_Target;
+    std::shared_ptr<grpc::ChannelCredentials> p_TargetCredentials;
+    auto StandIn = m_StandIn.find(s_Target);
+
+    if (StandIn != m_StandIn.end())
+    {
+        // Local stand-in servers need no credentials
+        s_Address = StandIn->second;
+        p_TargetCredentials = grpc::InsecureChannelCredentials();
+    }
+    else
+    {
+        // Credentials are loaded once and shared by all endpoints
+        if (p_Credentials == NULL)
+        {
+            p_Credentials = grpc::GoogleDefaultCredentials();
+
+            if (p_Credentials == NULL)
+            {
+                throw Exception("Failed to load Google Cloud default credentials!");
+            }
+        }
+
+        p_TargetCredentials = p_Credentials;
+    }
+
+    // Detect dead connections during calls and reconnect quickly after failures
+    // @NOTE: No pings are sent without active calls, Google front ends close
+    //        connections pinged while idle with GOAWAY too_many_pings. Idle
+    //        connections closed by the server reconnect with the backoff below
+    grpc::ChannelArguments c_Arguments;
+    c_Arguments.SetInt(GRPC_ARG_KEEPALIVE_TIME_MS, GOOGLE_CLOUD_KEEPALIVE_TIME_MS);
+    c_Arguments.SetInt(GRPC_ARG_KEEPALIVE_TIMEOUT_MS, GOOGLE_CLOUD_KEEPALIVE_TIMEOUT_MS);
+    c_Arguments.SetInt(GRPC_ARG_KEEPALIVE_PERMIT_WITHOUT_CALLS, 0);
+    c_Arguments.SetInt(GRPC_ARG_INITIAL_RECONNECT_BACKOFF_MS, GOOGLE_CLOUD_RECONNECT_BACKOFF_MIN_MS);
+    c_Arguments.SetInt(GRPC_ARG_MIN_RECONNECT_BACKOFF_MS, GOOGLE_CLOUD_RECONNECT_BACKOFF_MIN_MS);
+    c_Arguments.SetInt(GRPC_ARG_MAX_RECONNECT_BACKOFF_MS, GOOGLE_CLOUD_RECONNECT_BACKOFF_MAX_MS);
+
+    std::shared_ptr<grpc::Channel> p_Channel = grpc::CreateCustomChannel(s_Address,
+                                                                         p_TargetCredentials,
+                                                                         c_Arguments);
+    m_Channel.insert(std::make_pair(s_Target, p_Channel));
+
+    MRH_LOG_INFO("Created Google Cloud API channel for {} ({}).", s_Target, s_Address);
+
+    return p_Channel;
+}
+
+bool GoogleCloudChannel::Warm(std::shared_ptr<grpc::Channel> const& p_Channel, MRH_Uint32 u32_TimeoutMS) noexcept
+{
+    // @NOTE: Resolving, TCP and TLS handshakes happen here instead of
+    //        during the first request
+    auto c_Deadline = std::chrono::system_clock::now() + std::chrono::milliseconds(u32_TimeoutMS);
+
+    if (p_Channel->WaitForConnected(c_Deadline) == false)
+    {
+        MRH_LOG_WARNING("Google Cloud API channel not connected after {} ms, connecting on first request.",
+                        u32_TimeoutMS);
+        return false;
+    }
+
+    return true;
+}
+
+void GoogleCloudChannel::SetStandIn(std::string const& s_Target, std::string const& s_Address)
+{
+    std::lock_guard<std::mutex> c_Guard(c_Mutex);
+
+    m_StandIn[s_Target] = s_Address;
+
+    MRH_LOG_WARNING("Google Cloud API endpoint {} replaced by stand-in server {}.", s_Target, s_Address);
+}
+
+//*************************************************************************************
+// Context
+//*************************************************************************************
+
+void GoogleCloudChannel::SetDeadline(grpc::ClientContext& c_Context, MRH_Uint32 u32_DeadlineMS) noexcept
+{
+    if (u32_DeadlineMS == 0)
+    {
+        return;
+    }
+
+    c_Context.set_deadline(std::chrono::system_clock::now() + std::chrono::milliseconds(u32_DeadlineMS));
+}
@@ -0,0 +1,86 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef GoogleCloudChannel_h
+#define GoogleCloudChannel_h
+
+// C / C++
+#include <memory>
+#include <string>
+
+// External
+#include <grpcpp/grpcpp.h>
+#include <MRH_Typedefs.h>
+
+// Project
+
+
+namespace GoogleCloudChannel
+{
+    //*************************************************************************************
+    // Channel
+    //*************************************************************************************
+
+    /**
+     *  Get the shared channel for a Google Cloud API endpoint. The channel is
+     *  created on first use with the default credentials, keepalive for active
+     *  calls and reconnect settings and reused afterwards. This function is 
+     *  thread safe.
+     *
+     *  \param s_Target The endpoint to connect to.
+     *
+     *  \return The shared endpoint channel.
+     */
+
+    std::shared_ptr<grpc::Channel> GetChannel(std::string const& s_Target);
+
+    /**
+     *  Connect a channel ahead of the first request.
+     *
+     *  \param p_Channel The channel to connect.
+     *  \param u32_TimeoutMS The time to wait for the connection in milliseconds.
+     *
+     *  \return true if connected, false if not.
+     */
+
+    bool Warm(std::shared_ptr<grpc::Channel> const& p_Channel, MRH_Uint32 u32_TimeoutMS) noexcept;
+
+    /**
+     *  Connect a endpoint to a local stand-in server instead. Stand-in channels
+     *  use no credentials and no TLS. Has to be set before the endpoint channel is 
+     *  first used. This function is thread safe.
+     *
+     *  \param s_Target The endpoint to replace.
+     *  \param s_Address The address of the stand-in server.
+     */
+
+    void SetStandIn(std::string const& s_Target, std::string const& s_Address);
+
+    //*************************************************************************************
+    // Context
+    //*************************************************************************************
+
+    /**
+     *  Set the deadline for a call.
+     *
+     *  \param c_Context The call context to set the deadline for.
+     *  \param u32_DeadlineMS The deadline in milliseconds from now. 0 sets no deadline.
+     */
+
+    void SetDeadline(grpc::ClientContext& c_Context, MRH_Uint32 u32_DeadlineMS) noexcept;
+};
+
+#endif /* GoogleCloudChannel_h */
@@ -0,0 +1,238 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+#include <chrono>
+#include <cmath>
+
+// External
+
+// Project
+#include "./Latency.h"
+#include "./Logger.h"
+
+// Namespace
+namespace
+{
+    const char* p_StageName[Latency::STAGE_COUNT] =
+    {
+        // Input
+        "Speech End -> Wake",
+        "Feed Audio",
+        "STT Finish",
+        "Stream Write",
+        "Speech End -> Written",
+
+        // Output
+        "Message Read -> Wake",
+        "Synthesize",
+        "Message Read -> First Audio"
+    };
+}
+
+
+//*************************************************************************************
+// Constructor / Destructor
+//*************************************************************************************
+
+Latency::Latency() noexcept
+{
+    for (size_t i = 0; i < STAGE_COUNT; ++i)
+    {
+        for (size_t j = 0; j < MRH_LATENCY_BUCKET_COUNT; ++j)
+        {
+            p_Histogram[i].p_Bucket[j] = 0;
+        }
+
+        p_Histogram[i].u64_Count = 0;
+        p_Histogram[i].u64_Max = 0;
+    }
+}
+
+Latency::~Latency() noexcept
+{}
+
+Latency::Marks::Marks() noexcept
+{
+    for (size_t i = 0; i < MARK_COUNT; ++i)
+    {
+        p_Mark[i] = 0;
+    }
+}
+
+//*************************************************************************************
+// Singleton
+//*************************************************************************************
+
+Latency& Latency::Singleton() noexcept
+{
+    static Latency s_Latency;
+    return s_Latency;
+}
+
+//*************************************************************************************
+// Time
+//*************************************************************************************
+
+MRH_Uint64 Latency::GetTime() noexcept
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//*************************************************************************************
+// Mark
+//*************************************************************************************
+
+void Latency::Marks::Set(Mark e_Mark) noexcept
+{
+    Set(e_Mark, GetTime());
+}
+
+void Latency::Marks::Set(Mark e_Mark, MRH_Uint64 u64_Time) noexcept
+{
+    p_Mark[e_Mark].store(u64_Time, std::memory_order_relaxed);
+}
+
+MRH_Uint64 Latency::Marks::Take(Mark e_Mark) noexcept
+{
+    return p_Mark[e_Mark].exchange(0, std::memory_order_relaxed);
+}
+
+//*************************************************************************************
+// Add
+//*************************************************************************************
+
+void Latency::Add(Stage e_Stage, MRH_Uint64 u64_Start, MRH_Uint64 u64_End) noexcept
+{
+    if (u64_Start == 0 || u64_End < u64_Start)
+    {
+        return;
+    }
+
+    Histogram& c_Histogram = p_Histogram[e_Stage];
+    MRH_Uint64 u64_US = u64_End - u64_Start;
+
+    c_Histogram.p_Bucket[GetBucket(u64_US)].fetch_add(1, std::memory_order_relaxed);
+    c_Histogram.u64_Count.fetch_add(1, std::memory_order_relaxed);
+
+    MRH_Uint64 u64_Max = c_Histogram.u64_Max.load(std::memory_order_relaxed);
+
+    while (u64_Max < u64_US && c_Histogram.u64_Max.compare_exchange_weak(u64_Max, u64_US, std::memory_order_relaxed) == false)
+    {}
+}
+
+void Latency::Complete(Marks& c_Marks, Mark e_Mark, Stage e_Stage) noexcept
+{
+    MRH_Uint64 u64_Start = c_Marks.Take(e_Mark);
+
+    if (u64_Start != 0)
+    {
+        Add(e_Stage, u64_Start, GetTime());
+    }
+}
+
+//*************************************************************************************
+// Buckets
+//*************************************************************************************
+
+size_t Latency::GetBucket(MRH_Uint64 u64_US) noexcept
+{
+    // @NOTE: Log-linear buckets, each power of two is split into sub buckets
+    //        which keeps the error below 1 / MRH_LATENCY_SUB_BUCKET_COUNT
+    if (u64_US < MRH_LATENCY_SUB_BUCKET_COUNT)
+    {
+        return static_cast<size_t>(u64_US);
+    }
+    else if (u64_US >= (1ULL << MRH_LATENCY_MAX_BITS))
+    {
+        return MRH_LATENCY_BUCKET_COUNT - 1;
+    }
+
+    size_t us_Exponent = 63 - __builtin_clzll(u64_US);
+    size_t us_Shift = us_Exponent - MRH_LATENCY_SUB_BUCKET_BITS;
+    size_t us_Sub = static_cast<size_t>(u64_US >> us_Shift) & (MRH_LATENCY_SUB_BUCKET_COUNT - 1);
+
+    return ((us_Shift + 1) * MRH_LATENCY_SUB_BUCKET_COUNT) + us_Sub;
+}
+
+MRH_Uint64 Latency::GetBucketLimit(size_t us_Bucket) noexcept
+{
+    if (us_Bucket < MRH_LATENCY_SUB_BUCKET_COUNT)
+    {
+        return us_Bucket;
+    }
+
+    size_t us_Shift = (us_Bucket / MRH_LATENCY_SUB_BUCKET_COUNT) - 1;
+    MRH_Uint64 u64_Sub = MRH_LATENCY_SUB_BUCKET_COUNT + (us_Bucket % MRH_LATENCY_SUB_BUCKET_COUNT);
+
+    return ((u64_Sub + 1) << us_Shift) - 1;
+}
+
+MRH_Uint64 Latency::GetPercentile(Histogram const& c_Histogram, MRH_Uint64 u64_Count, MRH_Sfloat64 f64_Percentile) noexcept
+{
+    MRH_Uint64 u64_Rank = static_cast<MRH_Uint64>(std::ceil(u64_Count * f64_Percentile));
+    MRH_Uint64 u64_Max = c_Histogram.u64_Max.load(std::memory_order_relaxed);
+    MRH_Uint64 u64_Seen = 0;
+
+    if (u64_Rank == 0)
+    {
+        u64_Rank = 1;
+    }
+
+    for (size_t i = 0; i < MRH_LATENCY_BUCKET_COUNT; ++i)
+    {
+        u64_Seen += c_Histogram.p_Bucket[i].load(std::memory_order_relaxed);
+
+        if (u64_Seen >= u64_Rank)
+        {
+            // The bucket limit can exceed the largest measured duration
+            MRH_Uint64 u64_Limit = GetBucketLimit(i);
+            return u64_Limit < u64_Max ? u64_Limit : u64_Max;
+        }
+    }
+
+    // Counts changed while reading
+    return u64_Max;
+}
+
+//*************************************************************************************
+// Dump
+//*************************************************************************************
+
+void Latency::Dump() noexcept
+{
+    MRH_LOG_INFO("Latency statistics (microseconds):");
+
+    for (size_t i = 0; i < STAGE_COUNT; ++i)
+    {
+        Histogram const& c_Histogram = p_Histogram[i];
+        MRH_Uint64 u64_Count = c_Histogram.u64_Count.load(std::memory_order_relaxed);
+
+        if (u64_Count == 0)
+        {
+            MRH_LOG_INFO("{}: No samples.", p_StageName[i]);
+            continue;
+        }
+
+        MRH_LOG_INFO("{}: Count {}, p50 {}, p95 {}, p99 {}, Max {}",
+                     p_StageName[i],
+                     u64_Count,
+                     GetPercentile(c_Histogram, u64_Count, 0.5),
+                     GetPercentile(c_Histogram, u64_Count, 0.95),
+                     GetPercentile(c_Histogram, u64_Count, 0.99),
+                     c_Histogram.u64_Max.load(std::memory_order_relaxed));
+    }
+}
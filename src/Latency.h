@@ -0,0 +1,271 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef Latency_h
+#define Latency_h
+
+// C / C++
+#include <atomic>
+
+// External
+#include <MRH_Typedefs.h>
+
+// Project
+
+// Pre-defined
+#define MRH_LATENCY_SUB_BUCKET_BITS 3
+#define MRH_LATENCY_SUB_BUCKET_COUNT (1 << MRH_LATENCY_SUB_BUCKET_BITS)
+#define MRH_LATENCY_MAX_BITS 40 // ~12 days in microseconds
+#define MRH_LATENCY_BUCKET_COUNT ((MRH_LATENCY_MAX_BITS - MRH_LATENCY_SUB_BUCKET_BITS + 1) * MRH_LATENCY_SUB_BUCKET_COUNT)
+
+
+class Latency
+{
+public:
+
+    //*************************************************************************************
+    // Types
+    //*************************************************************************************
+
+    typedef enum
+    {
+        // Input
+        STAGE_SPEECH_END_WAKE = 0,
+        STAGE_FEED_AUDIO = 1,
+        STAGE_STT_FINISH = 2,
+        STAGE_STREAM_WRITE = 3,
+        STAGE_SPEECH_END_WRITTEN = 4,
+
+        // Output
+        STAGE_MESSAGE_WAKE = 5,
+        STAGE_SYNTHESIZE = 6,
+        STAGE_MESSAGE_FIRST_AUDIO = 7,
+
+        // Bounds
+        STAGE_MAX = STAGE_MESSAGE_FIRST_AUDIO,
+
+        STAGE_COUNT = STAGE_MAX + 1
+
+    }Stage;
+
+    typedef enum
+    {
+        MARK_SPEECH_END = 0,
+        MARK_MESSAGE_READ = 1,
+        MARK_MESSAGE_PLAYBACK = 2, // Message read time, taken by the first played frame
+
+        // Bounds
+        MARK_MAX = MARK_MESSAGE_PLAYBACK,
+
+        MARK_COUNT = MARK_MAX + 1
+
+    }Mark;
+
+    class Marks
+    {
+    public:
+
+        //*************************************************************************************
+        // Constructor
+        //*************************************************************************************
+
+        /**
+         *  Default constructor.
+         */
+
+        Marks() noexcept;
+
+        //*************************************************************************************
+        // Mark
+        //*************************************************************************************
+
+        /**
+         *  Set a mark to the current time. This function is lock free and can be
+         *  called from audio callbacks.
+         *
+         *  \param e_Mark The mark to set.
+         */
+
+        void Set(Mark e_Mark) noexcept;
+
+        /**
+         *  Set a mark to a given time. This function is lock free.
+         *
+         *  \param e_Mark The mark to set.
+         *  \param u64_Time The mark time in microseconds.
+         */
+
+        void Set(Mark e_Mark, MRH_Uint64 u64_Time) noexcept;
+
+        /**
+         *  Take a mark, clearing it. This function is lock free.
+         *
+         *  \param e_Mark The mark to take.
+         *
+         *  \return The mark time in microseconds, 0 if not set.
+         */
+
+        MRH_Uint64 Take(Mark e_Mark) noexcept;
+
+    private:
+
+        //*************************************************************************************
+        // Data
+        //*************************************************************************************
+
+        std::atomic<MRH_Uint64> p_Mark[MARK_COUNT];
+
+    protected:
+
+    };
+
+    //*************************************************************************************
+    // Singleton
+    //*************************************************************************************
+
+    /**
+     *  Get the class instance. This function is thread safe.
+     *
+     *  \return The class instance.
+     */
+
+    static Latency& Singleton() noexcept;
+
+    //*************************************************************************************
+    // Time
+    //*************************************************************************************
+
+    /**
+     *  Get the current monotonic time.
+     *
+     *  \return The time in microseconds.
+     */
+
+    static MRH_Uint64 GetTime() noexcept;
+
+    //*************************************************************************************
+    // Add
+    //*************************************************************************************
+
+    /**
+     *  Add a stage duration. This function is lock free and can be called
+     *  from audio callbacks.
+     *
+     *  \param e_Stage The stage to add to.
+     *  \param u64_Start The stage start time in microseconds. 0 is ignored.
+     *  \param u64_End The stage end time in microseconds.
+     */
+
+    void Add(Stage e_Stage, MRH_Uint64 u64_Start, MRH_Uint64 u64_End) noexcept;
+
+    /**
+     *  Take a mark and add the duration up to the current time. This function 
+     *  is lock free and can be called from audio callbacks.
+     *
+     *  \param c_Marks The marks to take from.
+     *  \param e_Mark The mark to take.
+     *  \param e_Stage The stage to add to.
+     */
+
+    void Complete(Marks& c_Marks, Mark e_Mark, Stage e_Stage) noexcept;
+
+    //*************************************************************************************
+    // Dump
+    //*************************************************************************************
+
+    /**
+     *  Log the latency percentiles for all stages.
+     */
+
+    void Dump() noexcept;
+
+private:
+
+    //*************************************************************************************
+    // Types
+    //*************************************************************************************
+
+    struct Histogram
+    {
+        std::atomic<MRH_Uint64> p_Bucket[MRH_LATENCY_BUCKET_COUNT];
+        std::atomic<MRH_Uint64> u64_Count;
+        std::atomic<MRH_Uint64> u64_Max;
+    };
+
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+
+    /**
+     *  Default constructor.
+     */
+
+    Latency() noexcept;
+
+    /**
+     *  Default destructor.
+     */
+
+    ~Latency() noexcept;
+
+    //*************************************************************************************
+    // Buckets
+    //*************************************************************************************
+
+    /**
+     *  Get the bucket for a duration.
+     *
+     *  \param u64_US The duration in microseconds.
+     *
+     *  \return The bucket index.
+     */
+
+    static size_t GetBucket(MRH_Uint64 u64_US) noexcept;
+
+    /**
+     *  Get the largest duration of a bucket.
+     *
+     *  \param us_Bucket The bucket index.
+     *
+     *  \return The duration in microseconds.
+     */
+
+    static MRH_Uint64 GetBucketLimit(size_t us_Bucket) noexcept;
+
+    /**
+     *  Get a percentile of a stage.
+     *
+     *  \param c_Histogram The stage histogram.
+     *  \param u64_Count The stage count.
+     *  \param f64_Percentile The percentile to get, from 0 to 1.
+     *
+     *  \return The percentile duration in microseconds.
+     */
+
+    static MRH_Uint64 GetPercentile(Histogram const& c_Histogram, MRH_Uint64 u64_Count, MRH_Sfloat64 f64_Percentile) noexcept;
+
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+
+    // @NOTE: Marks belong to a session, only the histograms are shared
+    Histogram p_Histogram[STAGE_COUNT];
+
+protected:
+
+};
+
+#endif /* Latency_h */
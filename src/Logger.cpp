@@ -17,11 +17,13 @@
 // C / C++
 #include <execinfo.h>
 #include <unistd.h>
+#include <vector>
 
 // External
 #include <spdlog/spdlog.h>
+#include <spdlog/async.h>
 #include <spdlog/sinks/rotating_file_sink.h>
-#include "spdlog/sinks/stdout_color_sinks.h"
+#include <spdlog/sinks/stdout_color_sinks.h>
 
 // Project
 #include "./Logger.h"
@@ -33,10 +35,32 @@
 #ifndef MRH_LOGGER_PRINT_CLI
     #define MRH_LOGGER_PRINT_CLI 0
 #endif
-#define MRH_LOGGER_NAME_FILE "File"
-#define MRH_LOGGER_NAME_CONSOLE "Console"
+#ifndef MRH_LOGGER_QUEUE_SIZE
+    #define MRH_LOGGER_QUEUE_SIZE 8192 // Messages waiting to be written
+#endif
+#define MRH_LOGGER_NAME "mrhspeechd"
+#define MRH_LOGGER_NAME_BACKTRACE "Backtrace"
 #define MRH_LOGGER_MAX_SIZE_B 1048576 * 5
 #define MRH_LOGGER_MAX_FILES 3
+#define MRH_LOGGER_FLUSH_S 1
+
+// Namespace
+namespace
+{
+    inline spdlog::level::level_enum GetLevel(Logger::LogLevel e_Level) noexcept
+    {
+        switch (e_Level)
+        {
+            case Logger::WARNING:
+                return spdlog::level::warn;
+            case Logger::ERROR:
+                return spdlog::level::err;
+
+            default:
+                return spdlog::level::info;
+        }
+    }
+}
 
 
 //*************************************************************************************
@@ -45,27 +69,49 @@
 
 Logger::Logger() noexcept
 {
-    // Create loggers
-    auto FileLogger = spdlog::rotating_logger_mt(MRH_LOGGER_NAME_FILE,
-                                                 MRH_SPEECHD_LOG_FILE_PATH,
-                                                 MRH_LOGGER_MAX_SIZE_B,
-                                                 MRH_LOGGER_MAX_FILES);
+    // Create sinks, shared by all loggers
+    std::vector<spdlog::sink_ptr> v_Sink;
+    
+    v_Sink.emplace_back(std::make_shared<spdlog::sinks::rotating_file_sink_mt>(MRH_SPEECHD_LOG_FILE_PATH,
+                                                                              MRH_LOGGER_MAX_SIZE_B,
+                                                                              MRH_LOGGER_MAX_FILES));
 #if MRH_LOGGER_PRINT_CLI > 0
-    auto ConsoleLogger = spdlog::stdout_color_mt(MRH_LOGGER_NAME_CONSOLE);
+    v_Sink.emplace_back(std::make_shared<spdlog::sinks::stdout_color_sink_mt>());
 #endif
     
-    // Update pattern
-    spdlog::set_pattern("[%c] [%l] [Thread %t] %v");
+    // @NOTE: Messages are written by a single background thread. A full 
+    //        queue drops the oldest messages instead of blocking the caller
+    spdlog::init_thread_pool(MRH_LOGGER_QUEUE_SIZE, 1);
+    
+    p_Logger = std::make_shared<spdlog::async_logger>(MRH_LOGGER_NAME,
+                                                      v_Sink.begin(),
+                                                      v_Sink.end(),
+                                                      spdlog::thread_pool(),
+                                                      spdlog::async_overflow_policy::overrun_oldest);
+    p_Logger->set_level(static_cast<spdlog::level::level_enum>(spdlog::level::info + MRH_SPEECHD_LOG_LEVEL));
+    
+    // Crashes exit right after the backtrace, written without the queue
+    p_Backtrace = std::make_shared<spdlog::logger>(MRH_LOGGER_NAME_BACKTRACE,
+                                                   v_Sink.begin(),
+                                                   v_Sink.end());
+    
+    // @NOTE: The pattern is set on the sinks, used by both loggers
+    p_Logger->set_pattern("[%c] [%l] [Thread %t] [%s (%#)]: %v");
     
     // Set as default
-    spdlog::set_default_logger(FileLogger);
+    spdlog::set_default_logger(p_Logger);
     
-    // Write all starting at info
-    spdlog::flush_on(spdlog::level::info);
+    // Write problems immediately, everything else periodically
+    p_Logger->flush_on(spdlog::level::warn);
+    spdlog::flush_every(std::chrono::seconds(MRH_LOGGER_FLUSH_S));
 }
 
 Logger::~Logger() noexcept
-{}
+{
+    // Write all queued messages
+    p_Logger->flush();
+    spdlog::shutdown();
+}
 
 //*************************************************************************************
 // Singleton
@@ -81,44 +127,19 @@ Logger& Logger::Singleton() noexcept
 // Log
 //*************************************************************************************
 
-void Logger::Log(LogLevel e_Level, std::string const& s_Message, std::string const& s_File, size_t us_Line) noexcept
+void Logger::Log(LogLevel e_Level, std::string const& s_Message, const char* p_File, size_t us_Line) noexcept
 {
-    // Create log string
-    std::string s_Line = "[";
-    s_Line += s_File;
-    s_Line += " (";
-    s_Line += std::to_string(us_Line);
-    s_Line += ")]: ";
-    s_Line += s_Message;
-    
-    // Got our message, now log
-    Log(e_Level, s_Line);
+    p_Logger->log(spdlog::source_loc{ p_File, static_cast<int>(us_Line), "" },
+                  GetLevel(e_Level),
+                  spdlog::string_view_t(s_Message));
 }
 
-void Logger::Log(LogLevel e_Level, std::string const& s_Message) noexcept
+void Logger::LogBacktrace(std::string const& s_Message) noexcept
 {
-    switch (e_Level)
-    {
-        case WARNING:
-            spdlog::get(MRH_LOGGER_NAME_FILE)->warn(s_Message);
-#if MRH_LOGGER_PRINT_CLI > 0
-            spdlog::get(MRH_LOGGER_NAME_CONSOLE)->warn(s_Message);
-#endif
-            break;
-        case ERROR:
-            spdlog::get(MRH_LOGGER_NAME_FILE)->error(s_Message);
-#if MRH_LOGGER_PRINT_CLI > 0
-            spdlog::get(MRH_LOGGER_NAME_CONSOLE)->error(s_Message);
-#endif
-            break;
-            
-        default:
-            spdlog::get(MRH_LOGGER_NAME_FILE)->info(s_Message);
-#if MRH_LOGGER_PRINT_CLI > 0
-            spdlog::get(MRH_LOGGER_NAME_CONSOLE)->info(s_Message);
-#endif
-            break;
-    }
+    // @NOTE: Synchronous, queued messages might not be written before exit
+    p_Backtrace->log(spdlog::source_loc{ __FILE__, __LINE__, "" },
+                     spdlog::level::err,
+                     spdlog::string_view_t(s_Message));
 }
 
 //*************************************************************************************
@@ -140,16 +161,16 @@ void Logger::Backtrace(size_t us_TraceSize, std::string const& s_Message) noexce
     }
     
     // File head
-    Log(ERROR, "!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!");
-    Log(ERROR, "!!!");
-    Log(ERROR, "!!! " + s_Message);
-    Log(ERROR, "!!! ");
-    Log(ERROR, "!!! Backtrace (Size: " + std::to_string(us_TraceSize) + "):");
+    LogBacktrace("!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!");
+    LogBacktrace("!!!");
+    LogBacktrace("!!! " + s_Message);
+    LogBacktrace("!!! ");
+    LogBacktrace("!!! Backtrace (Size: " + std::to_string(us_TraceSize) + "):");
     
     // Print traceback stack
     if (us_TraceSize == 0)
     {
-        Log(ERROR, "!!! Failed to get backtrace!");
+        LogBacktrace("!!! Failed to get backtrace!");
     }
     else
     {
@@ -157,16 +178,27 @@ void Logger::Backtrace(size_t us_TraceSize, std::string const& s_Message) noexce
         {
             if (p_Traceback[i] != NULL)
             {
-                Log(ERROR, "!!! " + std::string(p_Traceback[i]));
+                LogBacktrace("!!! " + std::string(p_Traceback[i]));
             }
             else
             {
-                Log(ERROR, "!!! (null)");
+                LogBacktrace("!!! (null)");
             }
         }
     }
     
     // End
-    Log(ERROR, "!!!");
-    Log(ERROR, "!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!");
+    LogBacktrace("!!!");
+    LogBacktrace("!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!");
+    
+    p_Backtrace->flush();
+}
+
+//*************************************************************************************
+// Getters
+//*************************************************************************************
+
+spdlog::logger& Logger::GetLogger() noexcept
+{
+    return *p_Logger;
 }
@@ -19,11 +19,39 @@
 
 // C / C++
 #include <string>
+#include <memory>
 
 // External
+#include <spdlog/logger.h>
 
 // Project
 
+// Pre-defined
+#ifndef MRH_SPEECHD_LOG_LEVEL
+    #define MRH_SPEECHD_LOG_LEVEL 0 // Lowest compiled log level, 0 (INFO) to 3 (none)
+#endif
+
+// @NOTE: The format string and arguments are only formatted if the level
+//        is logged. Levels below MRH_SPEECHD_LOG_LEVEL are removed at 
+//        compile time, their arguments are never evaluated
+#define MRH_LOG(LEVEL, ...) Logger::Singleton().GetLogger().log(spdlog::source_loc{ __FILE__, __LINE__, "" }, LEVEL, __VA_ARGS__)
+
+#if MRH_SPEECHD_LOG_LEVEL <= 0
+    #define MRH_LOG_INFO(...) MRH_LOG(spdlog::level::info, __VA_ARGS__)
+#else
+    #define MRH_LOG_INFO(...) (void)0
+#endif
+#if MRH_SPEECHD_LOG_LEVEL <= 1
+    #define MRH_LOG_WARNING(...) MRH_LOG(spdlog::level::warn, __VA_ARGS__)
+#else
+    #define MRH_LOG_WARNING(...) (void)0
+#endif
+#if MRH_SPEECHD_LOG_LEVEL <= 2
+    #define MRH_LOG_ERROR(...) MRH_LOG(spdlog::level::err, __VA_ARGS__)
+#else
+    #define MRH_LOG_ERROR(...) (void)0
+#endif
+
 
 class Logger
 {
@@ -62,15 +90,17 @@ public:
     //*************************************************************************************
     
     /**
-     *  Log a message. This function is thread safe.
+     *  Log a message. Prefer the MRH_LOG_* macros, which only format logged 
+     *  messages. This function is thread safe.
      *
      *  \param e_Level The message log level.
      *  \param s_Message The message to log.
-     *  \param s_File The source file this log was created from.
+     *  \param p_File The source file this log was created from. Has to be a string 
+     *                literal, the message is written later.
      *  \param us_Line The source file line this log was created from.
      */
     
-    void Log(LogLevel e_Level, std::string const& s_Message, std::string const& s_File, size_t us_Line) noexcept;
+    void Log(LogLevel e_Level, std::string const& s_Message, const char* p_File, size_t us_Line) noexcept;
     
     //*************************************************************************************
     // Backtrace
@@ -85,6 +115,19 @@ public:
     
     void Backtrace(size_t us_TraceSize, std::string const& s_Message) noexcept;
     
+    //*************************************************************************************
+    // Getters
+    //*************************************************************************************
+    
+    /**
+     *  Get the asynchronous logger used by the MRH_LOG_* macros. This function is 
+     *  thread safe.
+     *
+     *  \return The logger.
+     */
+    
+    spdlog::logger& GetLogger() noexcept;
+    
 private:
     
     //*************************************************************************************
@@ -108,18 +151,20 @@ private:
     //*************************************************************************************
     
     /**
-     *  Log a message. This function is thread safe.
+     *  Log a backtrace message without the queue. This function is thread safe.
      *
-     *  \param e_Level The message log level.
      *  \param s_Message The message to log.
      */
     
-    void Log(LogLevel e_Level, std::string const& s_Message) noexcept;
+    void LogBacktrace(std::string const& s_Message) noexcept;
     
     //*************************************************************************************
     // Data
     //*************************************************************************************
     
+    std::shared_ptr<spdlog::logger> p_Logger; // Cached, no registry lookup per message
+    std::shared_ptr<spdlog::logger> p_Backtrace;
+    
 protected:
     
 };
@@ -16,11 +16,13 @@
 
 // C / C++
 #include <unistd.h>
+#include <pthread.h>
 #include <sys/stat.h>
 #include <csignal>
 #include <cstring>
 #include <fstream>
 #include <chrono>
+#include <vector>
 
 // External
 
@@ -28,9 +30,10 @@
 #include "./Audio/API/CreateAudioAPI.h"
 #include "./TTS/API/CreateTTSAPI.h"
 #include "./STT/API/CreateSTTAPI.h"
-#include "./Stream/UTF8Stream.h"
+#include "./Session/SessionManager.h"
 #include "./Logger.h"
-#include "./DataNotifier.h"
+#include "./Latency.h"
+#include "./EventQueue.h"
 #include "./Revision.h"
 
 // Pre-defined
@@ -45,15 +48,22 @@
 #endif
 #define MRH_SPEECHD_SIGNAL_START_RECORDING SIGUSR1
 #define MRH_SPEECHD_SIGNAL_STOP_AUDIO SIGUSR2
+#define MRH_SPEECHD_SIGNAL_DUMP_LATENCY SIGURG // No out-of-band socket data is used
 
 // Namespace
 namespace
 {
-    // Notifier
-    std::shared_ptr<DataNotifier> p_Notifier((DataNotifier*)NULL);
-
-    // Last signal
-    int i_LastSignal = -1;
+    // Signals received by the event queue
+    // @NOTE: These signals are blocked and never reach the signal handler
+    const std::vector<int> v_QueueSignal =
+    {
+        SIGTERM,
+        SIGINT,
+        SIGHUP,
+        MRH_SPEECHD_SIGNAL_START_RECORDING,
+        MRH_SPEECHD_SIGNAL_STOP_AUDIO,
+        MRH_SPEECHD_SIGNAL_DUMP_LATENCY
+    };
 }
 
 
@@ -77,23 +87,8 @@ extern "C"
                 _Exit(i_Signal);
                 break;
                 
-            case SIGTERM:
-            case SIGINT:
-            case SIGHUP:
-                i_LastSignal = i_Signal;
-                p_Notifier->Notify(true);
-                break;
-
-            case MRH_SPEECHD_SIGNAL_START_RECORDING:
-            case MRH_SPEECHD_SIGNAL_STOP_AUDIO:
-                i_LastSignal = i_Signal;
-                p_Notifier->Notify(false);
-                break;
-                
             default:
-                Logger::Singleton().Log(Logger::WARNING, "Caught signal: " + std::to_string(i_Signal),
-                                        "Main.cpp", __LINE__);
-                i_LastSignal = -1;
+                MRH_LOG_WARNING("Caught signal: {}", i_Signal);
                 break;
         }
     }
@@ -187,11 +182,27 @@ int main(int argc, const char* argv[])
     }
 #endif
 
+    // Block queue signals
+    // @NOTE: Blocked before the logger starts its threads, every thread inherits
+    //        the mask and the signals are only received by the event queue
+    sigset_t c_Set;
+    sigemptyset(&c_Set);
+
+    for (auto& Signal : v_QueueSignal)
+    {
+        sigaddset(&c_Set, Signal);
+    }
+
+    if (pthread_sigmask(SIG_BLOCK, &c_Set, NULL) != 0)
+    {
+        return EXIT_FAILURE;
+    }
+
     // Log Setup
-    Logger& c_Logger = Logger::Singleton();
-    c_Logger.Log(Logger::INFO, "=============================================", "Main.cpp", __LINE__);
-    c_Logger.Log(Logger::INFO, "= Started MRH Speech Daemon (" + std::string(VERSION_NUMBER) + ")", "Main.cpp", __LINE__);
-    c_Logger.Log(Logger::INFO, "=============================================", "Main.cpp", __LINE__);
+    Logger::Singleton();
+    MRH_LOG_INFO("=============================================");
+    MRH_LOG_INFO("= Started MRH Speech Daemon ({})", VERSION_NUMBER);
+    MRH_LOG_INFO("=============================================");
     
     // Install signal handlers
 #ifdef _NSIG
@@ -206,184 +217,132 @@ int main(int argc, const char* argv[])
     // Write current PID
     if (WritePID() == false)
     {
-        c_Logger.Log(Logger::ERROR, "Failed to write own process ID!", 
-                     "Main.cpp", __LINE__);
+        MRH_LOG_ERROR("Failed to write own process ID!");
         
         return EXIT_FAILURE;
     }
 
     // Create components
-    c_Logger.Log(Logger::INFO, "Creating components...",
-                 "Main.cpp", __LINE__);
+    MRH_LOG_INFO("Creating components...");
 
     Configuration c_Configuration(MRH_SPEECHD_CONFIGURATION_PATH);
 
-    std::shared_ptr<SpeechChecker> p_SpeechChecker;
-    std::shared_ptr<Recorder> p_Recorder;
-    std::shared_ptr<Player> p_Player;
+    std::shared_ptr<EventQueue> p_EventQueue;
     std::shared_ptr<TTS> p_TTS;
     std::shared_ptr<STT> p_STT;
-    std::shared_ptr<UTF8Stream> p_Stream;
+    std::shared_ptr<SessionManager> p_SessionManager;
 
     try
     {
+        // @NOTE: The queue signals are already blocked for all threads
+        p_EventQueue = std::make_shared<EventQueue>(v_QueueSignal,
+                                                    c_Configuration.v_Session.size());
+
         CreateAudioAPI::Init(c_Configuration);
         CreateTTSAPI::Init(c_Configuration);
         CreateTTSAPI::Init(c_Configuration);
 
-        p_Notifier = std::make_shared<DataNotifier>();
-        p_SpeechChecker = CreateAudioAPI::CreateSpeechChecker(c_Configuration);
-
-        std::shared_ptr<RecorderContext> p_RecorderContext = std::make_shared<RecorderContext>(p_Notifier,
-                                                                                               p_SpeechChecker);
-
-
-        p_Recorder = CreateAudioAPI::CreateRecorder(c_Configuration, p_RecorderContext);
-        p_Player = CreateAudioAPI::CreatePlayer(c_Configuration);
-
+        // @NOTE: The STT and TTS APIs and their caches are shared by all sessions
         p_TTS = CreateTTSAPI::CreateTTS(c_Configuration);
         p_STT = CreateSTTAPI::CreateSTT(c_Configuration);
 
-        p_Stream = std::make_shared<UTF8Stream>(c_Configuration.c_Service.s_SocketPath,
-                                                p_Notifier);
+        p_SessionManager = std::make_shared<SessionManager>(c_Configuration,
+                                                            p_EventQueue,
+                                                            p_STT,
+                                                            p_TTS);
     }
     catch (Exception& e)
     {
-        c_Logger.Log(Logger::ERROR, "Failed to create components: " +
-                                    e.what2(),
-                     "Main.cpp", __LINE__);
+        MRH_LOG_ERROR("Failed to create components: {}", e.what2());
 
         return EXIT_FAILURE;
     }
 
     // Handle audio
-    while (true)
+    Latency& c_Latency = Latency::Singleton();
+    std::vector<MRH_Uint32> v_Events;
+    std::vector<int> v_Signal;
+    bool b_Run = true;
+
+    while (b_Run == true)
     {
-        // Wait for notifications
-        p_Notifier->Wait();
+        // Wait for events and signals
+        p_EventQueue->Wait(v_Events, v_Signal);
+        MRH_Uint64 u64_Wake = Latency::GetTime();
 
-        c_Logger.Log(Logger::INFO, "Notified about new data!",
-                     "Main.cpp", __LINE__);
+        /**
+         *  Signals
+         */
 
-        // Stop?
-        if (i_LastSignal == SIGTERM)
+        // @NOTE: Signals are handled in the order they were received and
+        //        apply to all sessions
+        for (auto& Signal : v_Signal)
         {
-            c_Logger.Log(Logger::INFO, "Shutdown signal received!",
-                         "Main.cpp", __LINE__);
-            break;
-        }
+            switch (Signal)
+            {
+                case SIGTERM:
+                    MRH_LOG_INFO("Shutdown signal received!");
 
-        // Are we connected to the service
-        if (p_Stream->IsConnected() == false)
-        {
-            c_Logger.Log(Logger::INFO, "Not connected, stopping recording.",
-                         "Main.cpp", __LINE__);
+                    b_Run = false;
+                    break;
 
-            p_Recorder->Stop(); // No reason to record if we cannot send
-            continue;
-        }
+                case MRH_SPEECHD_SIGNAL_STOP_AUDIO:
+                    MRH_LOG_INFO("Audio stop signal received.");
 
-        // Is there somethning to play?
-        if (p_Stream->GetAvailable() == true)
-        {
-            try
-            {
-                c_Logger.Log(Logger::INFO, "Creating and starting output playback.",
-                             "Main.cpp", __LINE__);
+                    p_SessionManager->StopAudio();
+                    break;
 
-                AudioBuffer c_Buffer(0);
-                std::string s_String = p_Stream->GetMessage();
+                case MRH_SPEECHD_SIGNAL_START_RECORDING:
+                    MRH_LOG_INFO("Recording start signal received.");
 
-                p_TTS->Synthesize(s_String, c_Buffer);
+                    p_SessionManager->StartRecording();
+                    break;
 
-                // Start playback and stop recording
-                p_Player->Start(c_Buffer);
-                p_Recorder->Stop();
+                case MRH_SPEECHD_SIGNAL_DUMP_LATENCY:
+                    c_Latency.Dump();
+                    p_SessionManager->Dump();
+                    p_TTS->Dump();
+                    break;
+
+                default:
+                    MRH_LOG_INFO("Ignoring signal: {}", Signal);
+                    break;
             }
-            catch (Exception& e)
+
+            if (b_Run == false)
             {
-                c_Logger.Log(Logger::ERROR, "Failed to handle output: " +
-                                            e.what2(),
-                             "Main.cpp", __LINE__);
+                break;
             }
-
-            continue;
         }
-        
-        // Was a recording signal received?
-        if (i_LastSignal == MRH_SPEECHD_SIGNAL_STOP_AUDIO)
-        {
-            c_Logger.Log(Logger::INFO, "Audio stop signal received.",
-                         "Main.cpp", __LINE__);
 
-            p_Recorder->Stop();
-            p_Player->Stop();
+        v_Signal.clear();
 
-            i_LastSignal = -1;
-            continue;
-        }
-        else if (i_LastSignal == MRH_SPEECHD_SIGNAL_START_RECORDING)
+        if (b_Run == false)
         {
-            c_Logger.Log(Logger::INFO, "Recording start signal received.",
-                         "Main.cpp", __LINE__);
-
-            // Only works while not recording or playing!
-            if (p_Player->GetPlaying() == false && p_Recorder->GetRecording() == false)
-            {
-                try
-                {
-                    c_Logger.Log(Logger::INFO, "Starting to record.",
-                                 "Main.cpp", __LINE__);
-
-                    p_Recorder->Start(true);
-                }
-                catch (Exception& e)
-                {
-                    c_Logger.Log(Logger::ERROR, "Failed to start recording: " +
-                                                e.what2(),
-                                 "Main.cpp", __LINE__);
-                }
-            }
-
-            i_LastSignal = -1;
-            continue;
+            break;
         }
 
-        // Was audio recorded to transcribe?
-        // @NOTE: No playback check, finished recordings can be retrieved while playing!
-        if (p_Recorder->GetSpeechRecorded() == true && p_Recorder->GetRecording() == false)
-        {
-            try
-            {
-                c_Logger.Log(Logger::INFO, "Reading and creating input message.",
-                             "Main.cpp", __LINE__);
-
-                AudioBuffer c_Buffer(0);
-                std::string s_String("");
+        /**
+         *  Sessions
+         */
 
-                p_Recorder->GetRecordedAudio(c_Buffer);
-                p_STT->Transcribe(c_Buffer, s_String);
-                p_Stream->Write(s_String);
-            }
-            catch (Exception& e)
-            {
-                c_Logger.Log(Logger::ERROR, "Failed to handle input: " +
-                                            e.what2(),
-                             "Main.cpp", __LINE__);
-            }
-        }
+        p_SessionManager->Update(v_Events, u64_Wake);
     }
     
     // Finished
-    c_Logger.Log(Logger::INFO, "Exit, cleaning up...",
-                 "Main.cpp", __LINE__);
+    MRH_LOG_INFO("Exit, cleaning up...");
+
+    // Workers are joined before their APIs are destroyed
+    p_SessionManager->Dump();
+    p_SessionManager.reset();
+
+    c_Latency.Dump();
 
     CreateAudioAPI::Destroy(c_Configuration);
     CreateTTSAPI::Destroy(c_Configuration);
     CreateTTSAPI::Destroy(c_Configuration);
 
-    c_Logger.Log(Logger::INFO, "mrhspeechd finished.",
-                 "Main.cpp", __LINE__);
+    MRH_LOG_INFO("mrhspeechd finished.");
     
     return EXIT_SUCCESS;
 }
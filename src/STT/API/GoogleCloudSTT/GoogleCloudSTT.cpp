@@ -25,14 +25,18 @@
 
 // Project
 #include "./GoogleCloudSTT.h"
+#include "./GoogleCloudSTTStream.h"
+#include "./GoogleCloudSTTResult.h"
+#include "../../../GoogleCloud/GoogleCloudChannel.h"
 
 // Pre-defined
 #if GOOGLE_CLOUD_STT_LOG_EXTENDED > 0
-    #define GOOGLE_CLOUD_STT_LOG(X) Logger::Singleton().Log(Logger::INFO, X, "GoogleCloudSTT.cpp", __LINE__)
+    #define GOOGLE_CLOUD_STT_LOG(X) MRH_LOG_INFO("{}", X)
 #else
     #define GOOGLE_CLOUD_STT_LOG(X)
 #endif
 #define GOOGLE_CLOUD_STT_CHANNEL "speech.googleapis.com"
+#define GOOGLE_CLOUD_STT_WARM_TIMEOUT_MS 5000
 
 // Namespace
 using google::cloud::speech::v1::Speech;
@@ -47,7 +51,10 @@ using google::cloud::speech::v1::StreamingRecognitionResult;
 //*************************************************************************************
 
 GoogleCloudSTT::GoogleCloudSTT(Configuration::GoogleCloudSTT const& c_Configuration) : STT("Google Cloud API STT"),
-                                                                                       s_LanguageCode("")
+                                                                                       s_LanguageCode(""),
+                                                                                       u32_DeadlineMS(c_Configuration.u32_DeadlineMS),
+                                                                                       u32_MaxAlternatives(c_Configuration.u32_MaxAlternatives),
+                                                                                       b_WordTimeOffsets(c_Configuration.b_WordTimeOffsets)
 {
     std::string s_LocaleFilePath = MRH::VT::LocalisedPath::GetPath(c_Configuration.s_BCPDirPath, c_Configuration.s_BCPFileName);
     std::ifstream f_File(s_LocaleFilePath);
@@ -62,9 +69,20 @@ GoogleCloudSTT::GoogleCloudSTT(Configuration::GoogleCloudSTT const& c_Configurat
     getline(f_File, s_LanguageCode);
     f_File.close();
 
-    Logger::Singleton().Log(Logger::INFO, "Set Google Cloud API STT locale to " +
-                                          s_LanguageCode,
-                            "GoogleCloudSTT.cpp", __LINE__);
+    MRH_LOG_INFO("Set Google Cloud API STT locale to {}", s_LanguageCode);
+
+    /**
+     *  Credentials Setup
+     */
+
+    // @NOTE: Google speech api is accessed as shown here:
+    //        https://github.com/GoogleCloudPlatform/cpp-samples/blob/main/speech/api/transcribe.cc
+
+    // Setup the google connection once, requests reuse the connected channel
+    p_Channel = GoogleCloudChannel::GetChannel(GOOGLE_CLOUD_STT_CHANNEL);
+    p_Speech = Speech::NewStub(p_Channel);
+
+    GoogleCloudChannel::Warm(p_Channel, GOOGLE_CLOUD_STT_WARM_TIMEOUT_MS);
 }
 
 GoogleCloudSTT::~GoogleCloudSTT() noexcept
@@ -74,10 +92,9 @@ GoogleCloudSTT::~GoogleCloudSTT() noexcept
 // Transcribe
 //*************************************************************************************
 
-void GoogleCloudSTT::Transcribe(AudioBuffer& c_Buffer, std::string& s_String)
+void GoogleCloudSTT::Transcribe(AudioBuffer& c_Buffer, STTResult& c_Result)
 {
-    // Create full buffer
-    size_t us_SampleCount = PrepareAudio(c_Buffer);
+    size_t us_SampleCount = c_Buffer.GetSampleCount();
 
     if (us_SampleCount == 0)
     {
@@ -90,18 +107,6 @@ void GoogleCloudSTT::Transcribe(AudioBuffer& c_Buffer, std::string& s_String)
                          std::to_string(c_Buffer.GetKHz()) +
                          " KHz.");
 
-    /**
-     *  Credentials Setup
-     */
-
-    // @NOTE: Google speech api is accessed as shown here:
-    //        https://github.com/GoogleCloudPlatform/cpp-samples/blob/main/speech/api/transcribe.cc
-
-    // Setup google connection with credentials for this request
-    auto c_Credentials = grpc::GoogleDefaultCredentials();
-    auto c_CloudChannel = grpc::CreateChannel(GOOGLE_CLOUD_STT_CHANNEL, c_Credentials);
-    std::unique_ptr<Speech::Stub> p_Speech(Speech::NewStub(c_CloudChannel));
-
     /**
      *  Create Request
      */
@@ -116,16 +121,24 @@ void GoogleCloudSTT::Transcribe(AudioBuffer& c_Buffer, std::string& s_String)
     p_Config->set_encoding(RecognitionConfig::LINEAR16);
     p_Config->set_profanity_filter(true);
     p_Config->set_audio_channel_count(1); // Always mono
+    p_Config->set_max_alternatives(static_cast<int32_t>(u32_MaxAlternatives));
+    p_Config->set_enable_word_time_offsets(b_WordTimeOffsets);
 
     // Now add the audio
-    c_RecognizeRequest.mutable_audio()->set_content(v_Audio.data(),
-                                                    us_SampleCount * sizeof(MRH_Sint16)); // Byte len
+    // @NOTE: Written directly into the request bytes, sized once and copied 
+    //        exactly once from the recording
+    std::string* p_Content = c_RecognizeRequest.mutable_audio()->mutable_content();
+    p_Content->resize(us_SampleCount * sizeof(MRH_Sint16)); // Byte len
+
+    c_Buffer.RetrieveBytes(&((*p_Content)[0]), us_SampleCount);
 
     /**
      *  Transcribe
      */
 
     grpc::ClientContext c_Context;
+    GoogleCloudChannel::SetDeadline(c_Context, u32_DeadlineMS);
+
     RecognizeResponse c_RecognizeResponse;
     grpc::Status c_RPCStatus = p_Speech->Recognize(&c_Context,
                                                    c_RecognizeRequest,
@@ -141,28 +154,28 @@ void GoogleCloudSTT::Transcribe(AudioBuffer& c_Buffer, std::string& s_String)
      *  Select Transcribed
      */
 
-    // Check all results and grab highest confidence
-    float f32_Confidence = -1.f;
-    std::string s_Transcipt = "";
+    // Every result holds the next part of the utterance, the best 
+    // alternative of each is added to the transcript
+    c_Result.Clear();
 
     for (int i = 0; i < c_RecognizeResponse.results_size(); ++i)
     {
-        const auto& c_Result = c_RecognizeResponse.results(i);
-
-        for (int j = 0; j < c_Result.alternatives_size(); ++j)
-        {
-            const auto& c_Alternative = c_Result.alternatives(i);
-
-            if (f32_Confidence < c_Alternative.confidence())
-            {
-                f32_Confidence = c_Alternative.confidence();
-                s_Transcipt = c_Alternative.transcript();
-            }
-        }
+        GoogleCloudSTTResult::Add(c_Result, c_RecognizeResponse.results(i));
     }
 
-    s_String = s_Transcipt;
-
     GOOGLE_CLOUD_STT_LOG("Transcription result: " +
-                         s_String);
+                         c_Result.s_Transcript);
+}
+
+//*************************************************************************************
+// Stream
+//*************************************************************************************
+
+std::shared_ptr<STTStream> GoogleCloudSTT::BeginStream(MRH_Uint32 u32_KHz)
+{
+    return std::make_shared<GoogleCloudSTTStream>(p_Speech,
+                                                  s_LanguageCode,
+                                                  u32_MaxAlternatives,
+                                                  b_WordTimeOffsets,
+                                                  u32_KHz);
 }
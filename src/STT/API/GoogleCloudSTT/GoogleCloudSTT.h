@@ -18,8 +18,11 @@
 #define GoogleCloudSTT_h
 
 // C / C++
+#include <memory>
 
 // External
+#include <google/cloud/speech/v1/cloud_speech.grpc.pb.h>
+#include <grpcpp/grpcpp.h>
 
 // Project
 #include "../../STT.h"
@@ -53,13 +56,27 @@ public:
     //*************************************************************************************
 
     /**
-     *  Transcribe a string from a audio buffer.
+     *  Transcribe a audio buffer.
      *
      *  \param c_Buffer The audio buffer to transcribe. The buffer is emptied.
-     *  \param s_String The transcribed speech string.
+     *  \param c_Result The transcription result. The result is overwritten.
      */
 
-    void Transcribe(AudioBuffer& c_Buffer, std::string& s_String) override;
+    void Transcribe(AudioBuffer& c_Buffer, STTResult& c_Result) override;
+
+    //*************************************************************************************
+    // Stream
+    //*************************************************************************************
+
+    /**
+     *  Begin a StreamingRecognize transcription stream which is fed while recording.
+     *
+     *  \param u32_KHz The KHz of the audio fed to the stream.
+     *
+     *  \return The transcription stream.
+     */
+
+    std::shared_ptr<STTStream> BeginStream(MRH_Uint32 u32_KHz) override;
 
 private:
 
@@ -68,6 +85,13 @@ private:
     //*************************************************************************************
 
     std::string s_LanguageCode;
+    MRH_Uint32 u32_DeadlineMS;
+    MRH_Uint32 u32_MaxAlternatives;
+    bool b_WordTimeOffsets;
+
+    // @NOTE: Stubs are thread safe and shared with all requests and streams
+    std::shared_ptr<grpc::Channel> p_Channel;
+    std::shared_ptr<google::cloud::speech::v1::Speech::Stub> p_Speech;
 
 protected:
 
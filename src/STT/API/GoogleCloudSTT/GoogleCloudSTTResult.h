@@ -0,0 +1,125 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef GoogleCloudSTTResult_h
+#define GoogleCloudSTTResult_h
+
+// C / C++
+#include <algorithm>
+
+// External
+#include <google/cloud/speech/v1/cloud_speech.grpc.pb.h>
+
+// Project
+#include "../../STTResult.h"
+
+
+class GoogleCloudSTTResult
+{
+public:
+
+    //*************************************************************************************
+    // Add
+    //*************************************************************************************
+
+    /**
+     *  Add a recognition result as the next segment of a transcription result.
+     *
+     *  \param c_STTResult The transcription result to add to.
+     *  \param c_Result The recognition or streaming recognition result to add.
+     */
+
+    template<typename Result>
+    static void Add(STTResult& c_STTResult, Result const& c_Result)
+    {
+        int i_Count = c_Result.alternatives_size();
+
+        if (i_Count == 0)
+        {
+            return;
+        }
+
+        c_STTResult.v_Segment.emplace_back();
+        std::vector<STTResult::Alternative>& v_Alternative = c_STTResult.v_Segment.back().v_Alternative;
+
+        // Select the highest confidence, alternatives are ordered by likelihood
+        // @NOTE: Confidence is usually only set for the first alternative, 
+        //        equal confidences keep the earlier alternative
+        int i_Best = 0;
+
+        for (int j = 0; j < i_Count; ++j)
+        {
+            const auto& c_Alternative = c_Result.alternatives(j);
+
+            v_Alternative.push_back({ c_Alternative.transcript(), c_Alternative.confidence() });
+
+            if (c_Alternative.confidence() > c_Result.alternatives(i_Best).confidence())
+            {
+                i_Best = j;
+            }
+        }
+
+        std::rotate(v_Alternative.begin(), v_Alternative.begin() + i_Best, v_Alternative.begin() + i_Best + 1);
+
+        /**
+         *  Best Alternative
+         */
+
+        const auto& c_Best = c_Result.alternatives(i_Best);
+
+        c_STTResult.s_Transcript += c_Best.transcript();
+
+        // @NOTE: 0 is returned if the confidence is not set
+        if (c_Best.confidence() > 0.f && (c_STTResult.f32_Confidence < 0.f || c_Best.confidence() < c_STTResult.f32_Confidence))
+        {
+            c_STTResult.f32_Confidence = c_Best.confidence();
+        }
+
+        for (int j = 0; j < c_Best.words_size(); ++j)
+        {
+            const auto& c_Word = c_Best.words(j);
+
+            c_STTResult.v_Word.push_back({ c_Word.word(),
+                                           GetMS(c_Word.start_time()),
+                                           GetMS(c_Word.end_time()) });
+        }
+    }
+
+private:
+
+    //*************************************************************************************
+    // Time
+    //*************************************************************************************
+
+    /**
+     *  Get the milliseconds of a duration.
+     *
+     *  \param c_Duration The duration to convert.
+     *
+     *  \return The duration in milliseconds.
+     */
+
+    template<typename Duration>
+    static MRH_Uint32 GetMS(Duration const& c_Duration) noexcept
+    {
+        return static_cast<MRH_Uint32>((c_Duration.seconds() * 1000) + (c_Duration.nanos() / 1000000));
+    }
+
+protected:
+
+};
+
+#endif /* GoogleCloudSTTResult_h */
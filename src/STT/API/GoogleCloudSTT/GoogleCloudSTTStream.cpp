@@ -0,0 +1,188 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+
+// External
+
+// Project
+#include "./GoogleCloudSTTStream.h"
+#include "./GoogleCloudSTTResult.h"
+#include "../../../Logger.h"
+
+// Pre-defined
+#if GOOGLE_CLOUD_STT_LOG_EXTENDED > 0
+    #define GOOGLE_CLOUD_STT_LOG(X) MRH_LOG_INFO("{}", X)
+#else
+    #define GOOGLE_CLOUD_STT_LOG(X)
+#endif
+#define GOOGLE_CLOUD_STT_STREAM_REQUEST_SAMPLES 8192 // 16 KiB, below the recommended request size
+
+// Namespace
+using google::cloud::speech::v1::Speech;
+using google::cloud::speech::v1::RecognitionConfig;
+
+
+//*************************************************************************************
+// Constructor / Destructor
+//*************************************************************************************
+
+GoogleCloudSTTStream::GoogleCloudSTTStream(std::shared_ptr<Speech::Stub> const& p_Speech,
+                                           std::string const& s_LanguageCode,
+                                           MRH_Uint32 u32_MaxAlternatives,
+                                           bool b_WordTimeOffsets,
+                                           MRH_Uint32 u32_KHz) : p_Speech(p_Speech),
+                                                                 b_Finished(false)
+{
+    /**
+     *  Open Stream
+     */
+
+    // @NOTE: No deadline is set, the stream lasts as long as the recording
+    p_Streamer = p_Speech->StreamingRecognize(&c_Context);
+
+    // The first request only contains the recognition configuration
+    auto* p_StreamingConfig = c_Request.mutable_streaming_config();
+    p_StreamingConfig->set_interim_results(false);
+    p_StreamingConfig->set_single_utterance(false); // We detect the utterance end ourselves
+
+    auto* p_Config = p_StreamingConfig->mutable_config();
+    p_Config->set_language_code(s_LanguageCode);
+    p_Config->set_sample_rate_hertz(u32_KHz);
+    p_Config->set_encoding(RecognitionConfig::LINEAR16);
+    p_Config->set_profanity_filter(true);
+    p_Config->set_audio_channel_count(1); // Always mono
+    p_Config->set_max_alternatives(static_cast<int32_t>(u32_MaxAlternatives));
+    p_Config->set_enable_word_time_offsets(b_WordTimeOffsets);
+
+    if (p_Streamer->Write(c_Request) == false)
+    {
+        c_Context.TryCancel();
+        p_Streamer->Finish();
+
+        throw Exception("Failed to start transcription stream!");
+    }
+
+    c_Request.Clear();
+
+    GOOGLE_CLOUD_STT_LOG("Started transcription stream with " +
+                         std::to_string(u32_KHz) +
+                         " KHz.");
+}
+
+GoogleCloudSTTStream::~GoogleCloudSTTStream() noexcept
+{
+    if (b_Finished == true)
+    {
+        return;
+    }
+
+    // Abandoned stream, cancel and clean up
+    StreamingResponse c_Response;
+
+    c_Context.TryCancel();
+
+    while (p_Streamer->Read(&c_Response) == true)
+    {}
+
+    p_Streamer->Finish();
+}
+
+//*************************************************************************************
+// Stream
+//*************************************************************************************
+
+void GoogleCloudSTTStream::Feed(AudioBuffer& c_Buffer)
+{
+    if (b_Finished == true)
+    {
+        throw Exception("Transcription stream already finished!");
+    }
+
+    AudioBuffer::ConstRegion c_First;
+    AudioBuffer::ConstRegion c_Second;
+
+    c_Buffer.GetReadRegions(c_First, c_Second);
+
+    Write(c_First.p_Samples, c_First.us_Samples);
+    Write(c_Second.p_Samples, c_Second.us_Samples);
+
+    c_Buffer.Clear();
+}
+
+void GoogleCloudSTTStream::Write(const MRH_Sint16* p_Samples, size_t us_Samples)
+{
+    while (us_Samples > 0)
+    {
+        size_t us_Write = us_Samples;
+
+        if (us_Write > GOOGLE_CLOUD_STT_STREAM_REQUEST_SAMPLES)
+        {
+            us_Write = GOOGLE_CLOUD_STT_STREAM_REQUEST_SAMPLES;
+        }
+
+        c_Request.set_audio_content(p_Samples, us_Write * sizeof(MRH_Sint16)); // Byte len
+
+        if (p_Streamer->Write(c_Request) == false)
+        {
+            throw Exception("Failed to write to transcription stream!");
+        }
+
+        GOOGLE_CLOUD_STT_LOG("Streamed " +
+                             std::to_string(us_Write) +
+                             " samples.");
+
+        p_Samples += us_Write;
+        us_Samples -= us_Write;
+    }
+}
+
+void GoogleCloudSTTStream::Finish(STTResult& c_Result)
+{
+    if (b_Finished == true)
+    {
+        throw Exception("Transcription stream already finished!");
+    }
+
+    b_Finished = true;
+    p_Streamer->WritesDone();
+
+    // Every final result holds the next part of the utterance
+    StreamingResponse c_Response;
+    c_Result.Clear();
+
+    while (p_Streamer->Read(&c_Response) == true)
+    {
+        for (int i = 0; i < c_Response.results_size(); ++i)
+        {
+            if (c_Response.results(i).is_final() == true)
+            {
+                GoogleCloudSTTResult::Add(c_Result, c_Response.results(i));
+            }
+        }
+    }
+
+    grpc::Status c_RPCStatus = p_Streamer->Finish();
+
+    if (c_RPCStatus.ok() == false)
+    {
+        throw Exception("Failed to transcribe: GRPC streamer error: " +
+                        c_RPCStatus.error_message());
+    }
+
+    GOOGLE_CLOUD_STT_LOG("Transcription result: " +
+                         c_Result.s_Transcript);
+}
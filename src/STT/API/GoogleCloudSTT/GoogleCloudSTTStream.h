@@ -0,0 +1,118 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef GoogleCloudSTTStream_h
+#define GoogleCloudSTTStream_h
+
+// C / C++
+#include <memory>
+
+// External
+#include <google/cloud/speech/v1/cloud_speech.grpc.pb.h>
+#include <grpcpp/grpcpp.h>
+
+// Project
+#include "../../STTStream.h"
+
+
+class GoogleCloudSTTStream : public STTStream
+{
+public:
+
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+
+    /**
+     *  Default constructor.
+     *
+     *  \param p_Speech The shared speech stub to stream with.
+     *  \param s_LanguageCode The BCP-47 language code to transcribe with.
+     *  \param u32_MaxAlternatives The maximum number of alternatives for each result.
+     *  \param b_WordTimeOffsets If word time offsets should be returned.
+     *  \param u32_KHz The KHz of the audio fed to the stream.
+     */
+
+    GoogleCloudSTTStream(std::shared_ptr<google::cloud::speech::v1::Speech::Stub> const& p_Speech,
+                         std::string const& s_LanguageCode,
+                         MRH_Uint32 u32_MaxAlternatives,
+                         bool b_WordTimeOffsets,
+                         MRH_Uint32 u32_KHz);
+
+    /**
+     *  Default destructor.
+     */
+
+    ~GoogleCloudSTTStream() noexcept;
+
+    //*************************************************************************************
+    // Stream
+    //*************************************************************************************
+
+    /**
+     *  Feed recorded audio to the transcription stream.
+     *
+     *  \param c_Buffer The audio buffer to feed. The buffer is emptied.
+     */
+
+    void Feed(AudioBuffer& c_Buffer) override;
+
+    /**
+     *  Finish the transcription stream and get the transcription result.
+     *
+     *  \param c_Result The transcription result. The result is overwritten.
+     */
+
+    void Finish(STTResult& c_Result) override;
+
+private:
+
+    //*************************************************************************************
+    // Types
+    //*************************************************************************************
+
+    typedef google::cloud::speech::v1::StreamingRecognizeRequest StreamingRequest;
+    typedef google::cloud::speech::v1::StreamingRecognizeResponse StreamingResponse;
+
+    //*************************************************************************************
+    // Write
+    //*************************************************************************************
+
+    /**
+     *  Write audio samples to the stream.
+     *
+     *  \param p_Samples The samples to write.
+     *  \param us_Samples The amount of samples to write.
+     */
+
+    void Write(const MRH_Sint16* p_Samples, size_t us_Samples);
+
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+
+    std::shared_ptr<google::cloud::speech::v1::Speech::Stub> p_Speech;
+    grpc::ClientContext c_Context;
+    std::unique_ptr<grpc::ClientReaderWriterInterface<StreamingRequest, StreamingResponse>> p_Streamer;
+
+    StreamingRequest c_Request;
+    bool b_Finished;
+
+protected:
+
+};
+
+#endif /* GoogleCloudSTTStream_h */
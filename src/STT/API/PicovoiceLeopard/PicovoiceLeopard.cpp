@@ -25,7 +25,7 @@
 
 // Pre-defined
 #if PICOVOICE_LEOPARD_LOG_EXTENDED > 0
-    #define PICOVOICE_LEOPARD_LOG(X) Logger::Singleton().Log(Logger::INFO, X, "PicovoiceLeopards.cpp", __LINE__)
+    #define PICOVOICE_LEOPARD_LOG(X) MRH_LOG_INFO("{}", X)
 #else
     #define PICOVOICE_LEOPARD_LOG(X)
 #endif
@@ -80,7 +80,7 @@ PicovoiceLeopard::~PicovoiceLeopard() noexcept
 // Transcribe
 //*************************************************************************************
 
-void PicovoiceLeopard::Transcribe(AudioBuffer& c_Buffer, std::string& s_String)
+void PicovoiceLeopard::Transcribe(AudioBuffer& c_Buffer, STTResult& c_Result)
 {
     // Check audio
     if (c_Buffer.GetKHz() != pv_sample_rate())
@@ -91,7 +91,8 @@ void PicovoiceLeopard::Transcribe(AudioBuffer& c_Buffer, std::string& s_String)
     }
 
     // Create full buffer
-    size_t us_SampleCount = PrepareAudio(c_Buffer);
+    size_t us_SampleCount;
+    const MRH_Sint16* p_Samples = PrepareAudio(c_Buffer, us_SampleCount);
 
     if (us_SampleCount == 0)
     {
@@ -103,8 +104,6 @@ void PicovoiceLeopard::Transcribe(AudioBuffer& c_Buffer, std::string& s_String)
                           " samples.");
 
     // Perform transcription
-    // @NOTE: We don't use words or word count, but leopard returns invalid param
-    //        if those are not given as parameters
     char* p_Transcript = NULL;
     int32_t s32_WordCount = 0;
     pv_word_t* p_Words = NULL;
@@ -112,22 +111,44 @@ void PicovoiceLeopard::Transcribe(AudioBuffer& c_Buffer, std::string& s_String)
     try
     {
         pv_status_t e_Status = pv_leopard_process(p_Handle,
-                                                  v_Audio.data(),
+                                                  p_Samples,
                                                   us_SampleCount,
                                                   &p_Transcript,
                                                   &s32_WordCount,
                                                   &p_Words);
 
+        // Samples were used in place, consume afterwards
+        c_Buffer.Clear();
+
         if (e_Status != PV_STATUS_SUCCESS)
         {
             throw Exception("Failed to transcribe speech input: " +
                             std::string(pv_status_to_string(e_Status)));
         }
 
-        s_String = p_Transcript;
+        // Leopard returns a single alternative with timed words
+        MRH_Sfloat32 f32_Confidence = -1.f;
+
+        c_Result.Clear();
+        c_Result.s_Transcript = p_Transcript;
+
+        for (int32_t i = 0; i < s32_WordCount; ++i)
+        {
+            c_Result.v_Word.push_back({ p_Words[i].word,
+                                        static_cast<MRH_Uint32>(p_Words[i].start_sec * 1000.f),
+                                        static_cast<MRH_Uint32>(p_Words[i].end_sec * 1000.f) });
+
+            if (f32_Confidence < 0.f || p_Words[i].confidence < f32_Confidence)
+            {
+                f32_Confidence = p_Words[i].confidence;
+            }
+        }
+
+        c_Result.f32_Confidence = f32_Confidence;
+        c_Result.v_Segment.push_back({ { { c_Result.s_Transcript, f32_Confidence } } });
 
         PICOVOICE_LEOPARD_LOG("Transcription result: " +
-                              s_String);
+                              c_Result.s_Transcript);
 
         free(p_Transcript);
         free(p_Words);
@@ -54,13 +54,13 @@ public:
     //*************************************************************************************
 
     /**
-     *  Transcribe a string from a audio buffer.
+     *  Transcribe a audio buffer.
      *
      *  \param c_Buffer The audio buffer to transcribe. The buffer is emptied.
-     *  \param s_String The transcribed speech string.
+     *  \param c_Result The transcription result. The result is overwritten.
      */
 
-    void Transcribe(AudioBuffer& c_Buffer, std::string& s_String) override;
+    void Transcribe(AudioBuffer& c_Buffer, STTResult& c_Result) override;
 
 private:
 
@@ -18,11 +18,15 @@
 #define STT_h
 
 // C / C++
+#include <vector>
+#include <memory>
+#include <mutex>
 #include <cstring>
 
 // External
 
 // Project
+#include "./STTStream.h"
 #include "../Audio/AudioBuffer.h"
 #include "../Logger.h"
 #include "../Exception.h"
@@ -48,17 +52,32 @@ public:
     //*************************************************************************************
 
     /**
-     *  Transcribe a string from a audio buffer.
+     *  Transcribe a audio buffer.
      *
      *  \param c_Buffer The audio buffer to transcribe. The buffer is emptied.
-     *  \param s_String The transcribed speech string.
+     *  \param c_Result The transcription result. The result is overwritten.
      */
 
-    virtual void Transcribe(AudioBuffer& c_Buffer, std::string& s_String)
+    virtual void Transcribe(AudioBuffer& c_Buffer, STTResult& c_Result)
     {
         throw Exception("Default Transcribe() function called!");
     }
 
+    //*************************************************************************************
+    // Stream
+    //*************************************************************************************
+
+    /**
+     *  Begin a transcription stream which is fed while recording. The default
+     *  stream collects all audio and transcribes it once finished.
+     *
+     *  \param u32_KHz The KHz of the audio fed to the stream.
+     *
+     *  \return The transcription stream.
+     */
+
+    virtual std::shared_ptr<STTStream> BeginStream(MRH_Uint32 u32_KHz);
+
     //*************************************************************************************
     // Data
     //*************************************************************************************
@@ -67,10 +86,15 @@ public:
 
 private:
 
+    friend class BufferedSTTStream;
+
     //*************************************************************************************
     // Data
     //*************************************************************************************
 
+    // @NOTE: Shared by all sessions, buffered audio is transcribed one at a time
+    std::mutex c_TranscribeMutex;
+
 protected:
 
     //*************************************************************************************
@@ -85,10 +109,7 @@ protected:
 
     STT(std::string const& s_Identifier) noexcept : s_Identifier(s_Identifier)
     {
-        Logger::Singleton().Log(Logger::INFO, "Created [ " +
-                                              s_Identifier +
-                                              " ] STT API.",
-                                "STT.h", __LINE__);
+        MRH_LOG_INFO("Created [ {} ] STT API.", s_Identifier);
     }
 
     //*************************************************************************************
@@ -96,43 +117,37 @@ protected:
     //*************************************************************************************
 
     /**
-     *  Add audio from a audio buffer.
+     *  Get all samples of a audio buffer as one contiguous array. Contiguous
+     *  buffers are used directly, wrapped buffers are copied once.
      *
-     *  \param c_Buffer The buffer to add. The buffer is consumed.
+     *  \param c_Buffer The buffer to prepare. The buffer must not change while the
+     *                  returned samples are used.
+     *  \param us_Samples The amount of samples prepared.
      *
-     *  \return The amount of samples added.
+     *  \return The prepared samples.
      */
 
-    size_t PrepareAudio(AudioBuffer& c_Buffer) noexcept
+    const MRH_Sint16* PrepareAudio(AudioBuffer const& c_Buffer, size_t& us_Samples) noexcept
     {
-        std::deque<AudioBuffer::AudioChunk> dq_Chunk;
-        c_Buffer.Retrieve(dq_Chunk);
+        AudioBuffer::ConstRegion c_First;
+        AudioBuffer::ConstRegion c_Second;
 
-        size_t us_Pos = 0;
+        us_Samples = c_Buffer.GetReadRegions(c_First, c_Second);
+
+        if (c_Second.us_Samples == 0)
+        {
+            return c_First.p_Samples;
+        }
 
-        for (auto& Chunk : dq_Chunk)
+        if (v_Audio.size() < us_Samples)
         {
-            size_t us_Size = Chunk.size();
-
-            if (us_Size == 0)
-            {
-                continue;
-            }
-            else if (v_Audio.size() < (us_Pos + us_Size))
-            {
-                v_Audio.insert(v_Audio.end(),
-                               ((us_Pos + us_Size) - v_Audio.size()),
-                               0);
-            }
-
-            memcpy(&(v_Audio[us_Pos]),
-                   &(Chunk[0]),
-                   us_Size);
-
-            us_Pos += us_Size;
+            v_Audio.resize(us_Samples);
         }
 
-        return us_Pos;
+        std::memcpy(v_Audio.data(), c_First.p_Samples, c_First.us_Samples * sizeof(MRH_Sint16));
+        std::memcpy(v_Audio.data() + c_First.us_Samples, c_Second.p_Samples, c_Second.us_Samples * sizeof(MRH_Sint16));
+
+        return v_Audio.data();
     }
 
     //*************************************************************************************
@@ -142,4 +157,80 @@ protected:
     std::vector<MRH_Sint16> v_Audio;
 };
 
+class BufferedSTTStream : public STTStream
+{
+public:
+
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+
+    /**
+     *  Default constructor.
+     *
+     *  \param c_STT The STT API to transcribe with when finished.
+     *  \param u32_KHz The KHz of the audio fed to the stream.
+     */
+
+    BufferedSTTStream(STT& c_STT, MRH_Uint32 u32_KHz) noexcept : c_STT(c_STT),
+                                                                 c_Buffer(u32_KHz)
+    {}
+
+    /**
+     *  Default destructor.
+     */
+
+    ~BufferedSTTStream() noexcept
+    {}
+
+    //*************************************************************************************
+    // Stream
+    //*************************************************************************************
+
+    /**
+     *  Feed recorded audio to the transcription stream.
+     *
+     *  \param c_Buffer The audio buffer to feed. The buffer is emptied.
+     */
+
+    void Feed(AudioBuffer& c_Buffer) override
+    {
+        this->c_Buffer.Add(c_Buffer);
+    }
+
+    /**
+     *  Finish the transcription stream and get the transcription result.
+     *
+     *  \param c_Result The transcription result. The result is overwritten.
+     */
+
+    void Finish(STTResult& c_Result) override
+    {
+        std::lock_guard<std::mutex> c_Guard(c_STT.c_TranscribeMutex);
+
+        c_STT.Transcribe(c_Buffer, c_Result);
+    }
+
+private:
+
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+
+    STT& c_STT;
+    AudioBuffer c_Buffer;
+
+protected:
+
+};
+
+//*************************************************************************************
+// Stream
+//*************************************************************************************
+
+inline std::shared_ptr<STTStream> STT::BeginStream(MRH_Uint32 u32_KHz)
+{
+    return std::make_shared<BufferedSTTStream>(*this, u32_KHz);
+}
+
 #endif /* STT_h */
@@ -0,0 +1,82 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef STTResult_h
+#define STTResult_h
+
+// C / C++
+#include <string>
+#include <vector>
+
+// External
+#include <MRH_Typedefs.h>
+
+// Project
+
+
+struct STTResult
+{
+    //*************************************************************************************
+    // Types
+    //*************************************************************************************
+
+    struct Alternative
+    {
+        std::string s_Transcript;
+        MRH_Sfloat32 f32_Confidence; // -1 if unknown
+    };
+
+    struct Segment
+    {
+        // @NOTE: The best alternative is always the first
+        std::vector<Alternative> v_Alternative;
+    };
+
+    struct Word
+    {
+        std::string s_Word;
+        MRH_Uint32 u32_StartMS; // Relative to the start of the audio
+        MRH_Uint32 u32_EndMS;
+    };
+
+    //*************************************************************************************
+    // Clear
+    //*************************************************************************************
+
+    /**
+     *  Clear the result. Allocations are kept.
+     */
+
+    void Clear() noexcept
+    {
+        s_Transcript.clear();
+        f32_Confidence = -1.f;
+        v_Segment.clear();
+        v_Word.clear();
+    }
+
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+
+    std::string s_Transcript = ""; // Best alternatives of all segments
+    MRH_Sfloat32 f32_Confidence = -1.f; // Lowest best segment confidence, -1 if unknown
+
+    std::vector<Segment> v_Segment; // N-best lists, in spoken order
+    std::vector<Word> v_Word; // Words of the best alternatives, if available
+};
+
+#endif /* STTResult_h */
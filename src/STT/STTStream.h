@@ -14,100 +14,76 @@
  *  limitations under the License.
  */
 
-#ifndef DataNotifier_h
-#define DataNotifier_h
+#ifndef STTStream_h
+#define STTStream_h
 
 // C / C++
-#include <mutex>
-#include <condition_variable>
+#include <string>
 
 // External
 
 // Project
+#include "./STTResult.h"
+#include "../Audio/AudioBuffer.h"
+#include "../Exception.h"
 
 
-class DataNotifier
+class STTStream
 {
 public:
 
     //*************************************************************************************
-    // Constructor / Destructor
+    // Destructor
     //*************************************************************************************
 
-    /**
-     *  Default constructor.
-     */
-
-    DataNotifier() noexcept : b_Notified(false)
-    {}
-
     /**
      *  Default destructor.
      */
 
-    ~DataNotifier() noexcept
+    virtual ~STTStream() noexcept
     {}
 
     //*************************************************************************************
-    // Wait
+    // Stream
     //*************************************************************************************
 
     /**
-     *  Wait for a notification.
+     *  Feed recorded audio to the transcription stream.
+     *
+     *  \param c_Buffer The audio buffer to feed. The buffer is emptied.
      */
 
-    void Wait() noexcept
+    virtual void Feed(AudioBuffer& /* c_Buffer */)
     {
-        std::unique_lock<std::mutex> c_Lock(c_Mutex);
-
-        if (b_Notified == false)
-        {
-            c_Condition.wait(c_Lock);
-        }
-
-        b_Notified = false;
+        throw Exception("Default Feed() function called!");
     }
 
-    //*************************************************************************************
-    // Notify
-    //*************************************************************************************
-
     /**
-     *  Notify a waiting thread.
+     *  Finish the transcription stream and get the transcription result. The
+     *  stream cannot be fed afterwards.
      *
-     *  \param b_All If all waiting threads should be notified.
+     *  \param c_Result The transcription result. The result is overwritten.
      */
 
-    void Notify(bool b_All) noexcept
+    virtual void Finish(STTResult& /* c_Result */)
     {
-        {
-            std::lock_guard<std::mutex> c_Guard(c_Mutex);
-
-            b_Notified = true;
-        }
-
-        if (b_All == true)
-        {
-            c_Condition.notify_all();
-        }
-        else
-        {
-            c_Condition.notify_one();
-        }
+        throw Exception("Default Finish() function called!");
     }
 
 private:
 
+protected:
+
     //*************************************************************************************
-    // Data
+    // Constructor
     //*************************************************************************************
 
-    std::mutex c_Mutex;
-    std::condition_variable c_Condition;
-    bool b_Notified;
-
-protected:
+    /**
+     *  Default constructor.
+     */
 
+    STTStream() noexcept
+    {}
 };
 
-#endif /* DataNotifier_h */
+#endif /* STTStream_h */
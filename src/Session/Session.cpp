@@ -0,0 +1,294 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+
+// External
+
+// Project
+#include "./Session.h"
+#include "../Latency.h"
+
+
+//*************************************************************************************
+// Constructor / Destructor
+//*************************************************************************************
+
+Session::Session(Configuration const& c_Configuration,
+                 size_t us_Session,
+                 std::shared_ptr<EventQueue>& p_EventQueue,
+                 std::shared_ptr<WorkerPool>& p_WorkerPool,
+                 std::shared_ptr<STT>& p_STT,
+                 std::shared_ptr<TTS>& p_TTS) : us_Session(us_Session),
+                                                p_Marks(std::make_shared<Latency::Marks>()),
+                                                c_Input(0),
+                                                c_Output(0),
+                                                b_Transcribing(false)
+{
+    if (us_Session >= c_Configuration.v_Session.size())
+    {
+        throw Exception("Invalid session index!");
+    }
+
+    auto const& Session = c_Configuration.v_Session[us_Session];
+
+    // @NOTE: Speech checkers keep state between frames, each recorder needs its own
+    std::shared_ptr<SpeechChecker> p_SpeechChecker = CreateAudioAPI::CreateSpeechChecker(c_Configuration);
+    std::shared_ptr<RecorderContext> p_RecorderContext = std::make_shared<RecorderContext>(p_EventQueue,
+                                                                                           us_Session,
+                                                                                           p_SpeechChecker,
+                                                                                           p_Marks);
+
+    p_Recorder = CreateAudioAPI::CreateRecorder(c_Configuration, Session, p_RecorderContext);
+    p_Player = CreateAudioAPI::CreatePlayer(c_Configuration, Session, p_Marks);
+
+    p_Stream = std::make_shared<UTF8Stream>(Session.s_SocketPath,
+                                            static_cast<UTF8Stream::Framing>(Session.u8_Framing),
+                                            Session.us_QueueSize,
+                                            Session.u32_QueueMaxAgeS,
+                                            Session.s_QueueFilePath,
+                                            p_EventQueue,
+                                            us_Session,
+                                            p_Marks);
+
+    if (Session.s_AudioSocketPath.compare("null") != 0)
+    {
+        p_AudioStream = std::make_shared<AudioStream>(Session.s_AudioSocketPath);
+    }
+
+    p_InputWorker = std::make_shared<InputWorker>(p_WorkerPool, p_STT, p_Stream, p_EventQueue, us_Session);
+    p_OutputWorker = std::make_shared<OutputWorker>(p_WorkerPool, p_TTS, p_EventQueue, us_Session);
+
+    MRH_LOG_INFO("[Session {}] Created session for {}.", us_Session, Session.s_SocketPath);
+}
+
+Session::~Session() noexcept
+{
+    // Queued worker tasks might still run, discard their work
+    p_InputWorker->Cancel();
+    p_OutputWorker->Cancel();
+}
+
+//*************************************************************************************
+// Audio
+//*************************************************************************************
+
+void Session::StartRecording() noexcept
+{
+    // Only works while connected and not recording or playing!
+    if (p_Stream->IsConnected() == false || p_Player->GetPlaying() == true || p_Recorder->GetRecording() == true)
+    {
+        return;
+    }
+
+    try
+    {
+        MRH_LOG_INFO("[Session {}] Starting to record.", us_Session);
+
+        // Recording is cleared
+        p_InputWorker->Cancel();
+        b_Transcribing = false;
+
+        if (p_AudioStream != NULL)
+        {
+            p_AudioStream->Finish(true);
+        }
+
+        p_Recorder->Start(true);
+    }
+    catch (Exception& e)
+    {
+        MRH_LOG_ERROR("[Session {}] Failed to start recording: {}", us_Session, e.what2());
+    }
+}
+
+void Session::StopAudio() noexcept
+{
+    p_OutputWorker->Cancel();
+    p_Recorder->Stop();
+    p_Player->Stop();
+}
+
+//*************************************************************************************
+// Update
+//*************************************************************************************
+
+void Session::Update(MRH_Uint32 u32_Events, MRH_Uint64 u64_Wake) noexcept
+{
+    Latency& c_Latency = Latency::Singleton();
+
+    /**
+     *  Connection
+     */
+
+    // Are we connected to the service
+    // @NOTE: Speech recorded so far is still transcribed, the stream 
+    //        queues the transcription until reconnected
+    if (EventQueue::GetEvent(u32_Events, EventQueue::EVENT_CONNECTION) == true && p_Stream->IsConnected() == false)
+    {
+        MRH_LOG_INFO("[Session {}] Not connected, stopping recording.", us_Session);
+
+        p_Recorder->Stop(); // No new recordings until connected
+    }
+
+    /**
+     *  Output
+     */
+
+    // Hand read messages to synthesis
+    // @NOTE: Messages stay with the stream while the queue is full, the
+    //        worker notifies once space is available again
+    if (EventQueue::GetEvent(u32_Events, EventQueue::EVENT_MESSAGE) == true)
+    {
+        try
+        {
+            while (p_OutputWorker->GetFree() > 0 && p_Stream->GetAvailable() == true)
+            {
+                MRH_Uint64 u64_Read = p_Marks->Take(Latency::MARK_MESSAGE_READ);
+                c_Latency.Add(Latency::STAGE_MESSAGE_WAKE, u64_Read, u64_Wake);
+
+                std::string s_Message = p_Stream->GetMessage();
+                p_OutputWorker->Add(s_Message, u64_Read);
+            }
+        }
+        catch (Exception& e)
+        {
+            MRH_LOG_ERROR("[Session {}] Failed to handle output: {}", us_Session, e.what2());
+        }
+    }
+
+    // Is there something to play?
+    if (EventQueue::GetEvent(u32_Events, EventQueue::EVENT_SYNTHESIZED) == true)
+    {
+        MRH_Uint64 u64_Read;
+        bool b_First;
+
+        while (p_OutputWorker->GetAudio(c_Output, b_First, u64_Read) == true)
+        {
+            try
+            {
+                // Stop recording for each message played
+                if (b_First == true)
+                {
+                    MRH_LOG_INFO("[Session {}] Starting output playback.", us_Session);
+
+                    p_Recorder->Stop();
+                }
+
+                // Messages are played after each other
+                if (p_Player->GetPlaying() == false)
+                {
+                    // @NOTE: The first played frame completes the message latency
+                    if (b_First == true)
+                    {
+                        p_Marks->Set(Latency::MARK_MESSAGE_PLAYBACK, u64_Read);
+                    }
+
+                    p_Player->Start(c_Output);
+                }
+                else
+                {
+                    p_Player->Append(c_Output);
+                }
+            }
+            catch (Exception& e)
+            {
+                MRH_LOG_ERROR("[Session {}] Failed to play output: {}", us_Session, e.what2());
+            }
+        }
+    }
+
+    /**
+     *  Input
+     */
+
+    // Was audio recorded to transcribe?
+    // @NOTE: No playback check, recordings can be streamed while playing!
+    //        Audio stays with the recorder while the queue is full, the
+    //        worker notifies once space is available again
+    if ((EventQueue::GetEvent(u32_Events, EventQueue::EVENT_RECORDING) == true ||
+         EventQueue::GetEvent(u32_Events, EventQueue::EVENT_RECORDING_FINISHED) == true) &&
+        p_Recorder->GetSpeechRecorded() == true &&
+        p_InputWorker->GetFree() > 0)
+    {
+        try
+        {
+            // Check first, samples recorded before stopping are then
+            // guaranteed to be part of the retrieved audio
+            bool b_Recording = p_Recorder->GetRecording();
+
+            p_Recorder->GetRecordedAudio(c_Input);
+
+            if (c_Input.GetSampleCount() > 0)
+            {
+                // @NOTE: Written before feeding, the worker takes the samples
+                if (p_AudioStream != NULL)
+                {
+                    p_AudioStream->Write(c_Input);
+                }
+
+                p_InputWorker->Feed(c_Input);
+                b_Transcribing = true;
+            }
+
+            if (b_Transcribing == true && b_Recording == false && p_InputWorker->GetFree() > 0)
+            {
+                MRH_Uint64 u64_SpeechEnd = p_Marks->Take(Latency::MARK_SPEECH_END);
+                c_Latency.Add(Latency::STAGE_SPEECH_END_WAKE, u64_SpeechEnd, u64_Wake);
+
+                p_InputWorker->Finish(u64_SpeechEnd);
+                b_Transcribing = false;
+
+                if (p_AudioStream != NULL)
+                {
+                    p_AudioStream->Finish(false);
+                }
+            }
+        }
+        catch (Exception& e)
+        {
+            MRH_LOG_ERROR("[Session {}] Failed to handle input: {}", us_Session, e.what2());
+
+            p_InputWorker->Cancel();
+            b_Transcribing = false;
+
+            if (p_AudioStream != NULL)
+            {
+                p_AudioStream->Finish(true);
+            }
+        }
+    }
+}
+
+//*************************************************************************************
+// Statistics
+//*************************************************************************************
+
+void Session::Dump() noexcept
+{
+    MRH_LOG_INFO("[Session {}] Stream queue: {} queued, {} replayed, {} dropped.",
+                 us_Session,
+                 p_Stream->GetQueued(),
+                 p_Stream->GetReplayed(),
+                 p_Stream->GetDropped());
+
+    if (p_AudioStream != NULL)
+    {
+        MRH_LOG_INFO("[Session {}] Audio stream: {} chunks dropped.",
+                     us_Session,
+                     p_AudioStream->GetDropped());
+    }
+}
@@ -0,0 +1,133 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef Session_h
+#define Session_h
+
+// C / C++
+#include <memory>
+
+// External
+#include <MRH_Typedefs.h>
+
+// Project
+#include "../Audio/API/CreateAudioAPI.h"
+#include "../Stream/UTF8Stream.h"
+#include "../Stream/AudioStream.h"
+#include "../Worker/InputWorker.h"
+#include "../Worker/OutputWorker.h"
+#include "../Configuration.h"
+#include "../Latency.h"
+
+
+class Session
+{
+public:
+
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+
+    /**
+     *  Default constructor.
+     *
+     *  \param c_Configuration The configuration to create with.
+     *  \param us_Session The session index, used as the event queue channel.
+     *  \param p_EventQueue The event queue to notify.
+     *  \param p_WorkerPool The shared worker pool to transcribe and synthesize with.
+     *  \param p_STT The shared STT API.
+     *  \param p_TTS The shared TTS API.
+     */
+
+    Session(Configuration const& c_Configuration,
+            size_t us_Session,
+            std::shared_ptr<EventQueue>& p_EventQueue,
+            std::shared_ptr<WorkerPool>& p_WorkerPool,
+            std::shared_ptr<STT>& p_STT,
+            std::shared_ptr<TTS>& p_TTS);
+
+    /**
+     *  Default destructor.
+     */
+
+    ~Session() noexcept;
+
+    //*************************************************************************************
+    // Audio
+    //*************************************************************************************
+
+    /**
+     *  Start recording if connected and neither recording nor playing.
+     */
+
+    void StartRecording() noexcept;
+
+    /**
+     *  Stop recording, playback and queued output.
+     */
+
+    void StopAudio() noexcept;
+
+    //*************************************************************************************
+    // Update
+    //*************************************************************************************
+
+    /**
+     *  Handle received session events.
+     *
+     *  \param u32_Events The received events for this session.
+     *  \param u64_Wake The latency time at which the events were received.
+     */
+
+    void Update(MRH_Uint32 u32_Events, MRH_Uint64 u64_Wake) noexcept;
+
+    //*************************************************************************************
+    // Statistics
+    //*************************************************************************************
+
+    /**
+     *  Write the stream queue statistics to the log.
+     */
+
+    void Dump() noexcept;
+
+private:
+
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+
+    size_t us_Session;
+
+    // @NOTE: Set by the recorder, player and stream of this session only
+    std::shared_ptr<Latency::Marks> p_Marks;
+
+    std::shared_ptr<UTF8Stream> p_Stream;
+    std::shared_ptr<AudioStream> p_AudioStream; // Optional, NULL if disabled
+    std::shared_ptr<Recorder> p_Recorder;
+    std::shared_ptr<Player> p_Player;
+    std::shared_ptr<InputWorker> p_InputWorker;
+    std::shared_ptr<OutputWorker> p_OutputWorker;
+
+    AudioBuffer c_Input;
+    AudioBuffer c_Output;
+    bool b_Transcribing;
+
+protected:
+
+};
+
+#endif /* Session_h */
@@ -0,0 +1,102 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+
+// External
+
+// Project
+#include "./SessionManager.h"
+
+
+//*************************************************************************************
+// Constructor / Destructor
+//*************************************************************************************
+
+SessionManager::SessionManager(Configuration const& c_Configuration,
+                               std::shared_ptr<EventQueue>& p_EventQueue,
+                               std::shared_ptr<STT>& p_STT,
+                               std::shared_ptr<TTS>& p_TTS)
+{
+    p_WorkerPool = std::make_shared<WorkerPool>(c_Configuration.c_Worker.u32_Threads);
+
+    for (size_t i = 0; i < c_Configuration.v_Session.size(); ++i)
+    {
+        v_Session.emplace_back(std::make_unique<Session>(c_Configuration,
+                                                         i,
+                                                         p_EventQueue,
+                                                         p_WorkerPool,
+                                                         p_STT,
+                                                         p_TTS));
+    }
+}
+
+SessionManager::~SessionManager() noexcept
+{
+    // @NOTE: Stopped first, no task is running or queued once the 
+    //        sessions and their workers are destroyed
+    p_WorkerPool->Stop();
+
+    v_Session.clear();
+    p_WorkerPool.reset();
+}
+
+//*************************************************************************************
+// Audio
+//*************************************************************************************
+
+void SessionManager::StartRecording() noexcept
+{
+    for (auto& Session : v_Session)
+    {
+        Session->StartRecording();
+    }
+}
+
+void SessionManager::StopAudio() noexcept
+{
+    for (auto& Session : v_Session)
+    {
+        Session->StopAudio();
+    }
+}
+
+//*************************************************************************************
+// Update
+//*************************************************************************************
+
+void SessionManager::Update(std::vector<MRH_Uint32> const& v_Events, MRH_Uint64 u64_Wake) noexcept
+{
+    for (size_t i = 0; i < v_Session.size() && i < v_Events.size(); ++i)
+    {
+        if (v_Events[i] != 0)
+        {
+            v_Session[i]->Update(v_Events[i], u64_Wake);
+        }
+    }
+}
+
+//*************************************************************************************
+// Statistics
+//*************************************************************************************
+
+void SessionManager::Dump() noexcept
+{
+    for (auto& Session : v_Session)
+    {
+        Session->Dump();
+    }
+}
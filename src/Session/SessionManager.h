@@ -0,0 +1,113 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef SessionManager_h
+#define SessionManager_h
+
+// C / C++
+#include <vector>
+#include <memory>
+
+// External
+#include <MRH_Typedefs.h>
+
+// Project
+#include "./Session.h"
+
+
+class SessionManager
+{
+public:
+
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+
+    /**
+     *  Default constructor. One session is created for each configured session, all
+     *  sessions share the worker pool and the STT and TTS APIs.
+     *
+     *  \param c_Configuration The configuration to create with.
+     *  \param p_EventQueue The event queue to notify. Requires one channel per session.
+     *  \param p_STT The STT API to transcribe with.
+     *  \param p_TTS The TTS API to synthesize with.
+     */
+
+    SessionManager(Configuration const& c_Configuration,
+                   std::shared_ptr<EventQueue>& p_EventQueue,
+                   std::shared_ptr<STT>& p_STT,
+                   std::shared_ptr<TTS>& p_TTS);
+
+    /**
+     *  Default destructor.
+     */
+
+    ~SessionManager() noexcept;
+
+    //*************************************************************************************
+    // Audio
+    //*************************************************************************************
+
+    /**
+     *  Start recording for all sessions which are able to.
+     */
+
+    void StartRecording() noexcept;
+
+    /**
+     *  Stop recording and playback for all sessions.
+     */
+
+    void StopAudio() noexcept;
+
+    //*************************************************************************************
+    // Update
+    //*************************************************************************************
+
+    /**
+     *  Handle received events for all sessions.
+     *
+     *  \param v_Events The received events for each session.
+     *  \param u64_Wake The latency time at which the events were received.
+     */
+
+    void Update(std::vector<MRH_Uint32> const& v_Events, MRH_Uint64 u64_Wake) noexcept;
+
+    //*************************************************************************************
+    // Statistics
+    //*************************************************************************************
+
+    /**
+     *  Write the statistics of all sessions to the log.
+     */
+
+    void Dump() noexcept;
+
+private:
+
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+
+    // @NOTE: The pool is stopped before the sessions are destroyed
+    std::shared_ptr<WorkerPool> p_WorkerPool;
+    std::vector<std::unique_ptr<Session>> v_Session;
+
+protected:
+
+};
+
+#endif /* SessionManager_h */
@@ -0,0 +1,390 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/uio.h>
+#include <errno.h>
+#include <cstring>
+
+// External
+
+// Project
+#include "./AudioStream.h"
+#include "../Logger.h"
+#include "../Latency.h"
+
+// Pre-defined
+#ifndef MRH_SPEECHD_CONNECT_WAIT_S
+    #define MRH_SPEECHD_CONNECT_WAIT_S 5 // Maximum delay between connect attempts
+#endif
+#ifndef MRH_SPEECHD_CONNECT_BACKOFF_MS
+    #define MRH_SPEECHD_CONNECT_BACKOFF_MS 10 // First delay after a failed connect
+#endif
+#define MRH_SPEECHD_AUDIO_FRAME_VERSION 1
+#define MRH_SPEECHD_AUDIO_FRAME_HEADER_SIZE 32
+
+// Namespace
+namespace
+{
+    inline void SetLE(MRH_Uint8* p_Bytes, MRH_Uint64 u64_Value, size_t us_Bytes) noexcept
+    {
+        for (size_t i = 0; i < us_Bytes; ++i)
+        {
+            p_Bytes[i] = static_cast<MRH_Uint8>(u64_Value >> (8 * i));
+        }
+    }
+}
+
+
+//*************************************************************************************
+// Constructor / Destructor
+//*************************************************************************************
+
+AudioStream::AudioStream(std::string const& s_SocketPath) : s_SocketPath(s_SocketPath),
+                                                            i_FD(-1),
+                                                            u32_BackoffMS(MRH_SPEECHD_CONNECT_BACKOFF_MS),
+                                                            u64_ConnectUS(0),
+                                                            us_Pending(0),
+                                                            u32_Utterance(0),
+                                                            u64_Sample(0),
+                                                            b_Utterance(false),
+                                                            b_Start(false),
+                                                            u8_Marker(0),
+                                                            u32_MarkerUtterance(0),
+                                                            u64_MarkerSample(0),
+                                                            u64_Dropped(0)
+{
+    if (s_SocketPath.size() >= sizeof(((struct sockaddr_un*)NULL)->sun_path))
+    {
+        throw Exception("Audio socket path " + s_SocketPath + " is too long!");
+    }
+
+    Connect();
+}
+
+AudioStream::~AudioStream() noexcept
+{
+    if (i_FD >= 0)
+    {
+        shutdown(i_FD, SHUT_RDWR);
+        close(i_FD);
+    }
+}
+
+//*************************************************************************************
+// Connection
+//*************************************************************************************
+
+bool AudioStream::Connect() noexcept
+{
+    if (i_FD >= 0)
+    {
+        return true;
+    }
+    else if (Latency::GetTime() < u64_ConnectUS)
+    {
+        return false;
+    }
+
+    struct sockaddr_un c_Address;
+    int i_Error = 0;
+    int i_FD;
+
+    std::memset(&c_Address, 0, sizeof(c_Address));
+    c_Address.sun_family = AF_UNIX;
+    strcpy(c_Address.sun_path, s_SocketPath.c_str());
+
+    if ((i_FD = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0)) < 0)
+    {
+        i_Error = errno;
+    }
+    else if (connect(i_FD, (struct sockaddr*)&c_Address, sizeof(c_Address)) < 0)
+    {
+        i_Error = errno;
+        close(i_FD);
+    }
+
+    if (i_Error != 0)
+    {
+        // Log the first failure and the slowest retries only
+        if (u32_BackoffMS == MRH_SPEECHD_CONNECT_BACKOFF_MS || u32_BackoffMS == MRH_SPEECHD_CONNECT_WAIT_S * 1000)
+        {
+            MRH_LOG_WARNING("Could not connect to audio socket {}: {}", s_SocketPath, std::strerror(i_Error));
+        }
+
+        u64_ConnectUS = Latency::GetTime() + (u32_BackoffMS * 1000ULL);
+        u32_BackoffMS *= 2;
+
+        if (u32_BackoffMS > MRH_SPEECHD_CONNECT_WAIT_S * 1000)
+        {
+            u32_BackoffMS = MRH_SPEECHD_CONNECT_WAIT_S * 1000;
+        }
+
+        return false;
+    }
+
+    this->i_FD = i_FD;
+    u32_BackoffMS = MRH_SPEECHD_CONNECT_BACKOFF_MS;
+
+    MRH_LOG_INFO("Connected to audio socket {}.", s_SocketPath);
+
+    return true;
+}
+
+void AudioStream::Disconnect() noexcept
+{
+    if (i_FD < 0)
+    {
+        return;
+    }
+
+    shutdown(i_FD, SHUT_RDWR);
+    close(i_FD);
+
+    i_FD = -1;
+
+    // Retry with the next chunk, the receiver might only have restarted
+    u64_ConnectUS = 0;
+
+    v_Pending.clear();
+    us_Pending = 0;
+
+    // The next connection starts with the current utterance, markers for
+    // utterances seen by the closed connection are not needed
+    b_Start = b_Utterance;
+    u8_Marker = 0;
+
+    MRH_LOG_INFO("Closed audio connection.");
+}
+
+//*************************************************************************************
+// Write
+//*************************************************************************************
+
+void AudioStream::Write(AudioBuffer const& c_Buffer) noexcept
+{
+    size_t us_Samples = c_Buffer.GetSampleCount();
+
+    if (us_Samples == 0)
+    {
+        return;
+    }
+
+    if (b_Utterance == false)
+    {
+        b_Utterance = true;
+        ++u32_Utterance;
+        u64_Sample = 0;
+
+        b_Start = true;
+    }
+
+    // @NOTE: The marker of the previous utterance has to arrive first, the 
+    //        chunk is dropped if the marker could not be written
+    if (Connect() == true)
+    {
+        AudioBuffer::ConstRegion c_First;
+        AudioBuffer::ConstRegion c_Second;
+
+        c_Buffer.GetReadRegions(c_First, c_Second);
+
+        if (WriteMarker() == true &&
+            WriteFrame(b_Start == true ? FLAG_START : 0, c_Buffer.GetKHz(), u32_Utterance, u64_Sample, c_First, c_Second) == true)
+        {
+            b_Start = false;
+        }
+        else if (i_FD >= 0)
+        {
+            ++u64_Dropped;
+        }
+    }
+
+    // @NOTE: Dropped chunks still advance, receivers see the gap
+    u64_Sample += us_Samples;
+}
+
+void AudioStream::Finish(bool b_Cancelled) noexcept
+{
+    if (b_Utterance == true)
+    {
+        b_Utterance = false;
+
+        // The receiver never saw a utterance without a started frame
+        if (b_Start == true)
+        {
+            b_Start = false;
+            return;
+        }
+
+        u8_Marker = b_Cancelled == true ? FLAG_CANCEL : FLAG_END;
+        u32_MarkerUtterance = u32_Utterance;
+        u64_MarkerSample = u64_Sample;
+    }
+
+    if (u8_Marker != 0 && Connect() == true)
+    {
+        WriteMarker();
+    }
+}
+
+bool AudioStream::WriteMarker() noexcept
+{
+    if (u8_Marker == 0)
+    {
+        return true;
+    }
+
+    AudioBuffer::ConstRegion c_Empty = { NULL, 0 };
+
+    if (WriteFrame(u8_Marker, 0, u32_MarkerUtterance, u64_MarkerSample, c_Empty, c_Empty) == false)
+    {
+        return false;
+    }
+
+    u8_Marker = 0;
+
+    return true;
+}
+
+bool AudioStream::WritePending() noexcept
+{
+    while (us_Pending < v_Pending.size())
+    {
+        ssize_t ss_Result = send(i_FD, &(v_Pending[us_Pending]), v_Pending.size() - us_Pending, MSG_NOSIGNAL);
+
+        if (ss_Result < 0)
+        {
+            if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+            {
+                return false;
+            }
+
+            MRH_LOG_ERROR("Could not write audio socket: {}", std::strerror(errno));
+
+            Disconnect();
+            return false;
+        }
+
+        us_Pending += static_cast<size_t>(ss_Result);
+    }
+
+    v_Pending.clear();
+    us_Pending = 0;
+
+    return true;
+}
+
+bool AudioStream::WriteFrame(MRH_Uint8 u8_Flags,
+                             MRH_Uint32 u32_KHz,
+                             MRH_Uint32 u32_Utterance,
+                             MRH_Uint64 u64_Sample,
+                             AudioBuffer::ConstRegion const& c_First,
+                             AudioBuffer::ConstRegion const& c_Second) noexcept
+{
+    // Live audio, the receiver has to keep up instead of building a backlog
+    if (WritePending() == false)
+    {
+        return false;
+    }
+
+    size_t us_Samples = c_First.us_Samples + c_Second.us_Samples;
+    MRH_Uint8 p_Header[MRH_SPEECHD_AUDIO_FRAME_HEADER_SIZE];
+
+    p_Header[0] = MRH_SPEECHD_AUDIO_FRAME_VERSION;
+    p_Header[1] = u8_Flags;
+    SetLE(&(p_Header[2]), 0, 2);
+    SetLE(&(p_Header[4]), u32_KHz, 4);
+    SetLE(&(p_Header[8]), Latency::GetTime(), 8);
+    SetLE(&(p_Header[16]), u64_Sample, 8);
+    SetLE(&(p_Header[24]), u32_Utterance, 4);
+    SetLE(&(p_Header[28]), us_Samples, 4);
+
+    // @NOTE: The samples are sent straight from the buffer regions. 
+    //        MSG_ZEROCOPY is not supported for local sockets, the kernel 
+    //        copies the samples once
+    struct iovec p_Vector[3];
+    struct msghdr c_Message;
+
+    p_Vector[0] = { p_Header, MRH_SPEECHD_AUDIO_FRAME_HEADER_SIZE };
+    p_Vector[1] = { const_cast<MRH_Sint16*>(c_First.p_Samples), c_First.us_Samples * sizeof(MRH_Sint16) };
+    p_Vector[2] = { const_cast<MRH_Sint16*>(c_Second.p_Samples), c_Second.us_Samples * sizeof(MRH_Sint16) };
+
+    std::memset(&c_Message, 0, sizeof(c_Message));
+    c_Message.msg_iov = p_Vector;
+    c_Message.msg_iovlen = 3;
+
+    ssize_t ss_Result = sendmsg(i_FD, &c_Message, MSG_NOSIGNAL);
+
+    if (ss_Result < 0)
+    {
+        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+        {
+            return false;
+        }
+
+        MRH_LOG_ERROR("Could not write audio socket: {}", std::strerror(errno));
+
+        Disconnect();
+        return false;
+    }
+
+    // Keep the rest of a partially written frame, the frame has to be complete
+    size_t us_Written = static_cast<size_t>(ss_Result);
+
+    for (size_t i = 0; i < 3; ++i)
+    {
+        if (us_Written >= p_Vector[i].iov_len)
+        {
+            us_Written -= p_Vector[i].iov_len;
+            continue;
+        }
+
+        const MRH_Uint8* p_Part = static_cast<const MRH_Uint8*>(p_Vector[i].iov_base);
+
+        try
+        {
+            v_Pending.insert(v_Pending.end(), p_Part + us_Written, p_Part + p_Vector[i].iov_len);
+        }
+        catch (std::exception& e)
+        {
+            MRH_LOG_ERROR("Failed to keep partial audio frame: {}", e.what());
+
+            Disconnect();
+            return false;
+        }
+
+        us_Written = 0;
+    }
+
+    return true;
+}
+
+//*************************************************************************************
+// Getters
+//*************************************************************************************
+
+bool AudioStream::IsConnected() const noexcept
+{
+    return i_FD < 0 ? false : true;
+}
+
+MRH_Uint64 AudioStream::GetDropped() const noexcept
+{
+    return u64_Dropped;
+}
@@ -0,0 +1,197 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef AudioStream_h
+#define AudioStream_h
+
+// C / C++
+#include <string>
+#include <vector>
+
+// External
+#include <MRH_Typedefs.h>
+
+// Project
+#include "../Audio/AudioBuffer.h"
+#include "../Exception.h"
+
+
+class AudioStream
+{
+public:
+
+    //*************************************************************************************
+    // Types
+    //*************************************************************************************
+
+    typedef enum
+    {
+        FLAG_START = 1, // First chunk of an utterance
+        FLAG_END = 2, // Utterance finished, no samples
+        FLAG_CANCEL = 4 // Utterance cancelled, no samples
+
+    }Flag;
+
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+
+    /**
+     *  Default constructor.
+     *
+     *  \param s_SocketPath The full path to the audio stream socket.
+     */
+
+    AudioStream(std::string const& s_SocketPath);
+
+    /**
+     *  Default destructor.
+     */
+
+    ~AudioStream() noexcept;
+
+    //*************************************************************************************
+    // Write
+    //*************************************************************************************
+
+    /**
+     *  Write a recorded audio chunk of the current utterance. The chunk is dropped if 
+     *  the socket is not connected or not writable.
+     *
+     *  \param c_Buffer The recorded audio to write. The buffer is not modified.
+     */
+
+    void Write(AudioBuffer const& c_Buffer) noexcept;
+
+    /**
+     *  Finish the current utterance.
+     *
+     *  \param b_Cancelled If the utterance was cancelled.
+     */
+
+    void Finish(bool b_Cancelled) noexcept;
+
+    //*************************************************************************************
+    // Getters
+    //*************************************************************************************
+
+    /**
+     *  Check if the audio stream is connected.
+     *
+     *  \return true if connected, false if not.
+     */
+
+    bool IsConnected() const noexcept;
+
+    /**
+     *  Get the amount of chunks dropped while connected.
+     *
+     *  \return The dropped chunk count.
+     */
+
+    MRH_Uint64 GetDropped() const noexcept;
+
+private:
+
+    //*************************************************************************************
+    // Connection
+    //*************************************************************************************
+
+    /**
+     *  Connect if not connected and the next attempt is due.
+     *
+     *  \return true if connected, false if not.
+     */
+
+    bool Connect() noexcept;
+
+    /**
+     *  Close the connection.
+     */
+
+    void Disconnect() noexcept;
+
+    //*************************************************************************************
+    // Write
+    //*************************************************************************************
+
+    /**
+     *  Write the frame remaining from a previous partial write.
+     *
+     *  \return true if nothing remains, false if not.
+     */
+
+    bool WritePending() noexcept;
+
+    /**
+     *  Write the end or cancel marker of a finished utterance if one is left.
+     *
+     *  \return true if no marker is left, false if not.
+     */
+
+    bool WriteMarker() noexcept;
+
+    /**
+     *  Write a frame to the socket.
+     *
+     *  \param u8_Flags The frame flags.
+     *  \param u32_KHz The sample rate of the samples.
+     *  \param u32_Utterance The utterance the frame belongs to.
+     *  \param u64_Sample The utterance index of the first sample.
+     *  \param c_First The first sample region.
+     *  \param c_Second The second sample region.
+     *
+     *  \return true if the frame was written or queued, false if it was dropped.
+     */
+
+    bool WriteFrame(MRH_Uint8 u8_Flags,
+                    MRH_Uint32 u32_KHz,
+                    MRH_Uint32 u32_Utterance,
+                    MRH_Uint64 u64_Sample,
+                    AudioBuffer::ConstRegion const& c_First,
+                    AudioBuffer::ConstRegion const& c_Second) noexcept;
+
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+
+    std::string s_SocketPath;
+    int i_FD;
+    MRH_Uint32 u32_BackoffMS; // Delay after the next failed connect
+    MRH_Uint64 u64_ConnectUS; // Time of the next connect attempt
+
+    // @NOTE: Only filled if the socket accepted part of a frame
+    std::vector<MRH_Uint8> v_Pending;
+    size_t us_Pending;
+
+    MRH_Uint32 u32_Utterance;
+    MRH_Uint64 u64_Sample; // Next sample index in the utterance
+    bool b_Utterance;
+    bool b_Start; // No frame with the start flag was sent yet
+
+    // @NOTE: Markers are kept until sent, every utterance the receiver saw
+    //        start has to end for it
+    MRH_Uint8 u8_Marker;
+    MRH_Uint32 u32_MarkerUtterance;
+    MRH_Uint64 u64_MarkerSample;
+
+    MRH_Uint64 u64_Dropped;
+
+protected:
+
+};
+
+#endif /* AudioStream_h */
@@ -19,8 +19,11 @@
 #include <stdlib.h>
 #include <sys/socket.h>
 #include <sys/un.h>
-#include <fcntl.h>
-#include <poll.h>
+#include <sys/uio.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <limits.h>
 #include <errno.h>
 #include <cstring>
 
@@ -30,11 +33,25 @@
 // Project
 #include "./UTF8Stream.h"
 #include "../Logger.h"
+#include "../Latency.h"
 
 // Pre-defined
 #ifndef MRH_SPEECHD_CONNECT_WAIT_S
-    #define MRH_SPEECHD_CONNECT_WAIT_S 5
+    #define MRH_SPEECHD_CONNECT_WAIT_S 5 // Maximum delay between connect attempts
 #endif
+#ifndef MRH_SPEECHD_CONNECT_BACKOFF_MS
+    #define MRH_SPEECHD_CONNECT_BACKOFF_MS 10 // First delay after a failed connect
+#endif
+#define MRH_SPEECHD_STREAM_READ_SIZE MRH_EVD_L_STRING_BUFFER_MAX // Minimum free bytes per read
+#define MRH_SPEECHD_STREAM_WRITE_VECTORS 64 // Maximum parts per socket write
+#define MRH_SPEECHD_STREAM_FRAME_VERSION 1
+#define MRH_SPEECHD_STREAM_FRAME_HEADER_SIZE 5 // Version byte, 32 bit little endian length
+#define MRH_SPEECHD_STREAM_EVENT_COUNT 4
+
+namespace
+{
+    const char c_Terminator = '\0';
+}
 
 
 //*************************************************************************************
@@ -42,29 +59,109 @@
 //*************************************************************************************
 
 UTF8Stream::UTF8Stream(std::string const& s_SocketPath,
-                       std::shared_ptr<DataNotifier>& p_Notifier) : b_Read(true),
-                                                                    s_SocketPath(s_SocketPath),
-                                                                    i_FD(-1),
-                                                                    p_Notifier(p_Notifier)
+                       Framing e_Framing,
+                       size_t us_QueueSize,
+                       MRH_Uint32 u32_QueueMaxAgeS,
+                       std::string const& s_QueueFilePath,
+                       std::shared_ptr<EventQueue>& p_EventQueue,
+                       size_t us_Channel,
+                       std::shared_ptr<Latency::Marks>& p_Marks) : b_Update(true),
+                                                                   s_SocketPath(s_SocketPath),
+                                                                   e_Framing(e_Framing),
+                                                                   i_FD(-1),
+                                                                   i_EpollFD(-1),
+                                                                   i_EventFD(-1),
+                                                                   i_NotifyFD(-1),
+                                                                   i_WatchFD(-1),
+                                                                   u32_BackoffMS(MRH_SPEECHD_CONNECT_BACKOFF_MS),
+                                                                   u64_ConnectUS(0),
+                                                                   b_WaitWritable(false),
+                                                                   v_Buffer(MRH_SPEECHD_STREAM_READ_SIZE),
+                                                                   us_Start(0),
+                                                                   us_Scan(0),
+                                                                   us_End(0),
+                                                                   us_Frame(0),
+                                                                   c_WriteQueue(us_QueueSize,
+                                                                                u32_QueueMaxAgeS,
+                                                                                s_QueueFilePath),
+                                                                   p_EventQueue(p_EventQueue),
+                                                                   us_Channel(us_Channel),
+                                                                   p_Marks(p_Marks)
 {
-    // Start reader thread
+    if (e_Framing > FRAMING_MAX)
+    {
+        throw Exception("Unknown stream framing!");
+    }
+    else if (s_SocketPath.size() >= sizeof(((struct sockaddr_un*)NULL)->sun_path))
+    {
+        throw Exception("Socket path " + s_SocketPath + " is too long!");
+    }
+
+    size_t us_Name = s_SocketPath.find_last_of('/');
+    s_SocketName = (us_Name == std::string::npos ? s_SocketPath : s_SocketPath.substr(us_Name + 1));
+
+    // Create event file descriptors
+    struct epoll_event c_Event;
+
+    if ((i_EpollFD = epoll_create1(EPOLL_CLOEXEC)) < 0)
+    {
+        throw Exception("Failed to create stream epoll instance: " +
+                        std::string(std::strerror(errno)) +
+                        " (" +
+                        std::to_string(errno) +
+                        ")!");
+    }
+    else if ((i_EventFD = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) < 0 ||
+             (i_NotifyFD = inotify_init1(IN_NONBLOCK | IN_CLOEXEC)) < 0)
+    {
+        std::string s_Error = std::strerror(errno);
+
+        Close();
+        throw Exception("Failed to create stream event file descriptors: " + s_Error);
+    }
+
+    std::memset(&c_Event, 0, sizeof(c_Event));
+    c_Event.events = EPOLLIN;
+
+    c_Event.data.fd = i_EventFD;
+    if (epoll_ctl(i_EpollFD, EPOLL_CTL_ADD, i_EventFD, &c_Event) < 0)
+    {
+        std::string s_Error = std::strerror(errno);
+
+        Close();
+        throw Exception("Failed to add stream event file descriptor: " + s_Error);
+    }
+
+    c_Event.data.fd = i_NotifyFD;
+    if (epoll_ctl(i_EpollFD, EPOLL_CTL_ADD, i_NotifyFD, &c_Event) < 0)
+    {
+        std::string s_Error = std::strerror(errno);
+
+        Close();
+        throw Exception("Failed to add stream notify file descriptor: " + s_Error);
+    }
+
+    // Start stream thread
     try
     {
-        c_Thread = std::thread(Read, this);
+        c_Thread = std::thread(Update, this);
     }
     catch (std::exception& e)
     {
-        throw Exception("Failed to start socket read thread: " +
+        Close();
+        throw Exception("Failed to start socket stream thread: " +
                         std::string(e.what()));
     }
 
-    Logger::Singleton().Log(Logger::INFO, "Started stream.",
-                            "UTF8Stream.cpp", __LINE__);
+    MRH_LOG_INFO("Started stream with {} framing.", e_Framing == FRAMING_LENGTH ? "length" : "terminated");
 }
 
 UTF8Stream::~UTF8Stream() noexcept
 {
-    b_Read = false;
+    b_Update = false;
+    Wake();
+
+    c_Thread.join();
 
     if (i_FD >= 0)
     {
@@ -72,7 +169,124 @@ UTF8Stream::~UTF8Stream() noexcept
         close(i_FD);
     }
 
-    c_Thread.join();
+    Close();
+}
+
+//*************************************************************************************
+// Events
+//*************************************************************************************
+
+void UTF8Stream::Close() noexcept
+{
+    if (i_NotifyFD >= 0)
+    {
+        close(i_NotifyFD);
+        i_NotifyFD = -1;
+    }
+
+    if (i_EventFD >= 0)
+    {
+        close(i_EventFD);
+        i_EventFD = -1;
+    }
+
+    if (i_EpollFD >= 0)
+    {
+        close(i_EpollFD);
+        i_EpollFD = -1;
+    }
+}
+
+void UTF8Stream::Wake() noexcept
+{
+    MRH_Uint64 u64_Value = 1;
+
+    // @NOTE: Only fails with EAGAIN if the counter is full, already woken
+    if (write(i_EventFD, &u64_Value, sizeof(u64_Value)) < 0 && errno != EAGAIN)
+    {
+        MRH_LOG_ERROR("Failed to wake stream thread: {}", std::strerror(errno));
+    }
+}
+
+void UTF8Stream::Watch() noexcept
+{
+    if (i_WatchFD >= 0)
+    {
+        return;
+    }
+
+    size_t us_Name = s_SocketPath.find_last_of('/');
+    std::string s_DirPath;
+
+    if (us_Name == std::string::npos)
+    {
+        s_DirPath = ".";
+    }
+    else if (us_Name == 0)
+    {
+        s_DirPath = "/";
+    }
+    else
+    {
+        s_DirPath = s_SocketPath.substr(0, us_Name);
+    }
+
+    // @NOTE: The directory might not exist yet, retried on each connect attempt
+    i_WatchFD = inotify_add_watch(i_NotifyFD, s_DirPath.c_str(), IN_CREATE | IN_MOVED_TO | IN_ATTRIB);
+}
+
+bool UTF8Stream::GetSocketCreated() noexcept
+{
+    alignas(struct inotify_event) char p_Buffer[4096];
+    bool b_Created = false;
+    ssize_t ss_Read;
+
+    while ((ss_Read = read(i_NotifyFD, p_Buffer, sizeof(p_Buffer))) > 0)
+    {
+        for (char* p_Pos = p_Buffer; p_Pos < p_Buffer + ss_Read;)
+        {
+            struct inotify_event* p_Event = reinterpret_cast<struct inotify_event*>(p_Pos);
+
+            if (p_Event->mask & IN_IGNORED)
+            {
+                // Directory removed, watch again on the next attempt
+                i_WatchFD = -1;
+            }
+            else if (p_Event->len > 0 && s_SocketName.compare(p_Event->name) == 0)
+            {
+                b_Created = true;
+            }
+
+            p_Pos += sizeof(struct inotify_event) + p_Event->len;
+        }
+    }
+
+    return b_Created;
+}
+
+void UTF8Stream::SetWaitWritable(bool b_Writable)
+{
+    if (b_WaitWritable == b_Writable)
+    {
+        return;
+    }
+
+    struct epoll_event c_Event;
+    std::memset(&c_Event, 0, sizeof(c_Event));
+
+    c_Event.events = EPOLLIN | (b_Writable == true ? static_cast<uint32_t>(EPOLLOUT) : 0u);
+    c_Event.data.fd = i_FD;
+
+    if (epoll_ctl(i_EpollFD, EPOLL_CTL_MOD, i_FD, &c_Event) < 0)
+    {
+        throw Exception("Failed to update socket events: " +
+                        std::string(std::strerror(errno)) +
+                        " (" +
+                        std::to_string(errno) +
+                        ")!");
+    }
+
+    b_WaitWritable = b_Writable;
 }
 
 //*************************************************************************************
@@ -86,7 +300,7 @@ void UTF8Stream::Connect()
     struct sockaddr_un c_Address;
     socklen_t us_AddressLength;
 
-    if ((i_FD = socket(AF_UNIX, SOCK_STREAM, 0)) < 0)
+    if ((i_FD = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0)) < 0)
     {
         throw Exception("Could not create socket: " +
                         std::string(std::strerror(errno)) +
@@ -100,87 +314,130 @@ void UTF8Stream::Connect()
     c_Address.sun_family = AF_UNIX;
     strcpy(c_Address.sun_path, s_SocketPath.c_str());
 
+    // @NOTE: Local sockets connect immediately, EAGAIN means a full backlog
     if (connect(i_FD, (struct sockaddr*)&c_Address, us_AddressLength) < 0)
     {
+        int i_Error = errno;
         close(i_FD);
         
         throw Exception("Could not connect to socket: " +
-                        std::string(std::strerror(errno)) +
+                        std::string(std::strerror(i_Error)) +
                         " (" +
-                        std::to_string(errno) +
+                        std::to_string(i_Error) +
                         ")");
     }
-    else if (fcntl(i_FD, F_SETFL, fcntl(i_FD, F_GETFL, 0) | O_NONBLOCK) < 0)
+
+    struct epoll_event c_Event;
+    std::memset(&c_Event, 0, sizeof(c_Event));
+
+    c_Event.events = EPOLLIN;
+    c_Event.data.fd = i_FD;
+
+    if (epoll_ctl(i_EpollFD, EPOLL_CTL_ADD, i_FD, &c_Event) < 0)
     {
+        int i_Error = errno;
+
         shutdown(i_FD, SHUT_RDWR);
         close(i_FD);
 
-        throw Exception("Could not set socket non-blocking: " +
-                        std::string(std::strerror(errno)) +
+        throw Exception("Could not add socket events: " +
+                        std::string(std::strerror(i_Error)) +
                         " (" +
-                        std::to_string(errno) +
+                        std::to_string(i_Error) +
                         ")");
     }
 
+    // Drop partial messages of the previous connection
+    us_Start = 0;
+    us_Scan = 0;
+    us_End = 0;
+    us_Frame = 0;
+    b_WaitWritable = false;
+
     this->i_FD = i_FD;
 }
 
-void UTF8Stream::Disconnect() noexcept
+void UTF8Stream::Reconnect() noexcept
 {
-    if (i_FD < 0)
+    Watch();
+
+    try
     {
+        Connect();
+    }
+    catch (Exception& e)
+    {
+        // Log the first failure and the slowest retries only
+        if (u32_BackoffMS == MRH_SPEECHD_CONNECT_BACKOFF_MS || u32_BackoffMS == MRH_SPEECHD_CONNECT_WAIT_S * 1000)
+        {
+            MRH_LOG_ERROR("{}", e.what());
+        }
+
+        u64_ConnectUS = Latency::GetTime() + (u32_BackoffMS * 1000ULL);
+        u32_BackoffMS *= 2;
+
+        if (u32_BackoffMS > MRH_SPEECHD_CONNECT_WAIT_S * 1000)
+        {
+            u32_BackoffMS = MRH_SPEECHD_CONNECT_WAIT_S * 1000;
+        }
+
         return;
     }
 
-    shutdown(i_FD, SHUT_RDWR);
-    close(i_FD);
+    u32_BackoffMS = MRH_SPEECHD_CONNECT_BACKOFF_MS;
 
-    i_FD = -1;
+    // Messages queued before connecting are replayed
+    size_t us_Queued;
 
-    Logger::Singleton().Log(Logger::INFO, "Closed connection.",
-                            "UTF8Stream.cpp", __LINE__);
+    {
+        std::lock_guard<std::mutex> c_Guard(c_WriteMutex);
 
-    p_Notifier->Notify(true); // Notify for method switch
-}
+        c_WriteQueue.SetReplay();
+        us_Queued = c_WriteQueue.GetCount();
+    }
 
-//*************************************************************************************
-// Read
-//*************************************************************************************
+    MRH_LOG_INFO("Connected to socket {}, replaying {} queued messages.", s_SocketPath, us_Queued);
 
-bool UTF8Stream::PollSocket(int i_FD)
+    // New connection, notify
+    p_EventQueue->Notify(EventQueue::EVENT_CONNECTION, us_Channel);
+}
+
+void UTF8Stream::Disconnect() noexcept
 {
-    struct pollfd c_PollFD;
+    if (i_FD < 0)
+    {
+        return;
+    }
 
-    c_PollFD.fd = i_FD;
-    c_PollFD.events = POLLIN;
+    // @NOTE: Closing removes the socket from the epoll instance
+    shutdown(i_FD, SHUT_RDWR);
+    close(i_FD);
 
-    int i_Result = poll(&c_PollFD, (nfds_t)1, -1);
+    i_FD = -1;
 
-    switch (i_Result)
-    {
-        case -1:
-            throw Exception("Failed to poll socket: " +
-                            std::string(std::strerror(errno)) +
-                            " (" +
-                            std::to_string(errno) +
-                            ")!");
+    // Retry immediately, the service might only have closed this connection
+    u64_ConnectUS = 0;
 
-        case 0:
-            return false;
+    // @NOTE: The receiver drops partial messages, a partially written
+    //        message is written again after reconnecting
+    size_t us_Queued;
 
-        default:
-            if (c_PollFD.revents & POLLERR || /* Polling error */
-                c_PollFD.revents & POLLHUP || /* Other end closed */
-                c_PollFD.revents & POLLNVAL)  /* EBADF */
-            {
-                throw Exception("Failed to poll socket: Returned event " +
-                                std::to_string(c_PollFD.revents) +
-                                "!");
-            }
-            return true;
+    {
+        std::lock_guard<std::mutex> c_Guard(c_WriteMutex);
+
+        c_WriteQueue.SetWritten(0);
+        us_Queued = c_WriteQueue.GetCount();
     }
+
+    MRH_LOG_INFO("Closed connection, keeping {} queued messages.", us_Queued);
+
+    p_EventQueue->Notify(EventQueue::EVENT_CONNECTION, us_Channel);
 }
 
+//*************************************************************************************
+// Read
+//*************************************************************************************
+
 ssize_t UTF8Stream::ReadSocket(int i_FD, char* p_Buffer, size_t us_Length)
 {
     ssize_t ss_Total = 0;
@@ -227,138 +484,146 @@ ssize_t UTF8Stream::ReadSocket(int i_FD, char* p_Buffer, size_t us_Length)
     return ss_Total;
 }
 
-void UTF8Stream::Read(UTF8Stream* p_Instance) noexcept
+void UTF8Stream::PrepareBuffer()
 {
-    Logger& c_Logger = Logger::Singleton();
+    // Everything consumed, start over without moving bytes
+    if (us_Start == us_End)
+    {
+        us_Start = 0;
+        us_Scan = 0;
+        us_End = 0;
+    }
 
-    // Buffer size matches max string message data
-    char p_Buffer[MRH_EVD_L_STRING_BUFFER_MAX] = { '\0' };
-    size_t us_BufferPos = 0;
+    size_t us_Required = (us_End - us_Start) + MRH_SPEECHD_STREAM_READ_SIZE;
 
-    while (p_Instance->b_Read == true)
+    if (us_Required < us_Frame)
     {
-        /**
-         *  Connect
-         */
-
-        if (p_Instance->i_FD < 0)
-        {
-            // Wait before connecting, so that socket spawns
-            std::this_thread::sleep_for(std::chrono::seconds(MRH_SPEECHD_CONNECT_WAIT_S));
+        us_Required = us_Frame;
+    }
 
-            c_Logger.Log(Logger::INFO, "Attempting to connect to socket " +
-                                       p_Instance->s_SocketPath +
-                                       "...",
-                         "UTF8Stream.cpp", __LINE__);
+    if (v_Buffer.size() - us_Start >= us_Required)
+    {
+        return;
+    }
 
-            // Attempt to connect
-            try
-            {
-                // Attempt to connect
-                p_Instance->Connect();
+    // Move the incomplete message to the front, only done once the end 
+    // of the buffer is reached
+    if (us_Start > 0)
+    {
+        std::memmove(v_Buffer.data(), &(v_Buffer[us_Start]), us_End - us_Start);
 
-                // New connection, notify all
-                p_Instance->p_Notifier->Notify(true);
-            }
-            catch (Exception& e)
-            {
-                c_Logger.Log(Logger::ERROR, e.what(),
-                             "UTF8Stream.cpp", __LINE__);
-                continue;
-            }
-        }
+        us_Scan -= us_Start;
+        us_End -= us_Start;
+        us_Start = 0;
+    }
 
-        /**
-         *  Read
-         */
+    if (v_Buffer.size() < us_Required)
+    {
+        v_Buffer.resize(us_Required);
+    }
+}
 
-        try
+bool UTF8Stream::GetNextMessage(size_t& us_Message, size_t& us_Length)
+{
+    if (e_Framing == FRAMING_LENGTH)
+    {
+        if (us_End - us_Start < MRH_SPEECHD_STREAM_FRAME_HEADER_SIZE)
         {
-            // Poll for data first
-            if (p_Instance->PollSocket(p_Instance->i_FD) == false)
-            {
-                continue;
-            }
+            return false;
+        }
 
-            // Data available, read
-            ssize_t ss_Read = p_Instance->ReadSocket(p_Instance->i_FD,
-                                                     &(p_Buffer[us_BufferPos]),
-                                                     MRH_EVD_L_STRING_BUFFER_MAX - us_BufferPos);
+        const MRH_Uint8* p_Header = reinterpret_cast<const MRH_Uint8*>(&(v_Buffer[us_Start]));
 
-            // Add new byte info
-            us_BufferPos += ss_Read;
-        }
-        catch (Exception& e)
+        if (p_Header[0] != MRH_SPEECHD_STREAM_FRAME_VERSION)
         {
-            c_Logger.Log(Logger::ERROR, e.what(),
-                         "UTF8Stream.cpp", __LINE__);
-
-            p_Instance->Disconnect();
-            continue;
+            throw Exception("Unsupported stream frame version " +
+                            std::to_string(p_Header[0]) +
+                            "!");
         }
 
-        /**
-         *  Add
-         */
+        us_Length = static_cast<size_t>(p_Header[1]) |
+                    (static_cast<size_t>(p_Header[2]) << 8) |
+                    (static_cast<size_t>(p_Header[3]) << 16) |
+                    (static_cast<size_t>(p_Header[4]) << 24);
+        us_Frame = MRH_SPEECHD_STREAM_FRAME_HEADER_SIZE + us_Length;
 
-        // Can we work with the received data?
-        if (us_BufferPos == MRH_EVD_L_STRING_BUFFER_MAX) // Buffer full, create now
+        // Wait for the full frame, the buffer grows to fit it
+        if (us_End - us_Start < us_Frame)
         {
-            p_Instance->p_Notifier->Notify(true);
+            return false;
+        }
 
-            {
-                std::lock_guard<std::mutex> c_Guard(p_Instance->c_Mutex);
+        us_Message = us_Start + MRH_SPEECHD_STREAM_FRAME_HEADER_SIZE;
+        us_Start += us_Frame;
+        us_Scan = us_Start;
+        us_Frame = 0;
 
-                p_Instance->dq_Read.emplace_back(p_Buffer,
-                                                 p_Buffer + us_BufferPos);
-            }
+        return true;
+    }
 
-            us_BufferPos = 0;
-        }
-        else if (us_BufferPos > 0) // Data available, find terminator
-        {
-            // Find buffer end first
-            size_t us_StringEnd = 0;
+    // Only search bytes not checked by a previous read
+    const char* p_End = static_cast<const char*>(std::memchr(&(v_Buffer[us_Scan]), '\0', us_End - us_Scan));
 
-            for (; us_StringEnd < us_BufferPos; ++us_StringEnd)
-            {
-                if (p_Buffer[us_StringEnd] == '\0')
-                {
-                    break;
-                }
-            }
+    if (p_End != NULL)
+    {
+        us_Message = us_Start;
+        us_Length = p_End - &(v_Buffer[us_Start]);
+        us_Start += us_Length + 1;
+        us_Scan = us_Start;
 
-            // No terminator yet?
-            if (us_StringEnd == us_BufferPos)
-            {
-                // Need more data
-                continue;
-            }
+        return true;
+    }
 
-            // Notify, this stream does something
-            p_Instance->p_Notifier->Notify(true);
+    us_Scan = us_End;
 
-            // Usable message?
-            if (us_StringEnd > 0)
-            {
-                std::lock_guard<std::mutex> c_Guard(p_Instance->c_Mutex);
+    // Messages filling the whole event string are not terminated
+    if (us_End - us_Start >= MRH_EVD_L_STRING_BUFFER_MAX)
+    {
+        us_Message = us_Start;
+        us_Length = MRH_EVD_L_STRING_BUFFER_MAX;
+        us_Start += us_Length;
 
-                p_Instance->dq_Read.emplace_back(p_Buffer,
-                                                 p_Buffer + us_StringEnd);
-            }
+        return true;
+    }
 
-            // Copy following characters to start
-            size_t us_Following = us_BufferPos - (us_StringEnd + 1);
+    return false;
+}
 
-            if (us_Following > 0)
-            {
-                std::memmove(p_Buffer, &(p_Buffer[us_StringEnd + 1]), us_Following);
-                std::memset(&(p_Buffer[us_Following]), '\0', us_BufferPos - us_Following);
-            }
+size_t UTF8Stream::AddMessages()
+{
+    size_t us_Added = 0;
+    size_t us_Message;
+    size_t us_Length;
 
-            // Set to point after last following byte
-            us_BufferPos = us_Following;
+    while (GetNextMessage(us_Message, us_Length) == true)
+    {
+        // Skip empty messages
+        if (us_Length == 0)
+        {
+            continue;
         }
+
+        // @NOTE: Single copy from the receive buffer to the message
+        std::lock_guard<std::mutex> c_Guard(c_Mutex);
+
+        dq_Read.emplace_back(&(v_Buffer[us_Message]), us_Length);
+        ++us_Added;
+    }
+
+    return us_Added;
+}
+
+void UTF8Stream::Read()
+{
+    PrepareBuffer();
+
+    us_End += ReadSocket(i_FD, &(v_Buffer[us_End]), v_Buffer.size() - us_End);
+
+    // @NOTE: Notify after adding, the messages have to be available
+    if (AddMessages() > 0)
+    {
+        p_Marks->Set(Latency::MARK_MESSAGE_READ);
+        p_EventQueue->Notify(EventQueue::EVENT_MESSAGE, us_Channel);
     }
 }
 
@@ -368,44 +633,112 @@ void UTF8Stream::Read(UTF8Stream* p_Instance) noexcept
 
 void UTF8Stream::Write(std::string const& s_Message)
 {
-    if (i_FD < 0)
+    if (s_Message.empty() == true)
     {
-        throw Exception("Cannot write message while not connected!");
+        throw Exception("Attempted to write empty message!");
     }
-    else if (s_Message.empty() == true)
+    else if (e_Framing == FRAMING_LENGTH && s_Message.size() > 0xFFFFFFFF)
     {
-        throw Exception("Attempted to write empty message!");
+        throw Exception("Message exceeds the frame length!");
     }
-    
-    size_t us_Total = s_Message.size() + 1; // Write terminator as well if possible!
 
-    char p_Buffer[MRH_EVD_L_STRING_BUFFER_MAX];
-    std::strncpy(p_Buffer, s_Message.c_str(), MRH_EVD_L_STRING_BUFFER_MAX);
+    {
+        std::lock_guard<std::mutex> c_Guard(c_WriteMutex);
+        c_WriteQueue.Add(s_Message);
+    }
+
+    Wake();
+}
 
-    if (us_Total <= MRH_EVD_L_STRING_BUFFER_MAX)
+void UTF8Stream::GetFrame(std::string const& s_Message, MRH_Uint8* p_Prefix, size_t& us_Prefix, size_t& us_Message, size_t& us_Suffix) noexcept
+{
+    if (e_Framing == FRAMING_LENGTH)
     {
-        p_Buffer[(us_Total - 1)] = '\0'; // Important, signals end to receiver for short string
+        MRH_Uint32 u32_Length = static_cast<MRH_Uint32>(s_Message.size());
+
+        p_Prefix[0] = MRH_SPEECHD_STREAM_FRAME_VERSION;
+        p_Prefix[1] = static_cast<MRH_Uint8>(u32_Length);
+        p_Prefix[2] = static_cast<MRH_Uint8>(u32_Length >> 8);
+        p_Prefix[3] = static_cast<MRH_Uint8>(u32_Length >> 16);
+        p_Prefix[4] = static_cast<MRH_Uint8>(u32_Length >> 24);
+
+        us_Prefix = MRH_SPEECHD_STREAM_FRAME_HEADER_SIZE;
+        us_Message = s_Message.size();
+        us_Suffix = 0;
+    }
+    else if (s_Message.size() < MRH_EVD_L_STRING_BUFFER_MAX)
+    {
+        // Terminator signals the end to the receiver for short strings
+        us_Prefix = 0;
+        us_Message = s_Message.size();
+        us_Suffix = 1;
     }
     else
     {
-        us_Total = MRH_EVD_L_STRING_BUFFER_MAX;
+        // Truncated to the event string size, a full string is not terminated
+        us_Prefix = 0;
+        us_Message = MRH_EVD_L_STRING_BUFFER_MAX;
+        us_Suffix = 0;
     }
+}
 
-    size_t us_Written = 0;
-    ssize_t ss_Result;
+bool UTF8Stream::WriteSocket()
+{
+    struct iovec p_Vector[MRH_SPEECHD_STREAM_WRITE_VECTORS];
+    MRH_Uint8 p_Prefix[MRH_SPEECHD_STREAM_WRITE_VECTORS / 3][MRH_SPEECHD_STREAM_FRAME_HEADER_SIZE];
+    size_t p_Total[MRH_SPEECHD_STREAM_WRITE_VECTORS / 3];
+    size_t us_Count = 0;
 
-    while (us_Written < us_Total)
+    // @NOTE: Locked while writing, the queue might drop messages when 
+    //        full. The socket is non-blocking, the write never waits
+    std::lock_guard<std::mutex> c_Guard(c_WriteMutex);
+
+    // Replayed messages might have become too old
+    c_WriteQueue.Expire();
+
+    for (size_t i = 0; i < c_WriteQueue.GetCount() && i < MRH_SPEECHD_STREAM_WRITE_VECTORS / 3; ++i)
     {
-        // @NOTE: Use MSG_NOSIGNAL, client might close socket
-        ss_Result = send(i_FD, &(p_Buffer[us_Written]), (us_Total - us_Written), MSG_NOSIGNAL);
+        std::string const& s_Message = c_WriteQueue.GetMessage(i);
+        size_t p_Size[3];
+
+        GetFrame(s_Message, p_Prefix[i], p_Size[0], p_Size[1], p_Size[2]);
+        p_Total[i] = p_Size[0] + p_Size[1] + p_Size[2];
 
-        if (ss_Result >= 0)
+        void* p_Part[3] = { p_Prefix[i], const_cast<char*>(s_Message.data()), const_cast<char*>(&c_Terminator) };
+        size_t us_Offset = (i == 0 ? c_WriteQueue.GetWritten() : 0);
+
+        for (size_t j = 0; j < 3; ++j)
         {
-            us_Written += ss_Result;
-            continue;
+            if (us_Offset >= p_Size[j])
+            {
+                us_Offset -= p_Size[j];
+                continue;
+            }
+
+            p_Vector[us_Count].iov_base = static_cast<char*>(p_Part[j]) + us_Offset;
+            p_Vector[us_Count].iov_len = p_Size[j] - us_Offset;
+            us_Offset = 0;
+            ++us_Count;
         }
+    }
+
+    if (us_Count == 0)
+    {
+        return true;
+    }
+
+    // @NOTE: Gathered write of all queued messages, sendmsg() instead of 
+    //        writev() for MSG_NOSIGNAL since the client might close the socket
+    struct msghdr c_Message;
+    std::memset(&c_Message, 0, sizeof(c_Message));
+
+    c_Message.msg_iov = p_Vector;
+    c_Message.msg_iovlen = us_Count;
 
-        // Failed to write
+    ssize_t ss_Result = sendmsg(i_FD, &c_Message, MSG_NOSIGNAL);
+
+    if (ss_Result < 0)
+    {
         switch (errno)
         {
 #if EAGAIN != EWOULDBLOCK
@@ -414,14 +747,12 @@ void UTF8Stream::Write(std::string const& s_Message)
             case EAGAIN:
             case EINTR:
             {
-                break;
+                // Wait for the socket to be writable
+                return false;
             }
 
             default: // + EPIPE
             {
-                // Close socket, broken
-                Disconnect();
-
                 throw Exception("Could not write socket: " +
                                 std::string(std::strerror(errno)) +
                                 " (" +
@@ -430,6 +761,138 @@ void UTF8Stream::Write(std::string const& s_Message)
             }
         }
     }
+
+    // Remove written messages
+    size_t us_Written = static_cast<size_t>(ss_Result);
+
+    for (size_t i = 0; us_Written > 0; ++i)
+    {
+        size_t us_Remaining = p_Total[i] - c_WriteQueue.GetWritten();
+
+        if (us_Written < us_Remaining)
+        {
+            c_WriteQueue.SetWritten(c_WriteQueue.GetWritten() + us_Written);
+            break;
+        }
+
+        us_Written -= us_Remaining;
+        c_WriteQueue.Remove();
+    }
+
+    return c_WriteQueue.GetCount() == 0;
+}
+
+//*************************************************************************************
+// Update
+//*************************************************************************************
+
+void UTF8Stream::Update(UTF8Stream* p_Instance) noexcept
+{
+    struct epoll_event p_Event[MRH_SPEECHD_STREAM_EVENT_COUNT];
+    MRH_Uint64 u64_Value;
+
+    MRH_LOG_INFO("Connecting to socket {}...", p_Instance->s_SocketPath);
+
+    while (p_Instance->b_Update == true)
+    {
+        /**
+         *  Connect
+         */
+
+        int i_TimeoutMS = -1;
+
+        if (p_Instance->i_FD < 0)
+        {
+            if (Latency::GetTime() >= p_Instance->u64_ConnectUS)
+            {
+                p_Instance->Reconnect();
+            }
+
+            // Connected, write queued messages without waiting. Otherwise
+            // wait until the next attempt or the socket file is created
+            if (p_Instance->i_FD >= 0)
+            {
+                i_TimeoutMS = 0;
+            }
+            else
+            {
+                MRH_Uint64 u64_TimeUS = Latency::GetTime();
+
+                i_TimeoutMS = 0;
+
+                if (p_Instance->u64_ConnectUS > u64_TimeUS)
+                {
+                    i_TimeoutMS = static_cast<int>((p_Instance->u64_ConnectUS - u64_TimeUS + 999) / 1000);
+                }
+            }
+        }
+
+        /**
+         *  Wait
+         */
+
+        int i_Count = epoll_wait(p_Instance->i_EpollFD, p_Event, MRH_SPEECHD_STREAM_EVENT_COUNT, i_TimeoutMS);
+
+        if (i_Count < 0)
+        {
+            if (errno != EINTR)
+            {
+                MRH_LOG_ERROR("Failed to wait for stream events: {}", std::strerror(errno));
+                std::this_thread::sleep_for(std::chrono::milliseconds(MRH_SPEECHD_CONNECT_BACKOFF_MS));
+            }
+            continue;
+        }
+
+        try
+        {
+            for (int i = 0; i < i_Count; ++i)
+            {
+                if (p_Event[i].data.fd == p_Instance->i_EventFD)
+                {
+                    // Woken for new messages or shutdown
+                    while (read(p_Instance->i_EventFD, &u64_Value, sizeof(u64_Value)) > 0)
+                    {}
+                }
+                else if (p_Event[i].data.fd == p_Instance->i_NotifyFD)
+                {
+                    // Socket file created, connect without waiting
+                    if (p_Instance->GetSocketCreated() == true && p_Instance->i_FD < 0)
+                    {
+                        p_Instance->u64_ConnectUS = 0;
+                    }
+                }
+                else if (p_Event[i].data.fd == p_Instance->i_FD)
+                {
+                    // @NOTE: Read on errors too, reading reports the error
+                    if (p_Event[i].events & (EPOLLIN | EPOLLERR | EPOLLHUP))
+                    {
+                        p_Instance->Read();
+                    }
+                }
+            }
+
+            /**
+             *  Write
+             */
+
+            if (p_Instance->i_FD >= 0)
+            {
+                p_Instance->SetWaitWritable(!(p_Instance->WriteSocket()));
+            }
+        }
+        catch (Exception& e)
+        {
+            MRH_LOG_ERROR("{}", e.what());
+
+            p_Instance->Disconnect();
+        }
+        catch (std::exception& e)
+        {
+            MRH_LOG_ERROR("Failed to update stream: {}", e.what());
+
+            p_Instance->Disconnect();
+        }
+    }
 }
 
 //*************************************************************************************
@@ -457,8 +920,25 @@ std::string UTF8Stream::GetMessage()
         throw Exception("No messages available!");
     }
 
-    std::string s_String(dq_Read.front());
+    std::string s_String(std::move(dq_Read.front()));
     dq_Read.pop_front();
 
     return s_String;
 }
+
+size_t UTF8Stream::GetQueued() noexcept
+{
+    std::lock_guard<std::mutex> c_Guard(c_WriteMutex);
+
+    return c_WriteQueue.GetCount();
+}
+
+MRH_Uint64 UTF8Stream::GetDropped() noexcept
+{
+    return c_WriteQueue.GetDropped();
+}
+
+MRH_Uint64 UTF8Stream::GetReplayed() noexcept
+{
+    return c_WriteQueue.GetReplayed();
+}
@@ -29,7 +29,9 @@
 // External
 
 // Project
-#include "../DataNotifier.h"
+#include "./WriteQueue.h"
+#include "../EventQueue.h"
+#include "../Latency.h"
 #include "../Exception.h"
 
 
@@ -37,6 +39,21 @@ class UTF8Stream
 {
 public:
 
+    //*************************************************************************************
+    // Types
+    //*************************************************************************************
+
+    typedef enum
+    {
+        FRAMING_TERMINATED = 0, // NUL terminated, limited to the event string size
+        FRAMING_LENGTH = 1, // Version and length header, any size
+
+        FRAMING_MAX = FRAMING_LENGTH,
+
+        FRAMING_COUNT = FRAMING_MAX + 1
+
+    }Framing;
+
     //*************************************************************************************
     // Destructor
     //*************************************************************************************
@@ -45,11 +62,23 @@ public:
      *  Default constructor.
      *
      *  \param s_SocketPath The full path to the UTF-8 stream socket.
-     *  \param p_Notifier The notifier to notify when receiving new messages.
+     *  \param e_Framing The message framing used on the socket.
+     *  \param us_QueueSize The maximum size of all queued messages in bytes.
+     *  \param u32_QueueMaxAgeS The maximum age of a queued message in seconds, 0 for no limit.
+     *  \param s_QueueFilePath The full path to the queue file. null keeps the queue in memory.
+     *  \param p_EventQueue The event queue to notify of messages and connection changes.
+     *  \param us_Channel The event queue channel to notify.
+     *  \param p_Marks The latency marks to set once messages were read.
      */
 
     UTF8Stream(std::string const& s_SocketPath,
-               std::shared_ptr<DataNotifier>& p_Notifier);
+               Framing e_Framing,
+               size_t us_QueueSize,
+               MRH_Uint32 u32_QueueMaxAgeS,
+               std::string const& s_QueueFilePath,
+               std::shared_ptr<EventQueue>& p_EventQueue,
+               size_t us_Channel,
+               std::shared_ptr<Latency::Marks>& p_Marks);
 
     /**
      *  Default destructor.
@@ -62,8 +91,9 @@ public:
     //*************************************************************************************
 
     /**
-     *  Write to the UTF-8 stream. This function blocks until all data was written. This
-     *  function is thread safe.
+     *  Queue a message for the UTF-8 stream. The message is written by the stream 
+     *  thread once the socket is writable. Messages queued while disconnected are 
+     *  written after reconnecting. This function is thread safe.
      *
      *  \param s_Message The message to write to the stream.
      */
@@ -98,8 +128,70 @@ public:
 
     std::string GetMessage();
 
+    /**
+     *  Get the amount of queued messages not yet written.
+     *
+     *  \return The queued message count.
+     */
+
+    size_t GetQueued() noexcept;
+
+    /**
+     *  Get the amount of queued messages dropped due to the queue limits.
+     *
+     *  \return The dropped message count.
+     */
+
+    MRH_Uint64 GetDropped() noexcept;
+
+    /**
+     *  Get the amount of queued messages written after a reconnect.
+     *
+     *  \return The replayed message count.
+     */
+
+    MRH_Uint64 GetReplayed() noexcept;
+
 private:
 
+    //*************************************************************************************
+    // Events
+    //*************************************************************************************
+
+    /**
+     *  Close all event file descriptors.
+     */
+
+    void Close() noexcept;
+
+    /**
+     *  Wake the stream thread.
+     */
+
+    void Wake() noexcept;
+
+    /**
+     *  Watch the socket directory for the socket file to be created.
+     */
+
+    void Watch() noexcept;
+
+    /**
+     *  Read all pending socket directory changes.
+     *
+     *  \return true if the socket file was created, false if not.
+     */
+
+    bool GetSocketCreated() noexcept;
+
+    /**
+     *  Set if the stream thread waits for the socket to be writable.
+     *
+     *  \param b_Writable true to wait for the socket to be writable, false if not.
+     */
+
+    void SetWaitWritable(bool b_Writable);
+
     //*************************************************************************************
     // Connection
     //*************************************************************************************
@@ -110,6 +202,12 @@ private:
 
     void Connect();
 
+    /**
+     *  Attempt to connect. The next attempt is delayed on failure.
+     */
+
+    void Reconnect() noexcept;
+
     /**
      *  Disconnect the connection and notify.
      */
@@ -120,16 +218,6 @@ private:
     // Read
     //*************************************************************************************
 
-    /**
-     *  Poll a file descriptor for available data.
-     *
-     *  \param i_FD The file descriptor to poll.
-     *
-     *  \return true if data is available, false if not.
-     */
-
-    bool PollSocket(int i_FD);
-
     /**
      *  Read from a socket.
      *
@@ -143,26 +231,110 @@ private:
     ssize_t ReadSocket(int i_FD, char* p_Buffer, size_t us_Length);
 
     /**
-     *  Read from the UTF-8 stream.
+     *  Prepare the receive buffer for the next read. Consumed bytes are 
+     *  dropped and the buffer grows to fit the current message.
+     */
+
+    void PrepareBuffer();
+
+    /**
+     *  Add all complete messages in the receive buffer.
      *
-     *  \param p_Instance The class instance to read with.
+     *  \return The amount of messages added.
      */
 
-    static void Read(UTF8Stream* p_Instance) noexcept;
+    size_t AddMessages();
+
+    /**
+     *  Get the next complete message in the receive buffer.
+     *
+     *  \param us_Message The message start position.
+     *  \param us_Length The message length in bytes.
+     *
+     *  \return true if a message was found, false if more data is required.
+     */
+
+    bool GetNextMessage(size_t& us_Message, size_t& us_Length);
+
+    /**
+     *  Read all available messages from the socket.
+     */
+
+    void Read();
+
+    //*************************************************************************************
+    // Write
+    //*************************************************************************************
+
+    /**
+     *  Get the framing of a message.
+     *
+     *  \param s_Message The message to frame.
+     *  \param p_Prefix The frame header to set.
+     *  \param us_Prefix The frame header size in bytes.
+     *  \param us_Message The message bytes to write.
+     *  \param us_Suffix The terminator size in bytes.
+     */
+
+    void GetFrame(std::string const& s_Message, MRH_Uint8* p_Prefix, size_t& us_Prefix, size_t& us_Message, size_t& us_Suffix) noexcept;
+
+    /**
+     *  Write as many queued messages as possible to the socket.
+     *
+     *  \return true if all queued messages were written, false if not.
+     */
+
+    bool WriteSocket();
+
+    //*************************************************************************************
+    // Update
+    //*************************************************************************************
+
+    /**
+     *  Update the UTF-8 stream.
+     *
+     *  \param p_Instance The class instance to update.
+     */
+
+    static void Update(UTF8Stream* p_Instance) noexcept;
 
     //*************************************************************************************
     // Data
     //*************************************************************************************
 
     std::thread c_Thread;
-    std::atomic<bool> b_Read;
+    std::atomic<bool> b_Update;
 
     std::string s_SocketPath;
+    std::string s_SocketName; // File name in the watched directory
+    Framing e_Framing;
     std::atomic<int> i_FD;
 
+    int i_EpollFD;
+    int i_EventFD;
+    int i_NotifyFD;
+
+    // @NOTE: Only used by the stream thread
+    int i_WatchFD;
+    MRH_Uint32 u32_BackoffMS; // Delay after the next failed connect
+    MRH_Uint64 u64_ConnectUS; // Time of the next connect attempt
+    bool b_WaitWritable;
+
+    std::vector<char> v_Buffer;
+    size_t us_Start; // Current message start
+    size_t us_Scan; // Next byte to search for a terminator
+    size_t us_End; // End of received bytes
+    size_t us_Frame; // Size of the current length framed message, 0 if unknown
+
     std::mutex c_Mutex;
     std::deque<std::string> dq_Read;
-    std::shared_ptr<DataNotifier> p_Notifier;
+
+    std::mutex c_WriteMutex;
+    WriteQueue c_WriteQueue;
+
+    std::shared_ptr<EventQueue> p_EventQueue;
+    size_t us_Channel;
+    std::shared_ptr<Latency::Marks> p_Marks;
 
 protected:
 
@@ -0,0 +1,417 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <cstring>
+#include <cerrno>
+#include <chrono>
+
+// External
+
+// Project
+#include "./WriteQueue.h"
+#include "../Logger.h"
+
+// Pre-defined
+#define WRITE_QUEUE_FILE_MAGIC 0x5148524D // MRHQ
+#define WRITE_QUEUE_FILE_VERSION 1
+#define WRITE_QUEUE_RECORD_HEADER_SIZE 12 // 64 bit time, 32 bit length
+
+// Namespace
+namespace
+{
+    // @NOTE: Queue files store the header followed by the records, each 
+    //        record is the native endian time and length and the message
+    struct FileHeader
+    {
+        MRH_Uint32 u32_Magic;
+        MRH_Uint32 u32_Version;
+        MRH_Uint64 u64_Start;
+        MRH_Uint64 u64_End;
+    };
+
+    inline size_t GetRecordSize(std::string const& s_Message) noexcept
+    {
+        return WRITE_QUEUE_RECORD_HEADER_SIZE + s_Message.size();
+    }
+}
+
+
+//*************************************************************************************
+// Constructor / Destructor
+//*************************************************************************************
+
+WriteQueue::WriteQueue(size_t us_MaxSize,
+                       MRH_Uint32 u32_MaxAgeS,
+                       std::string const& s_FilePath) : us_Size(0),
+                                                        us_MaxSize(us_MaxSize),
+                                                        u64_MaxAgeUS(u32_MaxAgeS * 1000000ULL),
+                                                        us_Written(0),
+                                                        us_Replay(0),
+                                                        u64_Dropped(0),
+                                                        u64_Replayed(0),
+                                                        i_FD(-1),
+                                                        p_File(NULL),
+                                                        us_FileSize(0),
+                                                        us_Start(0),
+                                                        us_End(0)
+{
+    if (us_MaxSize <= WRITE_QUEUE_RECORD_HEADER_SIZE || us_MaxSize > 0xFFFFFFFF)
+    {
+        throw Exception("Invalid write queue size " + std::to_string(us_MaxSize) + "!");
+    }
+
+    if (s_FilePath.empty() == false && s_FilePath.compare("null") != 0)
+    {
+        try
+        {
+            Open(s_FilePath);
+            Load();
+        }
+        catch (...)
+        {
+            if (p_File != NULL)
+            {
+                munmap(p_File, us_FileSize);
+            }
+
+            if (i_FD >= 0)
+            {
+                close(i_FD);
+            }
+
+            throw;
+        }
+    }
+}
+
+WriteQueue::~WriteQueue() noexcept
+{
+    if (p_File != NULL)
+    {
+        munmap(p_File, us_FileSize);
+    }
+
+    if (i_FD >= 0)
+    {
+        close(i_FD);
+    }
+}
+
+//*************************************************************************************
+// Queue
+//*************************************************************************************
+
+void WriteQueue::Add(std::string const& s_Message)
+{
+    size_t us_Record = GetRecordSize(s_Message);
+
+    if (us_Record > us_MaxSize)
+    {
+        ++u64_Dropped;
+        throw Exception("Message exceeds the write queue size!");
+    }
+
+    Expire();
+
+    // Make room, the first message is kept while being written
+    while (us_Size + us_Record > us_MaxSize)
+    {
+        // @NOTE: Records can only be removed from the front, drop the 
+        //        new message instead of the ones behind the written one
+        if (us_Written > 0)
+        {
+            ++u64_Dropped;
+            throw Exception("Write queue full, message dropped!");
+        }
+
+        Pop(true);
+    }
+
+    dq_Message.push_back({ s_Message, GetTime() });
+    us_Size += us_Record;
+
+    Append(dq_Message.back());
+}
+
+void WriteQueue::Remove() noexcept
+{
+    if (dq_Message.empty() == true)
+    {
+        return;
+    }
+
+    if (us_Replay > 0)
+    {
+        --us_Replay;
+        ++u64_Replayed;
+    }
+
+    Pop(false);
+}
+
+void WriteQueue::Expire() noexcept
+{
+    if (u64_MaxAgeUS == 0)
+    {
+        return;
+    }
+
+    MRH_Uint64 u64_TimeUS = GetTime();
+
+    while (dq_Message.empty() == false && us_Written == 0 && 
+           u64_TimeUS > dq_Message.front().u64_TimeUS + u64_MaxAgeUS)
+    {
+        Pop(true);
+    }
+}
+
+void WriteQueue::SetReplay() noexcept
+{
+    us_Replay = dq_Message.size();
+}
+
+void WriteQueue::SetWritten(size_t us_Written) noexcept
+{
+    this->us_Written = us_Written;
+}
+
+void WriteQueue::Pop(bool b_Dropped) noexcept
+{
+    us_Size -= GetRecordSize(dq_Message.front().s_Message);
+    us_Written = 0;
+
+    if (b_Dropped == true)
+    {
+        ++u64_Dropped;
+
+        if (us_Replay > 0)
+        {
+            --us_Replay;
+        }
+    }
+
+    if (p_File != NULL)
+    {
+        us_Start += GetRecordSize(dq_Message.front().s_Message);
+
+        // Empty, start over at the front
+        if (us_Start == us_End)
+        {
+            us_Start = 0;
+            us_End = 0;
+        }
+
+        Store();
+    }
+
+    dq_Message.pop_front();
+}
+
+MRH_Uint64 WriteQueue::GetTime() noexcept
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+//*************************************************************************************
+// File
+//*************************************************************************************
+
+void WriteQueue::Open(std::string const& s_FilePath)
+{
+    struct stat c_Stat;
+
+    if ((i_FD = open(s_FilePath.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600)) < 0 ||
+        fstat(i_FD, &c_Stat) != 0)
+    {
+        throw Exception("Failed to open write queue file " +
+                        s_FilePath +
+                        ": " +
+                        std::string(std::strerror(errno)));
+    }
+
+    us_FileSize = sizeof(FileHeader) + us_MaxSize;
+
+    // Size changed, stored messages are discarded
+    bool b_Valid = ((size_t)c_Stat.st_size == us_FileSize);
+
+    if (b_Valid == false && (ftruncate(i_FD, 0) != 0 || ftruncate(i_FD, us_FileSize) != 0))
+    {
+        throw Exception("Failed to resize write queue file " +
+                        s_FilePath +
+                        ": " +
+                        std::string(std::strerror(errno)));
+    }
+
+    void* p_Map = mmap(NULL, us_FileSize, PROT_READ | PROT_WRITE, MAP_SHARED, i_FD, 0);
+
+    if (p_Map == MAP_FAILED)
+    {
+        throw Exception("Failed to map write queue file " +
+                        s_FilePath +
+                        ": " +
+                        std::string(std::strerror(errno)));
+    }
+
+    p_File = (MRH_Uint8*)p_Map;
+
+    FileHeader c_Header;
+    std::memcpy(&c_Header, p_File, sizeof(FileHeader));
+
+    if (b_Valid == true &&
+        c_Header.u32_Magic == WRITE_QUEUE_FILE_MAGIC &&
+        c_Header.u32_Version == WRITE_QUEUE_FILE_VERSION &&
+        c_Header.u64_Start <= c_Header.u64_End &&
+        c_Header.u64_End <= us_MaxSize)
+    {
+        us_Start = c_Header.u64_Start;
+        us_End = c_Header.u64_End;
+    }
+    else
+    {
+        if (c_Stat.st_size > 0)
+        {
+            MRH_LOG_WARNING("Discarding invalid write queue file {}.", s_FilePath);
+        }
+
+        c_Header.u32_Magic = WRITE_QUEUE_FILE_MAGIC;
+        c_Header.u32_Version = WRITE_QUEUE_FILE_VERSION;
+        c_Header.u64_Start = 0;
+        c_Header.u64_End = 0;
+
+        std::memcpy(p_File, &c_Header, sizeof(FileHeader));
+    }
+}
+
+void WriteQueue::Load()
+{
+    const MRH_Uint8* p_Records = p_File + sizeof(FileHeader);
+    size_t us_Offset = us_Start;
+
+    while (us_End - us_Offset >= WRITE_QUEUE_RECORD_HEADER_SIZE)
+    {
+        MRH_Uint64 u64_TimeUS;
+        MRH_Uint32 u32_Length;
+
+        std::memcpy(&u64_TimeUS, p_Records + us_Offset, sizeof(MRH_Uint64));
+        std::memcpy(&u32_Length, p_Records + us_Offset + sizeof(MRH_Uint64), sizeof(MRH_Uint32));
+
+        // Partial record, stop at the last complete one
+        if (us_End - us_Offset - WRITE_QUEUE_RECORD_HEADER_SIZE < u32_Length)
+        {
+            break;
+        }
+
+        dq_Message.push_back({ std::string((const char*)(p_Records + us_Offset + WRITE_QUEUE_RECORD_HEADER_SIZE), u32_Length), u64_TimeUS });
+        us_Offset += WRITE_QUEUE_RECORD_HEADER_SIZE + u32_Length;
+    }
+
+    us_End = us_Offset;
+    us_Size = us_End - us_Start;
+
+    // @NOTE: Messages of the previous run are written on the first connection
+    us_Replay = dq_Message.size();
+
+    Store();
+    Expire();
+
+    if (dq_Message.empty() == false)
+    {
+        MRH_LOG_INFO("Loaded {} queued messages.", dq_Message.size());
+    }
+}
+
+void WriteQueue::Append(Message const& c_Message) noexcept
+{
+    if (p_File == NULL)
+    {
+        return;
+    }
+
+    MRH_Uint8* p_Records = p_File + sizeof(FileHeader);
+    size_t us_Record = GetRecordSize(c_Message.s_Message);
+
+    // Move the queued records to the front once the end is reached, the
+    // queue size limit guarantees the record fits afterwards
+    if (us_End + us_Record > us_MaxSize)
+    {
+        std::memmove(p_Records, p_Records + us_Start, us_End - us_Start);
+
+        us_End -= us_Start;
+        us_Start = 0;
+    }
+
+    MRH_Uint32 u32_Length = static_cast<MRH_Uint32>(c_Message.s_Message.size());
+
+    std::memcpy(p_Records + us_End, &(c_Message.u64_TimeUS), sizeof(MRH_Uint64));
+    std::memcpy(p_Records + us_End + sizeof(MRH_Uint64), &u32_Length, sizeof(MRH_Uint32));
+    std::memcpy(p_Records + us_End + WRITE_QUEUE_RECORD_HEADER_SIZE, c_Message.s_Message.data(), u32_Length);
+
+    // @NOTE: The record is complete before the header includes it
+    us_End += us_Record;
+
+    Store();
+}
+
+void WriteQueue::Store() noexcept
+{
+    if (p_File == NULL)
+    {
+        return;
+    }
+
+    FileHeader c_Header;
+
+    c_Header.u32_Magic = WRITE_QUEUE_FILE_MAGIC;
+    c_Header.u32_Version = WRITE_QUEUE_FILE_VERSION;
+    c_Header.u64_Start = us_Start;
+    c_Header.u64_End = us_End;
+
+    std::memcpy(p_File, &c_Header, sizeof(FileHeader));
+}
+
+//*************************************************************************************
+// Getters
+//*************************************************************************************
+
+size_t WriteQueue::GetCount() const noexcept
+{
+    return dq_Message.size();
+}
+
+std::string const& WriteQueue::GetMessage(size_t us_Message) const noexcept
+{
+    return dq_Message[us_Message].s_Message;
+}
+
+size_t WriteQueue::GetWritten() const noexcept
+{
+    return us_Written;
+}
+
+MRH_Uint64 WriteQueue::GetDropped() const noexcept
+{
+    return u64_Dropped;
+}
+
+MRH_Uint64 WriteQueue::GetReplayed() const noexcept
+{
+    return u64_Replayed;
+}
@@ -0,0 +1,234 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef WriteQueue_h
+#define WriteQueue_h
+
+// C / C++
+#include <atomic>
+#include <string>
+#include <deque>
+
+// External
+#include <MRH_Typedefs.h>
+
+// Project
+#include "../Exception.h"
+
+
+class WriteQueue
+{
+public:
+
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+
+    /**
+     *  Default constructor. Messages stored in an existing queue file are loaded.
+     *
+     *  \param us_MaxSize The maximum size of all queued messages in bytes.
+     *  \param u32_MaxAgeS The maximum age of a queued message in seconds, 0 for no limit.
+     *  \param s_FilePath The full path to the queue file. null keeps the queue in memory.
+     */
+
+    WriteQueue(size_t us_MaxSize,
+               MRH_Uint32 u32_MaxAgeS,
+               std::string const& s_FilePath);
+
+    /**
+     *  Default destructor.
+     */
+
+    ~WriteQueue() noexcept;
+
+    //*************************************************************************************
+    // Queue
+    //*************************************************************************************
+
+    /**
+     *  Add a message to the end of the queue. The oldest messages are dropped if the 
+     *  queue is full.
+     *
+     *  \param s_Message The message to add.
+     */
+
+    void Add(std::string const& s_Message);
+
+    /**
+     *  Remove the first message after it was written.
+     */
+
+    void Remove() noexcept;
+
+    /**
+     *  Drop all messages older than the maximum age.
+     */
+
+    void Expire() noexcept;
+
+    /**
+     *  Count all currently queued messages as replayed once written.
+     */
+
+    void SetReplay() noexcept;
+
+    /**
+     *  Set the bytes written for the first message. A partially written message 
+     *  is never dropped.
+     *
+     *  \param us_Written The bytes written, 0 if the message has to be written again.
+     */
+
+    void SetWritten(size_t us_Written) noexcept;
+
+    //*************************************************************************************
+    // Getters
+    //*************************************************************************************
+
+    /**
+     *  Get the amount of queued messages.
+     *
+     *  \return The queued message count.
+     */
+
+    size_t GetCount() const noexcept;
+
+    /**
+     *  Get a queued message.
+     *
+     *  \param us_Message The message index, 0 for the first message.
+     *
+     *  \return The queued message.
+     */
+
+    std::string const& GetMessage(size_t us_Message) const noexcept;
+
+    /**
+     *  Get the bytes written for the first message.
+     *
+     *  \return The bytes written.
+     */
+
+    size_t GetWritten() const noexcept;
+
+    /**
+     *  Get the amount of messages dropped due to the size or age limit.
+     *
+     *  \return The dropped message count.
+     */
+
+    MRH_Uint64 GetDropped() const noexcept;
+
+    /**
+     *  Get the amount of messages written after a reconnect.
+     *
+     *  \return The replayed message count.
+     */
+
+    MRH_Uint64 GetReplayed() const noexcept;
+
+private:
+
+    //*************************************************************************************
+    // Types
+    //*************************************************************************************
+
+    struct Message
+    {
+        std::string s_Message;
+        MRH_Uint64 u64_TimeUS; // System time the message was added
+    };
+
+    //*************************************************************************************
+    // Queue
+    //*************************************************************************************
+
+    /**
+     *  Remove the first message.
+     *
+     *  \param b_Dropped If the message was dropped instead of written.
+     */
+
+    void Pop(bool b_Dropped) noexcept;
+
+    /**
+     *  Get the current system time.
+     *
+     *  \return The time in microseconds since the epoch.
+     */
+
+    static MRH_Uint64 GetTime() noexcept;
+
+    //*************************************************************************************
+    // File
+    //*************************************************************************************
+
+    /**
+     *  Open and map the queue file.
+     *
+     *  \param s_FilePath The full path to the queue file.
+     */
+
+    void Open(std::string const& s_FilePath);
+
+    /**
+     *  Load the messages stored in the mapped queue file.
+     */
+
+    void Load();
+
+    /**
+     *  Append a message to the mapped queue file.
+     *
+     *  \param c_Message The message to append.
+     */
+
+    void Append(Message const& c_Message) noexcept;
+
+    /**
+     *  Update the queue file range.
+     */
+
+    void Store() noexcept;
+
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+
+    std::deque<Message> dq_Message;
+    size_t us_Size; // Record size of all queued messages
+    size_t us_MaxSize;
+    MRH_Uint64 u64_MaxAgeUS;
+    size_t us_Written;
+    size_t us_Replay; // Queued messages counted as replayed
+
+    std::atomic<MRH_Uint64> u64_Dropped;
+    std::atomic<MRH_Uint64> u64_Replayed;
+
+    // @NOTE: Records are only appended, the first record is tracked by 
+    //        the file header
+    int i_FD;
+    MRH_Uint8* p_File;
+    size_t us_FileSize;
+    size_t us_Start; // First record offset
+    size_t us_End; // Record end offset
+
+protected:
+
+};
+
+#endif /* WriteQueue_h */
@@ -20,9 +20,13 @@
 
 // Project
 #include "./CreateTTSAPI.h"
+#include "../CachedTTS.h"
 #if MRH_SPEECHD_TTS_API_GGOGLE_CLOUD > 0
 #include "./GoogleCloudTTS/GoogleCloudTTS.h"
 #endif
+#if MRH_SPEECHD_TTS_API_ESPEAK_NG > 0
+#include "./ESpeakNGTTS/ESpeakNGTTS.h"
+#endif
 
 
 //*************************************************************************************
@@ -41,20 +45,36 @@ void CreateTTSAPI::Destroy(Configuration const& c_Configuration) noexcept
 
 std::shared_ptr<TTS> CreateTTSAPI::CreateTTS(Configuration const& c_Configuration)
 {
+    std::shared_ptr<TTS> p_TTS;
+
     try
     {
         switch (c_Configuration.c_API.u8_TTSAPI)
         {
 #if MRH_SPEECHD_TTS_API_GGOGLE_CLOUD > 0
             case TTS_API_GOOGLE_CLOUD:
-                return std::make_shared<GoogleCloudTTS>(c_Configuration.c_GoogleCloudTTS);
+                p_TTS = std::make_shared<GoogleCloudTTS>(c_Configuration.c_GoogleCloudTTS);
+                break;
+#endif
+#if MRH_SPEECHD_TTS_API_ESPEAK_NG > 0
+            case TTS_API_ESPEAK_NG:
+                p_TTS = std::make_shared<ESpeakNGTTS>(c_Configuration.c_ESpeakNGTTS);
+                break;
 #endif
             default:
                 throw Exception("Unknown or unsupported TTS API!");
         }
+
+        // Cache synthesized audio if allowed
+        if (c_Configuration.c_TTSCache.us_MemorySize > 0 || c_Configuration.c_TTSCache.us_DiskSize > 0)
+        {
+            p_TTS = std::make_shared<CachedTTS>(p_TTS, c_Configuration.c_TTSCache);
+        }
     }
     catch (std::exception& e)
     {
         throw Exception(e.what());
     }
+
+    return p_TTS;
 }
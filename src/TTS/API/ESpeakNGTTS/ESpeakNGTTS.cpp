@@ -0,0 +1,202 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+#include <fstream>
+
+// External
+#include <libmrhvt/String/MRH_LocalisedPath.h>
+
+// Project
+#include "./ESpeakNGTTS.h"
+
+// Pre-defined
+#if ESPEAK_NG_TTS_LOG_EXTENDED > 0
+    #define ESPEAK_NG_TTS_LOG(X) MRH_LOG_INFO("{}", X)
+#else
+    #define ESPEAK_NG_TTS_LOG(X)
+#endif
+
+namespace
+{
+    struct SynthData
+    {
+        AudioBuffer* p_Buffer;
+        bool b_Failed;
+    };
+}
+
+
+//*************************************************************************************
+// Constructor / Destructor
+//*************************************************************************************
+
+ESpeakNGTTS::ESpeakNGTTS(Configuration::ESpeakNGTTS const& c_Configuration) : TTS("eSpeak NG TTS"),
+                                                                              s_Voice(""),
+                                                                              u32_Rate(c_Configuration.u32_Rate),
+                                                                              u32_Pitch(c_Configuration.u32_Pitch),
+                                                                              u32_KHz(0)
+{
+    std::string s_VoiceFilePath = MRH::VT::LocalisedPath::GetPath(c_Configuration.s_VoiceDirPath, c_Configuration.s_VoiceFileName);
+    std::ifstream f_File(s_VoiceFilePath);
+
+    if (f_File.is_open() == false)
+    {
+        throw Exception("Failed to open " +
+                        s_VoiceFilePath +
+                        " TTS voice file!");
+    }
+
+    getline(f_File, s_Voice);
+    f_File.close();
+
+    /**
+     *  Engine Setup
+     */
+
+    const char* p_DataPath = NULL;
+
+    if (c_Configuration.s_DataPath.compare("null") != 0)
+    {
+        p_DataPath = c_Configuration.s_DataPath.c_str();
+    }
+
+    // Initialize once, the engine and voice data stay loaded for all requests
+    // @NOTE: Synchronous output returns audio through the callback on the calling thread
+    int i_KHz = espeak_Initialize(AUDIO_OUTPUT_SYNCHRONOUS,
+                                  0,
+                                  p_DataPath,
+                                  espeakINITIALIZE_DONT_EXIT);
+
+    if (i_KHz <= 0)
+    {
+        throw Exception("Failed to initialize eSpeak NG!");
+    }
+
+    u32_KHz = static_cast<MRH_Uint32>(i_KHz);
+    espeak_SetSynthCallback(SynthCallback);
+
+    // Preload the voice model
+    if (espeak_SetVoiceByName(s_Voice.c_str()) != EE_OK)
+    {
+        espeak_Terminate();
+        throw Exception("Failed to load eSpeak NG voice " +
+                        s_Voice +
+                        "!");
+    }
+
+    if (espeak_SetParameter(espeakRATE, static_cast<int>(u32_Rate), 0) != EE_OK ||
+        espeak_SetParameter(espeakPITCH, static_cast<int>(u32_Pitch), 0) != EE_OK)
+    {
+        espeak_Terminate();
+        throw Exception("Failed to set eSpeak NG voice parameters!");
+    }
+
+    MRH_LOG_INFO("Set eSpeak NG TTS voice to {} ({} KHz)", s_Voice, u32_KHz);
+}
+
+ESpeakNGTTS::~ESpeakNGTTS() noexcept
+{
+    espeak_Terminate();
+}
+
+//*************************************************************************************
+// Synthesize
+//*************************************************************************************
+
+int ESpeakNGTTS::SynthCallback(short* p_Samples, int i_Samples, espeak_EVENT* p_Event) noexcept
+{
+    // Synthesis finished
+    if (p_Samples == NULL)
+    {
+        return 0;
+    }
+    else if (i_Samples <= 0)
+    {
+        return 0;
+    }
+
+    SynthData* p_Data = static_cast<SynthData*>(p_Event->user_data);
+
+    try
+    {
+        p_Data->p_Buffer->Add(p_Samples, static_cast<size_t>(i_Samples));
+    }
+    catch (...)
+    {
+        p_Data->b_Failed = true;
+        return 1;
+    }
+
+    return 0;
+}
+
+void ESpeakNGTTS::Synthesize(std::string const& s_String, AudioBuffer& c_Buffer)
+{
+    if (s_String.empty() == true)
+    {
+        throw Exception("Empty string given!");
+    }
+
+    ESPEAK_NG_TTS_LOG("Synthesizing string " +
+                      s_String +
+                      "...");
+
+    std::lock_guard<std::mutex> c_Guard(c_Mutex);
+
+    // Samples are added directly to the playback buffer by the callback
+    SynthData c_Data = { &c_Buffer, false };
+    c_Buffer.Reset(u32_KHz);
+
+    espeak_ERROR e_Error = espeak_Synth(s_String.c_str(),
+                                        s_String.size() + 1,
+                                        0,
+                                        POS_CHARACTER,
+                                        0,
+                                        espeakCHARS_UTF8,
+                                        NULL,
+                                        &c_Data);
+
+    if (e_Error != EE_OK || c_Data.b_Failed == true)
+    {
+        throw Exception("Failed to synthesize with eSpeak NG!");
+    }
+    else if (c_Buffer.GetSampleCount() == 0)
+    {
+        throw Exception("Invalid synthesized audio!");
+    }
+
+    ESPEAK_NG_TTS_LOG("Synthesized audio with " +
+                      std::to_string(c_Buffer.GetSampleCount()) +
+                      " samples.");
+}
+
+//*************************************************************************************
+// Getters
+//*************************************************************************************
+
+std::string ESpeakNGTTS::GetVoiceKey() const noexcept
+{
+    return s_Identifier +
+           ";" +
+           s_Voice +
+           ";" +
+           std::to_string(u32_Rate) +
+           ";" +
+           std::to_string(u32_Pitch) +
+           ";" +
+           std::to_string(u32_KHz);
+}
@@ -0,0 +1,113 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef ESpeakNGTTS_h
+#define ESpeakNGTTS_h
+
+// C / C++
+#include <mutex>
+
+// External
+#include <espeak-ng/speak_lib.h>
+
+// Project
+#include "../../TTS.h"
+#include "../../../Configuration.h"
+
+
+class ESpeakNGTTS : public TTS
+{
+public:
+
+    //*************************************************************************************
+    // Destructor
+    //*************************************************************************************
+
+    /**
+     *  Default constructor.
+     *
+     *  \param c_Configuration The configuration to setup with.
+     */
+
+    ESpeakNGTTS(Configuration::ESpeakNGTTS const& c_Configuration);
+
+    /**
+     *  Default destructor.
+     */
+
+    ~ESpeakNGTTS() noexcept;
+
+    //*************************************************************************************
+    // Synthesize
+    //*************************************************************************************
+
+    /**
+     *  Synthesize speech output from a given text string.
+     *
+     *  \param s_String The speech string to synthesize audio for.
+     *  \param c_Buffer The audio buffer to store audio in. The buffer is overwritten.
+     */
+
+    void Synthesize(std::string const& s_String, AudioBuffer& c_Buffer) override;
+
+    //*************************************************************************************
+    // Getters
+    //*************************************************************************************
+
+    /**
+     *  Get the key of the voice used for synthesis.
+     *
+     *  \return The voice key.
+     */
+
+    std::string GetVoiceKey() const noexcept override;
+
+private:
+
+    //*************************************************************************************
+    // Synthesize
+    //*************************************************************************************
+
+    /**
+     *  Receive synthesized audio from the engine.
+     *
+     *  \param p_Samples The synthesized samples, NULL if synthesis finished.
+     *  \param i_Samples The number of synthesized samples.
+     *  \param p_Event The synthesis events, containing the user data.
+     *
+     *  \return 0 to continue synthesis, 1 to abort.
+     */
+
+    static int SynthCallback(short* p_Samples, int i_Samples, espeak_EVENT* p_Event) noexcept;
+
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+
+    std::string s_Voice;
+    MRH_Uint32 u32_Rate;
+    MRH_Uint32 u32_Pitch;
+
+    MRH_Uint32 u32_KHz;
+
+    // @NOTE: The engine state is process wide, synthesis is serialized
+    std::mutex c_Mutex;
+
+protected:
+
+};
+
+#endif /* ESpeakNGTTS_h */
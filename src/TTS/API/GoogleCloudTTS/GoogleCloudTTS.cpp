@@ -25,14 +25,16 @@
 
 // Project
 #include "./GoogleCloudTTS.h"
+#include "../../../GoogleCloud/GoogleCloudChannel.h"
 
 // Pre-defined
 #if GOOGLE_CLOUD_TTS_LOG_EXTENDED > 0
-    #define GOOGLE_CLOUD_TTS_LOG(X) Logger::Singleton().Log(Logger::INFO, X, "GoogleCloudTTS.cpp", __LINE__)
+    #define GOOGLE_CLOUD_TTS_LOG(X) MRH_LOG_INFO("{}", X)
 #else
     #define GOOGLE_CLOUD_TTS_LOG(X)
 #endif
 #define GOOGLE_CLOUD_TTS_CHANNEL "texttospeech.googleapis.com"
+#define GOOGLE_CLOUD_TTS_WARM_TIMEOUT_MS 5000
 
 // Namespace
 using google::cloud::texttospeech::v1::TextToSpeech;
@@ -50,7 +52,7 @@ GoogleCloudTTS::GoogleCloudTTS(Configuration::GoogleCloudTTS const& c_Configurat
                                                                                        s_LanguageCode(""),
                                                                                        u8_VoiceGender(c_Configuration.u8_VoiceGender),
                                                                                        u32_KHz(c_Configuration.u32_KHz),
-                                                                                       u32_ChunkSamples(c_Configuration.u32_ChunkSamples)
+                                                                                       u32_DeadlineMS(c_Configuration.u32_DeadlineMS)
 {
     std::string s_LocaleFilePath = MRH::VT::LocalisedPath::GetPath(c_Configuration.s_BCPDirPath, c_Configuration.s_BCPFileName);
     std::ifstream f_File(s_LocaleFilePath);
@@ -65,14 +67,68 @@ GoogleCloudTTS::GoogleCloudTTS(Configuration::GoogleCloudTTS const& c_Configurat
     getline(f_File, s_LanguageCode);
     f_File.close();
 
-    Logger::Singleton().Log(Logger::INFO, "Set Google Cloud API TTS locale to " +
-                                          s_LanguageCode,
-                            "GoogleCloudTTS.cpp", __LINE__);
+    MRH_LOG_INFO("Set Google Cloud API TTS locale to {}", s_LanguageCode);
+
+    /**
+     *  Credentials Setup
+     */
+
+    // Setup the google connection once, requests reuse the connected channel
+    p_Channel = GoogleCloudChannel::GetChannel(GOOGLE_CLOUD_TTS_CHANNEL);
+    p_TextToSpeech = TextToSpeech::NewStub(p_Channel);
+
+    GoogleCloudChannel::Warm(p_Channel, GOOGLE_CLOUD_TTS_WARM_TIMEOUT_MS);
 }
 
 GoogleCloudTTS::~GoogleCloudTTS() noexcept
 {}
 
+//*************************************************************************************
+// Call
+//*************************************************************************************
+
+std::unique_ptr<GoogleCloudTTS::Call> GoogleCloudTTS::GetCall()
+{
+    {
+        std::lock_guard<std::mutex> c_Guard(c_Mutex);
+
+        if (v_Call.empty() == false)
+        {
+            std::unique_ptr<Call> p_Call = std::move(v_Call.back());
+            v_Call.pop_back();
+
+            return p_Call;
+        }
+    }
+
+    std::unique_ptr<Call> p_Call(new Call());
+
+    // Set synthesise configuration, kept for all requests
+    // @NOTE: Default returned is mono!
+    auto* p_AudioConfig = p_Call->c_Request.mutable_audio_config();
+    p_AudioConfig->set_audio_encoding(AudioEncoding::LINEAR16);
+    p_AudioConfig->set_sample_rate_hertz(u32_KHz);
+
+    // Set output voice info
+    auto* p_VoiceConfig = p_Call->c_Request.mutable_voice();
+    p_VoiceConfig->set_ssml_gender(u8_VoiceGender > 0 ? SsmlVoiceGender::MALE : SsmlVoiceGender::FEMALE);
+    p_VoiceConfig->set_language_code(s_LanguageCode);
+
+    return p_Call;
+}
+
+void GoogleCloudTTS::ReturnCall(std::unique_ptr<Call>& p_Call) noexcept
+{
+    try
+    {
+        std::lock_guard<std::mutex> c_Guard(c_Mutex);
+
+        v_Call.emplace_back(std::move(p_Call));
+    }
+    catch (...)
+    {}
+}
+
 //*************************************************************************************
 // Synthesize
 //*************************************************************************************
@@ -84,42 +140,29 @@ void GoogleCloudTTS::Synthesize(std::string const& s_String, AudioBuffer& c_Buff
         throw Exception("Empty string given!");
     }
 
-    SsmlVoiceGender c_VoiceGender = SsmlVoiceGender::FEMALE;
+    std::unique_ptr<Call> p_Call = GetCall();
 
-    if (u8_VoiceGender > 0)
+    try
     {
-        c_VoiceGender = SsmlVoiceGender::MALE;
+        Synthesize(*p_Call, s_String, c_Buffer);
+    }
+    catch (...)
+    {
+        ReturnCall(p_Call);
+        throw;
     }
 
-    /**
-     *  Credentials Setup
-     */
-
-    // Setup google connection with credentials for this request
-    auto c_Credentials = grpc::GoogleDefaultCredentials();
-    auto c_CloudChannel = grpc::CreateChannel(GOOGLE_CLOUD_TTS_CHANNEL, c_Credentials);
-    std::unique_ptr<TextToSpeech::Stub> p_TextToSpeech(TextToSpeech::NewStub(c_CloudChannel));
+    ReturnCall(p_Call);
+}
 
+void GoogleCloudTTS::Synthesize(Call& c_Call, std::string const& s_String, AudioBuffer& c_Buffer)
+{
     /**
      *  Create request
      */
 
-    // Define our request to use for config and audio
-    SynthesizeSpeechRequest c_SynthesizeRequest;
-
-    // Set synthesise configuration
-    // @NOTE: Default returned is mono!
-    auto* p_AudioConfig = c_SynthesizeRequest.mutable_audio_config();
-    p_AudioConfig->set_audio_encoding(AudioEncoding::LINEAR16);
-    p_AudioConfig->set_sample_rate_hertz(u32_KHz);
-
-    // Set output voice info
-    auto* p_VoiceConfig = c_SynthesizeRequest.mutable_voice();
-    p_VoiceConfig->set_ssml_gender(c_VoiceGender);
-    p_VoiceConfig->set_language_code(s_LanguageCode);
-
-    // Set the string
-    c_SynthesizeRequest.mutable_input()->set_text(s_String);
+    // Set the string, the configuration is kept
+    c_Call.c_Request.mutable_input()->set_text(s_String);
 
     /**
      *  Synthesize
@@ -130,10 +173,12 @@ void GoogleCloudTTS::Synthesize(std::string const& s_String, AudioBuffer& c_Buff
                          "...");
 
     grpc::ClientContext c_Context;
-    SynthesizeSpeechResponse c_SynthesizeResponse;
+    GoogleCloudChannel::SetDeadline(c_Context, u32_DeadlineMS);
+
+    // @NOTE: Parsing clears the response, the audio content storage is reused
     grpc::Status c_RPCStatus = p_TextToSpeech->SynthesizeSpeech(&c_Context,
-                                                                c_SynthesizeRequest,
-                                                                &c_SynthesizeResponse);
+                                                                c_Call.c_Request,
+                                                                &(c_Call.c_Response));
 
     if (c_RPCStatus.ok() == false)
     {
@@ -146,10 +191,10 @@ void GoogleCloudTTS::Synthesize(std::string const& s_String, AudioBuffer& c_Buff
      */
 
     // Grab the synth data
-    MRH_Sint16* p_Buffer = (MRH_Sint16*)c_SynthesizeResponse.audio_content().data();
-    size_t us_Elements;
+    std::string const& s_Audio = c_Call.c_Response.audio_content();
+    size_t us_Elements = s_Audio.size() / sizeof(MRH_Sint16);
 
-    if (p_Buffer == NULL || (us_Elements = c_SynthesizeResponse.audio_content().size() / sizeof(MRH_Sint16)) == 0)
+    if (us_Elements == 0)
     {
         throw Exception("Invalid synthesized audio!");
     }
@@ -158,28 +203,22 @@ void GoogleCloudTTS::Synthesize(std::string const& s_String, AudioBuffer& c_Buff
                          std::to_string(us_Elements) +
                          " samples.");
 
-    try
-    {
-        std::deque<AudioBuffer::AudioChunk> dq_Chunk;
+    // Single copy into the playback buffer, storage is kept by the buffer
+    c_Buffer.Reset(u32_KHz);
+    c_Buffer.AddBytes(s_Audio.data(), us_Elements);
+}
 
-        for (size_t i = 0; i < us_Elements; i += u32_ChunkSamples)
-        {
-            if ((i + u32_ChunkSamples) < us_Elements)
-            {
-                dq_Chunk.emplace_back(&(p_Buffer[i]),
-                                      &(p_Buffer[i]) + u32_ChunkSamples);
-            }
-            else
-            {
-                dq_Chunk.emplace_back(&(p_Buffer[i]),
-                                      &(p_Buffer[i]) + (us_Elements - i));
-            }
-        }
+//*************************************************************************************
+// Getters
+//*************************************************************************************
 
-        c_Buffer.Reset(u32_KHz, dq_Chunk);
-    }
-    catch (...)
-    {
-        throw;
-    }
+std::string GoogleCloudTTS::GetVoiceKey() const noexcept
+{
+    return s_Identifier +
+           ";" +
+           s_LanguageCode +
+           ";" +
+           std::to_string(u8_VoiceGender) +
+           ";" +
+           std::to_string(u32_KHz);
 }
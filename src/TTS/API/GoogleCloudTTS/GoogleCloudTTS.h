@@ -18,8 +18,13 @@
 #define GoogleCloudTTS_h
 
 // C / C++
+#include <memory>
+#include <mutex>
+#include <vector>
 
 // External
+#include <google/cloud/texttospeech/v1/cloud_tts.grpc.pb.h>
+#include <grpcpp/grpcpp.h>
 
 // Project
 #include "../../TTS.h"
@@ -61,8 +66,64 @@ public:
 
     void Synthesize(std::string const& s_String, AudioBuffer& c_Buffer) override;
 
+    //*************************************************************************************
+    // Getters
+    //*************************************************************************************
+
+    /**
+     *  Get the key of the voice used for synthesis.
+     *
+     *  \return The voice key.
+     */
+
+    std::string GetVoiceKey() const noexcept override;
+
 private:
 
+    //*************************************************************************************
+    // Types
+    //*************************************************************************************
+
+    struct Call
+    {
+        google::cloud::texttospeech::v1::SynthesizeSpeechRequest c_Request;
+        google::cloud::texttospeech::v1::SynthesizeSpeechResponse c_Response;
+    };
+
+    //*************************************************************************************
+    // Call
+    //*************************************************************************************
+
+    /**
+     *  Get a idle call or create a new one. The request configuration is set.
+     *
+     *  \return The call to synthesize with.
+     */
+
+    std::unique_ptr<Call> GetCall();
+
+    /**
+     *  Return a call for reuse.
+     *
+     *  \param p_Call The call to return.
+     */
+
+    void ReturnCall(std::unique_ptr<Call>& p_Call) noexcept;
+
+    //*************************************************************************************
+    // Synthesize
+    //*************************************************************************************
+
+    /**
+     *  Synthesize speech output with a call.
+     *
+     *  \param c_Call The call to synthesize with.
+     *  \param s_String The speech string to synthesize audio for.
+     *  \param c_Buffer The audio buffer to store audio in. The buffer is overwritten.
+     */
+
+    void Synthesize(Call& c_Call, std::string const& s_String, AudioBuffer& c_Buffer);
+
     //*************************************************************************************
     // Data
     //*************************************************************************************
@@ -71,7 +132,15 @@ private:
     MRH_Uint8 u8_VoiceGender;
 
     MRH_Uint32 u32_KHz;
-    MRH_Uint32 u32_ChunkSamples;
+    MRH_Uint32 u32_DeadlineMS;
+
+    std::shared_ptr<grpc::Channel> p_Channel;
+    std::unique_ptr<google::cloud::texttospeech::v1::TextToSpeech::Stub> p_TextToSpeech;
+
+    // @NOTE: Requests and responses keep their allocations between calls,
+    //        one call exists per concurrent synthesis
+    std::mutex c_Mutex;
+    std::vector<std::unique_ptr<Call>> v_Call;
 
 protected:
 
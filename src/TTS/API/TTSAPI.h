@@ -36,6 +36,14 @@
     #define MRH_SPEECHD_TTS_API_GGOGLE_CLOUD 0
 #endif
 
+/**
+ *  eSpeak NG API
+ */
+
+#ifndef MRH_SPEECHD_TTS_API_ESPEAK_NG
+    #define MRH_SPEECHD_TTS_API_ESPEAK_NG 0
+#endif
+
 //*************************************************************************************
 // API Enumerations
 //*************************************************************************************
@@ -45,9 +53,10 @@ typedef enum
 {
     // APIs
     TTS_API_GOOGLE_CLOUD = 0,
+    TTS_API_ESPEAK_NG = 1,
 
     // Bounds
-    TTS_API_MAX = TTS_API_GOOGLE_CLOUD,
+    TTS_API_MAX = TTS_API_ESPEAK_NG,
 
     TTS_API_COUNT = TTS_API_MAX + 1
 
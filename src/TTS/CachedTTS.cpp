@@ -0,0 +1,499 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <algorithm>
+
+// External
+
+// Project
+#include "./CachedTTS.h"
+
+// Pre-defined
+#if CACHED_TTS_LOG_EXTENDED > 0
+    #define CACHED_TTS_LOG(X) MRH_LOG_INFO("{}", X)
+#else
+    #define CACHED_TTS_LOG(X)
+#endif
+#define CACHED_TTS_FILE_MAGIC 0x4D524843 // MRHC
+#define CACHED_TTS_FILE_EXTENSION ".pcm"
+#define CACHED_TTS_FILE_ALIGNMENT 8
+
+// Namespace
+namespace
+{
+    // @NOTE: Cache files store the header, the full key padded to the
+    //        alignment and the raw native endian samples
+    struct FileHeader
+    {
+        MRH_Uint32 u32_Magic;
+        MRH_Uint32 u32_KHz;
+        MRH_Uint64 u64_KeySize;
+        MRH_Uint64 u64_Samples;
+    };
+
+    inline size_t GetSampleOffset(size_t us_KeySize) noexcept
+    {
+        size_t us_Offset = sizeof(FileHeader) + us_KeySize;
+
+        return (us_Offset + (CACHED_TTS_FILE_ALIGNMENT - 1)) & ~(size_t)(CACHED_TTS_FILE_ALIGNMENT - 1);
+    }
+
+    inline bool WriteAll(int i_FD, const void* p_Data, size_t us_Size) noexcept
+    {
+        const MRH_Uint8* p_Bytes = (const MRH_Uint8*)p_Data;
+
+        while (us_Size > 0)
+        {
+            ssize_t ss_Written = write(i_FD, p_Bytes, us_Size);
+
+            if (ss_Written < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+
+                return false;
+            }
+
+            p_Bytes += ss_Written;
+            us_Size -= ss_Written;
+        }
+
+        return true;
+    }
+}
+
+
+//*************************************************************************************
+// Constructor / Destructor
+//*************************************************************************************
+
+CachedTTS::CachedTTS(std::shared_ptr<TTS> p_TTS, Configuration::TTSCache const& c_Configuration) : TTS("Cached " + p_TTS->s_Identifier),
+                                                                                                   p_TTS(p_TTS),
+                                                                                                   s_VoiceKey(p_TTS->GetVoiceKey()),
+                                                                                                   us_MemorySize(0),
+                                                                                                   us_MaxMemorySize(c_Configuration.us_MemorySize),
+                                                                                                   us_DiskSize(0),
+                                                                                                   us_MaxDiskSize(c_Configuration.us_DiskSize),
+                                                                                                   s_DirectoryPath(c_Configuration.s_DirectoryPath),
+                                                                                                   u64_Hits(0),
+                                                                                                   u64_DiskHits(0),
+                                                                                                   u64_Misses(0),
+                                                                                                   u64_Evictions(0),
+                                                                                                   u64_DiskEvictions(0)
+{
+    if (s_DirectoryPath.size() > 0 && s_DirectoryPath.back() != '/')
+    {
+        s_DirectoryPath += "/";
+    }
+
+    if (us_MaxDiskSize > 0)
+    {
+        LoadDisk();
+    }
+
+    MRH_LOG_INFO("TTS cache sizes: Memory {} bytes, Disk {} bytes ({} files loaded).",
+                 us_MaxMemorySize,
+                 us_MaxDiskSize,
+                 l_Disk.size());
+}
+
+CachedTTS::~CachedTTS() noexcept
+{
+    Dump();
+}
+
+//*************************************************************************************
+// Synthesize
+//*************************************************************************************
+
+void CachedTTS::Synthesize(std::string const& s_String, AudioBuffer& c_Buffer)
+{
+    std::string s_Key = s_VoiceKey + "\n" + s_String;
+
+    {
+        std::lock_guard<std::mutex> c_Guard(c_Mutex);
+
+        if (GetMemory(s_Key, c_Buffer) == true)
+        {
+            u64_Hits.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        else if (us_MaxDiskSize > 0 && GetDisk(s_Key, c_Buffer) == true)
+        {
+            u64_DiskHits.fetch_add(1, std::memory_order_relaxed);
+            AddMemory(s_Key, c_Buffer);
+            return;
+        }
+    }
+
+    // Synthesize without holding the cache
+    u64_Misses.fetch_add(1, std::memory_order_relaxed);
+    p_TTS->Synthesize(s_String, c_Buffer);
+
+    std::lock_guard<std::mutex> c_Guard(c_Mutex);
+
+    AddMemory(s_Key, c_Buffer);
+
+    if (us_MaxDiskSize > 0)
+    {
+        AddDisk(s_Key, c_Buffer);
+    }
+}
+
+//*************************************************************************************
+// Memory
+//*************************************************************************************
+
+bool CachedTTS::GetMemory(std::string const& s_Key, AudioBuffer& c_Buffer)
+{
+    auto Entry = m_Memory.find(s_Key);
+
+    if (Entry == m_Memory.end())
+    {
+        return false;
+    }
+
+    // Most recently used now
+    l_Memory.splice(l_Memory.begin(), l_Memory, Entry->second);
+
+    c_Buffer.Reset(Entry->second->u32_KHz);
+    c_Buffer.Add(Entry->second->v_Sample.data(), Entry->second->v_Sample.size());
+
+    CACHED_TTS_LOG("Memory cache hit with " +
+                   std::to_string(Entry->second->v_Sample.size()) +
+                   " samples.");
+
+    return true;
+}
+
+void CachedTTS::AddMemory(std::string const& s_Key, AudioBuffer const& c_Buffer)
+{
+    size_t us_Size = s_Key.size() + (c_Buffer.GetSampleCount() * sizeof(MRH_Sint16));
+
+    if (us_Size > us_MaxMemorySize || m_Memory.find(s_Key) != m_Memory.end())
+    {
+        return;
+    }
+
+    // Remove least recently used first
+    while (us_MemorySize + us_Size > us_MaxMemorySize)
+    {
+        MemoryEntry& c_Entry = l_Memory.back();
+
+        us_MemorySize -= c_Entry.s_Key.size() + (c_Entry.v_Sample.size() * sizeof(MRH_Sint16));
+        m_Memory.erase(c_Entry.s_Key);
+        l_Memory.pop_back();
+
+        u64_Evictions.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    AudioBuffer::ConstRegion c_First;
+    AudioBuffer::ConstRegion c_Second;
+
+    c_Buffer.GetReadRegions(c_First, c_Second);
+
+    l_Memory.emplace_front();
+    MemoryEntry& c_Entry = l_Memory.front();
+
+    c_Entry.s_Key = s_Key;
+    c_Entry.u32_KHz = c_Buffer.GetKHz();
+    c_Entry.v_Sample.reserve(c_Buffer.GetSampleCount());
+    c_Entry.v_Sample.insert(c_Entry.v_Sample.end(), c_First.p_Samples, c_First.p_Samples + c_First.us_Samples);
+    c_Entry.v_Sample.insert(c_Entry.v_Sample.end(), c_Second.p_Samples, c_Second.p_Samples + c_Second.us_Samples);
+
+    m_Memory.insert(std::make_pair(s_Key, l_Memory.begin()));
+    us_MemorySize += us_Size;
+}
+
+//*************************************************************************************
+// Disk
+//*************************************************************************************
+
+void CachedTTS::LoadDisk() noexcept
+{
+    DIR* p_Directory = opendir(s_DirectoryPath.c_str());
+
+    if (p_Directory == NULL)
+    {
+        MRH_LOG_WARNING("Failed to open TTS cache directory {}: {}", s_DirectoryPath, std::strerror(errno));
+        return;
+    }
+
+    std::vector<std::pair<time_t, DiskEntry>> v_File;
+    struct dirent* p_Entry;
+    struct stat c_Stat;
+
+    while ((p_Entry = readdir(p_Directory)) != NULL)
+    {
+        std::string s_FileName(p_Entry->d_name);
+        size_t us_Extension = std::strlen(CACHED_TTS_FILE_EXTENSION);
+
+        if (s_FileName.size() <= us_Extension ||
+            s_FileName.compare(s_FileName.size() - us_Extension, us_Extension, CACHED_TTS_FILE_EXTENSION) != 0 ||
+            stat((s_DirectoryPath + s_FileName).c_str(), &c_Stat) != 0 ||
+            S_ISREG(c_Stat.st_mode) == 0)
+        {
+            continue;
+        }
+
+        v_File.push_back(std::make_pair(c_Stat.st_mtime, DiskEntry{ s_FileName, (size_t)c_Stat.st_size }));
+    }
+
+    closedir(p_Directory);
+
+    // Order by last use, newest first
+    std::sort(v_File.begin(), v_File.end(), [](std::pair<time_t, DiskEntry> const& c_A, std::pair<time_t, DiskEntry> const& c_B)
+    {
+        return c_A.first > c_B.first;
+    });
+
+    for (auto& File : v_File)
+    {
+        l_Disk.push_back(File.second);
+        m_Disk.insert(std::make_pair(File.second.s_FileName, std::prev(l_Disk.end())));
+        us_DiskSize += File.second.us_Size;
+    }
+
+    EvictDisk(0);
+}
+
+bool CachedTTS::GetDisk(std::string const& s_Key, AudioBuffer& c_Buffer)
+{
+    auto Entry = m_Disk.find(GetFileName(s_Key));
+
+    if (Entry == m_Disk.end())
+    {
+        return false;
+    }
+
+    std::string s_FilePath = s_DirectoryPath + Entry->second->s_FileName;
+    int i_FD = open(s_FilePath.c_str(), O_RDONLY);
+    struct stat c_Stat;
+
+    if (i_FD < 0 || fstat(i_FD, &c_Stat) != 0 || (size_t)c_Stat.st_size < sizeof(FileHeader))
+    {
+        if (i_FD >= 0)
+        {
+            close(i_FD);
+        }
+
+        return false;
+    }
+
+    // @NOTE: The samples are stored as played, they are copied straight from
+    //        the mapped file without any decoding
+    size_t us_Size = c_Stat.st_size;
+    void* p_Map = mmap(NULL, us_Size, PROT_READ, MAP_PRIVATE, i_FD, 0);
+    bool b_Result = false;
+
+    if (p_Map != MAP_FAILED)
+    {
+        const MRH_Uint8* p_Bytes = (const MRH_Uint8*)p_Map;
+        FileHeader c_Header;
+
+        std::memcpy(&c_Header, p_Bytes, sizeof(FileHeader));
+
+        size_t us_Offset = GetSampleOffset(c_Header.u64_KeySize);
+
+        // Same file name does not mean same key, compare the stored key
+        if (c_Header.u32_Magic == CACHED_TTS_FILE_MAGIC &&
+            c_Header.u64_KeySize == s_Key.size() &&
+            us_Offset + (c_Header.u64_Samples * sizeof(MRH_Sint16)) == us_Size &&
+            std::memcmp(p_Bytes + sizeof(FileHeader), s_Key.data(), s_Key.size()) == 0)
+        {
+            c_Buffer.Reset(c_Header.u32_KHz);
+            c_Buffer.Add((const MRH_Sint16*)(p_Bytes + us_Offset), c_Header.u64_Samples);
+
+            b_Result = true;
+        }
+
+        munmap(p_Map, us_Size);
+    }
+
+    if (b_Result == true)
+    {
+        // Keep the use order for the next start
+        futimens(i_FD, NULL);
+        l_Disk.splice(l_Disk.begin(), l_Disk, Entry->second);
+
+        CACHED_TTS_LOG("Disk cache hit with " +
+                       std::to_string(c_Buffer.GetSampleCount()) +
+                       " samples.");
+    }
+
+    close(i_FD);
+
+    return b_Result;
+}
+
+void CachedTTS::AddDisk(std::string const& s_Key, AudioBuffer const& c_Buffer) noexcept
+{
+    std::string s_FileName = GetFileName(s_Key);
+    size_t us_Offset = GetSampleOffset(s_Key.size());
+    size_t us_Size = us_Offset + (c_Buffer.GetSampleCount() * sizeof(MRH_Sint16));
+
+    if (us_Size > us_MaxDiskSize)
+    {
+        return;
+    }
+
+    // Replace existing, a different key with the same file name is overwritten
+    auto Entry = m_Disk.find(s_FileName);
+
+    if (Entry != m_Disk.end())
+    {
+        us_DiskSize -= Entry->second->us_Size;
+        l_Disk.erase(Entry->second);
+        m_Disk.erase(Entry);
+    }
+
+    EvictDisk(us_Size);
+
+    // Write to a temporary file first, readers never see partial files
+    std::string s_FilePath = s_DirectoryPath + s_FileName;
+    std::string s_TempPath = s_FilePath + ".tmp";
+    int i_FD = open(s_TempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+    if (i_FD < 0)
+    {
+        MRH_LOG_WARNING("Failed to create TTS cache file {}: {}", s_TempPath, std::strerror(errno));
+        return;
+    }
+
+    FileHeader c_Header;
+    std::vector<MRH_Uint8> v_Padding(us_Offset - sizeof(FileHeader) - s_Key.size(), 0);
+    AudioBuffer::ConstRegion c_First;
+    AudioBuffer::ConstRegion c_Second;
+
+    std::memset(&c_Header, 0, sizeof(FileHeader));
+    c_Header.u32_Magic = CACHED_TTS_FILE_MAGIC;
+    c_Header.u32_KHz = c_Buffer.GetKHz();
+    c_Header.u64_KeySize = s_Key.size();
+    c_Header.u64_Samples = c_Buffer.GetReadRegions(c_First, c_Second);
+
+    bool b_Written = WriteAll(i_FD, &c_Header, sizeof(FileHeader)) &&
+                     WriteAll(i_FD, s_Key.data(), s_Key.size()) &&
+                     WriteAll(i_FD, v_Padding.data(), v_Padding.size()) &&
+                     WriteAll(i_FD, c_First.p_Samples, c_First.us_Samples * sizeof(MRH_Sint16)) &&
+                     WriteAll(i_FD, c_Second.p_Samples, c_Second.us_Samples * sizeof(MRH_Sint16));
+
+    close(i_FD);
+
+    if (b_Written == false || rename(s_TempPath.c_str(), s_FilePath.c_str()) != 0)
+    {
+        MRH_LOG_WARNING("Failed to write TTS cache file {}: {}", s_FilePath, std::strerror(errno));
+
+        unlink(s_TempPath.c_str());
+        return;
+    }
+
+    l_Disk.push_front(DiskEntry{ s_FileName, us_Size });
+    m_Disk.insert(std::make_pair(s_FileName, l_Disk.begin()));
+    us_DiskSize += us_Size;
+}
+
+void CachedTTS::EvictDisk(size_t us_Size) noexcept
+{
+    while (l_Disk.empty() == false && us_DiskSize + us_Size > us_MaxDiskSize)
+    {
+        DiskEntry& c_Entry = l_Disk.back();
+
+        unlink((s_DirectoryPath + c_Entry.s_FileName).c_str());
+
+        us_DiskSize -= c_Entry.us_Size;
+        m_Disk.erase(c_Entry.s_FileName);
+        l_Disk.pop_back();
+
+        u64_DiskEvictions.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+std::string CachedTTS::GetFileName(std::string const& s_Key) noexcept
+{
+    // FNV-1a, collisions are detected by the stored key
+    MRH_Uint64 u64_Hash = 14695981039346656037ULL;
+
+    for (char c : s_Key)
+    {
+        u64_Hash ^= (MRH_Uint8)c;
+        u64_Hash *= 1099511628211ULL;
+    }
+
+    char p_Name[17];
+    std::snprintf(p_Name, sizeof(p_Name), "%016llx", (unsigned long long)u64_Hash);
+
+    return std::string(p_Name) + CACHED_TTS_FILE_EXTENSION;
+}
+
+//*************************************************************************************
+// Getters
+//*************************************************************************************
+
+std::string CachedTTS::GetVoiceKey() const noexcept
+{
+    return s_VoiceKey;
+}
+
+CachedTTS::Statistics CachedTTS::GetStatistics() const noexcept
+{
+    Statistics c_Statistics;
+
+    c_Statistics.u64_Hits = u64_Hits.load(std::memory_order_relaxed);
+    c_Statistics.u64_DiskHits = u64_DiskHits.load(std::memory_order_relaxed);
+    c_Statistics.u64_Misses = u64_Misses.load(std::memory_order_relaxed);
+    c_Statistics.u64_Evictions = u64_Evictions.load(std::memory_order_relaxed);
+    c_Statistics.u64_DiskEvictions = u64_DiskEvictions.load(std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> c_Guard(c_Mutex);
+
+    c_Statistics.us_MemorySize = us_MemorySize;
+    c_Statistics.us_DiskSize = us_DiskSize;
+
+    return c_Statistics;
+}
+
+//*************************************************************************************
+// Statistics
+//*************************************************************************************
+
+void CachedTTS::Dump() noexcept
+{
+    Statistics c_Statistics = GetStatistics();
+
+    MRH_LOG_INFO("TTS cache statistics: {} hits, {} disk hits, {} misses, {} evictions, {} disk evictions.",
+                 c_Statistics.u64_Hits,
+                 c_Statistics.u64_DiskHits,
+                 c_Statistics.u64_Misses,
+                 c_Statistics.u64_Evictions,
+                 c_Statistics.u64_DiskEvictions);
+    MRH_LOG_INFO("TTS cache usage: Memory {} of {} bytes, Disk {} of {} bytes.",
+                 c_Statistics.us_MemorySize,
+                 us_MaxMemorySize,
+                 c_Statistics.us_DiskSize,
+                 us_MaxDiskSize);
+}
@@ -0,0 +1,239 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef CachedTTS_h
+#define CachedTTS_h
+
+// C / C++
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <list>
+#include <unordered_map>
+
+// External
+
+// Project
+#include "./TTS.h"
+#include "../Configuration.h"
+
+
+class CachedTTS : public TTS
+{
+public:
+
+    //*************************************************************************************
+    // Types
+    //*************************************************************************************
+
+    struct Statistics
+    {
+        MRH_Uint64 u64_Hits;
+        MRH_Uint64 u64_DiskHits;
+        MRH_Uint64 u64_Misses;
+        MRH_Uint64 u64_Evictions;
+        MRH_Uint64 u64_DiskEvictions;
+
+        size_t us_MemorySize;
+        size_t us_DiskSize;
+    };
+
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+
+    /**
+     *  Default constructor.
+     *
+     *  \param p_TTS The TTS to cache synthesized audio for.
+     *  \param c_Configuration The configuration to setup with.
+     */
+
+    CachedTTS(std::shared_ptr<TTS> p_TTS, Configuration::TTSCache const& c_Configuration);
+
+    /**
+     *  Default destructor.
+     */
+
+    ~CachedTTS() noexcept;
+
+    //*************************************************************************************
+    // Synthesize
+    //*************************************************************************************
+
+    /**
+     *  Synthesize speech output from a given text string. Cached audio is
+     *  used if available.
+     *
+     *  \param s_String The speech string to synthesize audio for.
+     *  \param c_Buffer The audio buffer to store audio in. The buffer is overwritten.
+     */
+
+    void Synthesize(std::string const& s_String, AudioBuffer& c_Buffer) override;
+
+    //*************************************************************************************
+    // Getters
+    //*************************************************************************************
+
+    /**
+     *  Get the key of the voice used for synthesis.
+     *
+     *  \return The voice key.
+     */
+
+    std::string GetVoiceKey() const noexcept override;
+
+    /**
+     *  Get the cache statistics.
+     *
+     *  \return The cache statistics.
+     */
+
+    Statistics GetStatistics() const noexcept;
+
+    //*************************************************************************************
+    // Statistics
+    //*************************************************************************************
+
+    /**
+     *  Write the cache statistics to the log.
+     */
+
+    void Dump() noexcept override;
+
+private:
+
+    //*************************************************************************************
+    // Types
+    //*************************************************************************************
+
+    struct MemoryEntry
+    {
+        std::string s_Key;
+        std::vector<MRH_Sint16> v_Sample;
+        MRH_Uint32 u32_KHz;
+    };
+
+    struct DiskEntry
+    {
+        std::string s_FileName;
+        size_t us_Size;
+    };
+
+    //*************************************************************************************
+    // Memory
+    //*************************************************************************************
+
+    /**
+     *  Get cached audio from memory.
+     *
+     *  \param s_Key The cache key.
+     *  \param c_Buffer The audio buffer to store audio in.
+     *
+     *  \return true if cached, false if not.
+     */
+
+    bool GetMemory(std::string const& s_Key, AudioBuffer& c_Buffer);
+
+    /**
+     *  Add audio to the memory cache.
+     *
+     *  \param s_Key The cache key.
+     *  \param c_Buffer The audio buffer to cache. The buffer is not changed.
+     */
+
+    void AddMemory(std::string const& s_Key, AudioBuffer const& c_Buffer);
+
+    //*************************************************************************************
+    // Disk
+    //*************************************************************************************
+
+    /**
+     *  Add existing cache files to the disk cache.
+     */
+
+    void LoadDisk() noexcept;
+
+    /**
+     *  Get cached audio from disk.
+     *
+     *  \param s_Key The cache key.
+     *  \param c_Buffer The audio buffer to store audio in.
+     *
+     *  \return true if cached, false if not.
+     */
+
+    bool GetDisk(std::string const& s_Key, AudioBuffer& c_Buffer);
+
+    /**
+     *  Add audio to the disk cache.
+     *
+     *  \param s_Key The cache key.
+     *  \param c_Buffer The audio buffer to cache. The buffer is not changed.
+     */
+
+    void AddDisk(std::string const& s_Key, AudioBuffer const& c_Buffer) noexcept;
+
+    /**
+     *  Remove the least recently used cache files until the given size fits.
+     *
+     *  \param us_Size The size to fit in bytes.
+     */
+
+    void EvictDisk(size_t us_Size) noexcept;
+
+    /**
+     *  Get the cache file name for a key.
+     *
+     *  \param s_Key The cache key.
+     *
+     *  \return The cache file name.
+     */
+
+    static std::string GetFileName(std::string const& s_Key) noexcept;
+
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+
+    std::shared_ptr<TTS> p_TTS;
+    std::string s_VoiceKey;
+
+    mutable std::mutex c_Mutex;
+
+    // @NOTE: Front is most recently used, disk entries are mapped by file name
+    std::list<MemoryEntry> l_Memory;
+    std::unordered_map<std::string, std::list<MemoryEntry>::iterator> m_Memory;
+    size_t us_MemorySize;
+    size_t us_MaxMemorySize;
+
+    std::list<DiskEntry> l_Disk;
+    std::unordered_map<std::string, std::list<DiskEntry>::iterator> m_Disk;
+    size_t us_DiskSize;
+    size_t us_MaxDiskSize;
+    std::string s_DirectoryPath;
+
+    std::atomic<MRH_Uint64> u64_Hits;
+    std::atomic<MRH_Uint64> u64_DiskHits;
+    std::atomic<MRH_Uint64> u64_Misses;
+    std::atomic<MRH_Uint64> u64_Evictions;
+    std::atomic<MRH_Uint64> u64_DiskEvictions;
+
+protected:
+
+};
+
+#endif /* CachedTTS_h */
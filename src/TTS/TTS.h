@@ -18,6 +18,9 @@
 #define TTS_h
 
 // C / C++
+#include <vector>
+#include <string>
+#include <cctype>
 
 // External
 
@@ -58,6 +61,87 @@ public:
         throw Exception("Default Synthesize() function called!");
     }
 
+    //*************************************************************************************
+    // Getters
+    //*************************************************************************************
+
+    /**
+     *  Get the key of the voice used for synthesis. The same string synthesized
+     *  with the same voice key results in the same audio.
+     *
+     *  \return The voice key.
+     */
+
+    virtual std::string GetVoiceKey() const noexcept
+    {
+        return s_Identifier;
+    }
+
+    //*************************************************************************************
+    // Statistics
+    //*************************************************************************************
+
+    /**
+     *  Write the TTS statistics to the log. Nothing is written by default.
+     */
+
+    virtual void Dump() noexcept
+    {}
+
+    //*************************************************************************************
+    // Split
+    //*************************************************************************************
+
+    /**
+     *  Split a speech string at sentence boundaries. The sentences can be
+     *  synthesized and played one after another.
+     *
+     *  \param s_String The speech string to split.
+     *
+     *  \return The sentences in speaking order.
+     */
+
+    static std::vector<std::string> SplitSentences(std::string const& s_String)
+    {
+        std::vector<std::string> v_Sentence;
+        size_t us_Start = 0;
+
+        for (size_t i = 0; i < s_String.size(); ++i)
+        {
+            // @NOTE: A terminator has to be followed by whitespace, numbers like
+            //        3.5 and repeated terminators stay in one sentence
+            bool b_End = (i + 1 == s_String.size());
+
+            if (s_String[i] == '\n')
+            {
+                b_End = true;
+            }
+            else if ((s_String[i] == '.' || s_String[i] == '!' || s_String[i] == '?') &&
+                     (b_End == true || isspace(static_cast<unsigned char>(s_String[i + 1])) != 0))
+            {
+                b_End = true;
+            }
+
+            if (b_End == false)
+            {
+                continue;
+            }
+
+            // Trim and add
+            size_t us_First = s_String.find_first_not_of(" \t\r\n", us_Start);
+            size_t us_Last = s_String.find_last_not_of(" \t\r\n", i);
+
+            if (us_First != std::string::npos && us_Last != std::string::npos && us_First <= us_Last)
+            {
+                v_Sentence.emplace_back(s_String.substr(us_First, us_Last - us_First + 1));
+            }
+
+            us_Start = i + 1;
+        }
+
+        return v_Sentence;
+    }
+
     //*************************************************************************************
     // Data
     //*************************************************************************************
@@ -84,10 +168,7 @@ protected:
 
     TTS(std::string const& s_Identifier) noexcept : s_Identifier(s_Identifier)
     {
-        Logger::Singleton().Log(Logger::INFO, "Created [ " +
-                                              s_Identifier +
-                                              " ] TTS API.",
-                                "TTS.h", __LINE__);
+        MRH_LOG_INFO("Created [ {} ] TTS API.", s_Identifier);
     }
 };
 
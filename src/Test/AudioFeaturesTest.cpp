@@ -0,0 +1,151 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+#include <vector>
+#include <random>
+#include <algorithm>
+
+// External
+
+// Project
+#include "./Test.h"
+#include "../Audio/AudioFeatures.h"
+
+// Pre-defined
+#define TEST_AUDIO_FEATURES_SEED 0x4D524853
+
+// Namespace
+namespace
+{
+    const MRH_Sfloat32 p_Gain[] = { 1.f, 0.37f, 3.9f, 40000.f };
+    const MRH_Sint16 p_Threshold[] = { 1, 1000, 32767 };
+
+    bool GetEqual(AudioFeatures::Features const& c_A, AudioFeatures::Features const& c_B) noexcept
+    {
+        return c_A.us_Samples == c_B.us_Samples &&
+               c_A.us_Loud == c_B.us_Loud &&
+               c_A.us_Crossings == c_B.us_Crossings &&
+               c_A.u64_Energy == c_B.u64_Energy;
+    }
+
+    void Compare(std::vector<MRH_Sint16> const& v_Input)
+    {
+        using namespace AudioFeatures;
+
+        const MRH_Sint16* p_Input = v_Input.data();
+        size_t us_Samples = v_Input.size();
+        std::vector<MRH_Sint16> v_Reference(us_Samples);
+        std::vector<MRH_Sint16> v_Output(us_Samples);
+
+        for (auto& Threshold : p_Threshold)
+        {
+            // Measure only
+            Features c_Reference = MeasureScalar(p_Input, us_Samples, Threshold);
+
+            MRH_TEST_ASSERT(GetEqual(Process<false, false>(p_Input, NULL, us_Samples, 1.f, Threshold), c_Reference));
+
+            // Copy
+            MRH_TEST_ASSERT(GetEqual(Process<false, true>(p_Input, v_Output.data(), us_Samples, 1.f, Threshold), c_Reference));
+            MRH_TEST_ASSERT(v_Output == v_Input);
+
+            for (auto& Gain : p_Gain)
+            {
+                c_Reference = AmplifyScalar(p_Input, v_Reference.data(), us_Samples, Gain, Threshold);
+
+                // Amplify without storing
+                MRH_TEST_ASSERT(GetEqual(Process<true, false>(p_Input, NULL, us_Samples, Gain, Threshold), c_Reference));
+
+                // Amplify into a separate output
+                MRH_TEST_ASSERT(GetEqual(Process<true, true>(p_Input, v_Output.data(), us_Samples, Gain, Threshold), c_Reference));
+                MRH_TEST_ASSERT(v_Output == v_Reference);
+
+                // Amplify in place
+                v_Output = v_Input;
+
+                MRH_TEST_ASSERT(GetEqual(Process<true, true>(v_Output.data(), v_Output.data(), us_Samples, Gain, Threshold), c_Reference));
+                MRH_TEST_ASSERT(v_Output == v_Reference);
+            }
+        }
+    }
+}
+
+
+//*************************************************************************************
+// AudioFeatures
+//*************************************************************************************
+
+void Test::AudioFeatures()
+{
+    std::mt19937 c_Random(TEST_AUDIO_FEATURES_SEED);
+    std::uniform_int_distribution<int> c_Full(-32768, 32767);
+    std::uniform_int_distribution<int> c_Quiet(-64, 64);
+
+    // @NOTE: Every length around the vector sizes and the counter block size,
+    //        the tail is processed by the scalar loop
+    std::vector<size_t> v_Length;
+
+    for (size_t i = 0; i <= 65; ++i)
+    {
+        v_Length.push_back(i);
+    }
+
+    v_Length.push_back(1000);
+    v_Length.push_back(MRH_AUDIO_FEATURES_BLOCK_SAMPLES - 1);
+    v_Length.push_back(MRH_AUDIO_FEATURES_BLOCK_SAMPLES);
+    v_Length.push_back(MRH_AUDIO_FEATURES_BLOCK_SAMPLES + 1);
+    v_Length.push_back(MRH_AUDIO_FEATURES_BLOCK_SAMPLES * 2 + 17);
+
+    for (auto& Length : v_Length)
+    {
+        std::vector<MRH_Sint16> v_Input(Length);
+
+        // Random full range and quiet samples
+        for (auto& Sample : v_Input)
+        {
+            Sample = static_cast<MRH_Sint16>(c_Full(c_Random));
+        }
+
+        Compare(v_Input);
+
+        for (auto& Sample : v_Input)
+        {
+            Sample = static_cast<MRH_Sint16>(c_Quiet(c_Random));
+        }
+
+        Compare(v_Input);
+
+        // Extremes, every lane loud and crossing
+        for (size_t i = 0; i < Length; ++i)
+        {
+            v_Input[i] = (i % 2 == 0) ? -32768 : 32767;
+        }
+
+        Compare(v_Input);
+
+        // Constant minimum, the largest squares
+        std::fill(v_Input.begin(), v_Input.end(), -32768);
+        Compare(v_Input);
+
+        // Silence and zero crossing edges
+        for (size_t i = 0; i < Length; ++i)
+        {
+            v_Input[i] = (i % 3 == 0) ? -1 : 0;
+        }
+
+        Compare(v_Input);
+    }
+}
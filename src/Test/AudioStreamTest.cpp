@@ -0,0 +1,227 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <vector>
+
+// External
+
+// Project
+#include "./Test.h"
+#include "../Stream/AudioStream.h"
+
+// Pre-defined
+#define TEST_AUDIO_STREAM_KHZ 16000
+#define TEST_AUDIO_STREAM_CHUNK 4096 // Samples per written chunk
+#define TEST_AUDIO_STREAM_HEADER_SIZE 32
+#define TEST_AUDIO_STREAM_CHUNK_MAX 10000 // Chunks written to fill the socket
+
+// Namespace
+namespace
+{
+    struct Frame
+    {
+        MRH_Uint8 u8_Flags;
+        MRH_Uint32 u32_Utterance;
+        MRH_Uint64 u64_Sample;
+        MRH_Uint32 u32_Samples;
+    };
+
+    MRH_Uint64 GetLE(const MRH_Uint8* p_Bytes, size_t us_Bytes) noexcept
+    {
+        MRH_Uint64 u64_Value = 0;
+
+        for (size_t i = 0; i < us_Bytes; ++i)
+        {
+            u64_Value |= static_cast<MRH_Uint64>(p_Bytes[i]) << (8 * i);
+        }
+
+        return u64_Value;
+    }
+
+    void Drain(int i_FD, std::vector<MRH_Uint8>& v_Received) noexcept
+    {
+        MRH_Uint8 p_Buffer[65536];
+        ssize_t ss_Result;
+
+        while ((ss_Result = recv(i_FD, p_Buffer, sizeof(p_Buffer), MSG_DONTWAIT)) > 0)
+        {
+            v_Received.insert(v_Received.end(), p_Buffer, p_Buffer + ss_Result);
+        }
+    }
+
+    std::vector<Frame> Parse(std::vector<MRH_Uint8> const& v_Received)
+    {
+        std::vector<Frame> v_Frame;
+        size_t us_Pos = 0;
+
+        while (us_Pos < v_Received.size())
+        {
+            MRH_TEST_ASSERT(v_Received.size() - us_Pos >= TEST_AUDIO_STREAM_HEADER_SIZE);
+
+            const MRH_Uint8* p_Header = &(v_Received[us_Pos]);
+            Frame c_Frame;
+
+            c_Frame.u8_Flags = p_Header[1];
+            c_Frame.u64_Sample = GetLE(&(p_Header[16]), 8);
+            c_Frame.u32_Utterance = static_cast<MRH_Uint32>(GetLE(&(p_Header[24]), 4));
+            c_Frame.u32_Samples = static_cast<MRH_Uint32>(GetLE(&(p_Header[28]), 4));
+
+            us_Pos += TEST_AUDIO_STREAM_HEADER_SIZE + (c_Frame.u32_Samples * sizeof(MRH_Sint16));
+            MRH_TEST_ASSERT(us_Pos <= v_Received.size());
+
+            v_Frame.push_back(c_Frame);
+        }
+
+        return v_Frame;
+    }
+}
+
+
+//*************************************************************************************
+// AudioStream
+//*************************************************************************************
+
+void Test::AudioStream()
+{
+    std::string s_SocketPath = "/tmp/mrhspeechd-tests-" + std::to_string(getpid()) + ".sock";
+    struct sockaddr_un c_Address;
+
+    std::memset(&c_Address, 0, sizeof(c_Address));
+    c_Address.sun_family = AF_UNIX;
+    strcpy(c_Address.sun_path, s_SocketPath.c_str());
+
+    int i_Listen = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+    MRH_TEST_ASSERT(i_Listen >= 0);
+
+    unlink(s_SocketPath.c_str());
+
+    if (bind(i_Listen, (struct sockaddr*)&c_Address, sizeof(c_Address)) < 0 || listen(i_Listen, 1) < 0)
+    {
+        close(i_Listen);
+        throw Exception("Failed to listen on " + s_SocketPath + ": " + std::strerror(errno));
+    }
+
+    int i_Peer = -1;
+
+    try
+    {
+        ::AudioStream c_Stream(s_SocketPath);
+
+        MRH_TEST_ASSERT(c_Stream.IsConnected() == true);
+        MRH_TEST_ASSERT((i_Peer = accept(i_Listen, NULL, NULL)) >= 0);
+
+        AudioBuffer c_Buffer(TEST_AUDIO_STREAM_KHZ);
+        std::vector<MRH_Sint16> v_Chunk(TEST_AUDIO_STREAM_CHUNK, 1);
+        c_Buffer.Add(v_Chunk.data(), v_Chunk.size());
+
+        std::vector<MRH_Uint8> v_Received;
+
+        /**
+         *  Fill
+         */
+
+        // Utterance 1 until the receiver stops taking chunks
+        for (int i = 0; i < TEST_AUDIO_STREAM_CHUNK_MAX && c_Stream.GetDropped() == 0; ++i)
+        {
+            c_Stream.Write(c_Buffer);
+        }
+
+        MRH_TEST_ASSERT(c_Stream.GetDropped() > 0);
+
+        // The end marker and the first chunk of utterance 2 cannot be written,
+        // a failed marker is no dropped chunk
+        MRH_Uint64 u64_Dropped = c_Stream.GetDropped();
+
+        c_Stream.Finish(false);
+        MRH_TEST_ASSERT(c_Stream.GetDropped() == u64_Dropped);
+
+        c_Stream.Write(c_Buffer);
+        MRH_TEST_ASSERT(c_Stream.GetDropped() == u64_Dropped + 1);
+
+        /**
+         *  Retry
+         */
+
+        Drain(i_Peer, v_Received);
+
+        c_Stream.Write(c_Buffer);
+        MRH_TEST_ASSERT(c_Stream.GetDropped() == u64_Dropped + 1);
+
+        Drain(i_Peer, v_Received);
+
+        c_Stream.Finish(false);
+        Drain(i_Peer, v_Received);
+
+        /**
+         *  Check
+         */
+
+        std::vector<Frame> v_Frame = Parse(v_Received);
+        size_t us_End = v_Frame.size();
+
+        MRH_TEST_ASSERT(v_Frame.size() >= 4);
+        MRH_TEST_ASSERT(v_Frame[0].u32_Utterance == 1 && v_Frame[0].u8_Flags == AudioStream::FLAG_START);
+
+        for (size_t i = 0; i < v_Frame.size(); ++i)
+        {
+            if (v_Frame[i].u8_Flags == AudioStream::FLAG_END)
+            {
+                us_End = i;
+                break;
+            }
+
+            MRH_TEST_ASSERT(v_Frame[i].u32_Utterance == 1);
+            MRH_TEST_ASSERT(i == 0 || v_Frame[i].u8_Flags == 0);
+        }
+
+        // Utterance 1 ends before utterance 2 starts with its first sent chunk
+        MRH_TEST_ASSERT(v_Frame.size() - us_End == 3);
+        MRH_TEST_ASSERT(v_Frame[us_End].u32_Utterance == 1 && v_Frame[us_End].u32_Samples == 0);
+
+        Frame const& c_Start = v_Frame[us_End + 1];
+
+        MRH_TEST_ASSERT(c_Start.u32_Utterance == 2 && c_Start.u8_Flags == AudioStream::FLAG_START);
+        MRH_TEST_ASSERT(c_Start.u64_Sample == TEST_AUDIO_STREAM_CHUNK && c_Start.u32_Samples == TEST_AUDIO_STREAM_CHUNK);
+
+        Frame const& c_End = v_Frame[us_End + 2];
+
+        MRH_TEST_ASSERT(c_End.u32_Utterance == 2 && c_End.u8_Flags == AudioStream::FLAG_END);
+        MRH_TEST_ASSERT(c_End.u64_Sample == 2 * TEST_AUDIO_STREAM_CHUNK);
+    }
+    catch (...)
+    {
+        if (i_Peer >= 0)
+        {
+            close(i_Peer);
+        }
+
+        close(i_Listen);
+        unlink(s_SocketPath.c_str());
+
+        throw;
+    }
+
+    close(i_Peer);
+    close(i_Listen);
+    unlink(s_SocketPath.c_str());
+}
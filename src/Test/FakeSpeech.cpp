@@ -0,0 +1,213 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+#include <chrono>
+
+// External
+
+// Project
+#include "./FakeSpeech.h"
+#include "../Exception.h"
+
+// Namespace
+using google::cloud::speech::v1::RecognizeRequest;
+using google::cloud::speech::v1::RecognizeResponse;
+using google::cloud::speech::v1::StreamingRecognizeRequest;
+using google::cloud::speech::v1::StreamingRecognizeResponse;
+using google::cloud::speech::v1::StreamingRecognitionResult;
+using google::cloud::speech::v1::SpeechRecognitionAlternative;
+
+
+//*************************************************************************************
+// Constructor / Destructor
+//*************************************************************************************
+
+FakeSpeech::FakeSpeech() : i_Port(0),
+                           us_Calls(0),
+                           c_Status(grpc::Status::OK)
+{
+    grpc::ServerBuilder c_Builder;
+
+    c_Builder.AddListeningPort("127.0.0.1:0", grpc::InsecureServerCredentials(), &i_Port);
+    c_Builder.RegisterService(this);
+
+    p_Server = c_Builder.BuildAndStart();
+
+    if (p_Server == NULL || i_Port == 0)
+    {
+        throw Exception("Failed to start fake speech server!");
+    }
+}
+
+FakeSpeech::~FakeSpeech() noexcept
+{
+    p_Server->Shutdown(std::chrono::system_clock::now());
+    p_Server->Wait();
+}
+
+//*************************************************************************************
+// Service
+//*************************************************************************************
+
+grpc::Status FakeSpeech::Recognize(grpc::ServerContext* p_Context,
+                                   const RecognizeRequest* p_Request,
+                                   RecognizeResponse* p_Response)
+{
+    Call c_Received;
+
+    c_Received.s_LanguageCode = p_Request->config().language_code();
+    c_Received.u32_KHz = static_cast<MRH_Uint32>(p_Request->config().sample_rate_hertz());
+    c_Received.b_ConfigFirst = true;
+    c_Received.s_Audio = p_Request->audio().content();
+    c_Received.us_Requests = 1;
+    c_Received.us_MaxRequestBytes = c_Received.s_Audio.size();
+
+    grpc::Status c_Result = AddCall(p_Context, c_Received);
+
+    if (c_Result.ok() == true)
+    {
+        p_Response->add_results()->add_alternatives()->set_transcript("recognized");
+    }
+
+    return c_Result;
+}
+
+grpc::Status FakeSpeech::StreamingRecognize(grpc::ServerContext* p_Context,
+                                            grpc::ServerReaderWriter<StreamingRecognizeResponse, StreamingRecognizeRequest>* p_Stream)
+{
+    Call c_Received;
+    StreamingRecognizeRequest c_Request;
+
+    // Read until the client finished writing or cancelled
+    while (p_Stream->Read(&c_Request) == true)
+    {
+        if (c_Request.has_streaming_config() == true)
+        {
+            auto const& c_Config = c_Request.streaming_config().config();
+
+            c_Received.s_LanguageCode = c_Config.language_code();
+            c_Received.u32_KHz = static_cast<MRH_Uint32>(c_Config.sample_rate_hertz());
+            c_Received.b_ConfigFirst = (c_Received.us_Requests == 0);
+        }
+        else
+        {
+            c_Received.s_Audio += c_Request.audio_content();
+
+            if (c_Received.us_MaxRequestBytes < c_Request.audio_content().size())
+            {
+                c_Received.us_MaxRequestBytes = c_Request.audio_content().size();
+            }
+        }
+
+        ++(c_Received.us_Requests);
+    }
+
+    grpc::Status c_Result = AddCall(p_Context, c_Received);
+
+    if (c_Result.ok() == false || p_Context->IsCancelled() == true)
+    {
+        return c_Result;
+    }
+
+    // Interim results are not part of the transcript
+    StreamingRecognizeResponse c_Response;
+    StreamingRecognitionResult* p_Result = c_Response.add_results();
+
+    p_Result->set_is_final(false);
+    p_Result->add_alternatives()->set_transcript("interim");
+
+    p_Stream->Write(c_Response);
+
+    // Final results, the second with a less likely alternative
+    c_Response.Clear();
+    p_Result = c_Response.add_results();
+
+    p_Result->set_is_final(true);
+    p_Result->add_alternatives()->set_transcript("hello");
+
+    p_Result = c_Response.add_results();
+    p_Result->set_is_final(true);
+
+    SpeechRecognitionAlternative* p_Alternative = p_Result->add_alternatives();
+    p_Alternative->set_transcript(" world");
+    p_Alternative->set_confidence(0.9f);
+
+    p_Alternative = p_Result->add_alternatives();
+    p_Alternative->set_transcript(" word");
+    p_Alternative->set_confidence(0.5f);
+
+    p_Stream->Write(c_Response);
+
+    return c_Result;
+}
+
+//*************************************************************************************
+// Calls
+//*************************************************************************************
+
+grpc::Status FakeSpeech::AddCall(grpc::ServerContext* p_Context, Call const& c_Call) noexcept
+{
+    std::lock_guard<std::mutex> c_Guard(c_Mutex);
+
+    this->c_Call = c_Call;
+    ++us_Calls;
+    ++(m_Peer[p_Context->peer()]);
+
+    return c_Status;
+}
+
+//*************************************************************************************
+// Getters
+//*************************************************************************************
+
+std::string FakeSpeech::GetAddress() const noexcept
+{
+    return "127.0.0.1:" + std::to_string(i_Port);
+}
+
+std::shared_ptr<google::cloud::speech::v1::Speech::Stub> FakeSpeech::GetStub()
+{
+    return google::cloud::speech::v1::Speech::NewStub(grpc::CreateChannel(GetAddress(), grpc::InsecureChannelCredentials()));
+}
+
+FakeSpeech::Call FakeSpeech::GetCall() noexcept
+{
+    std::lock_guard<std::mutex> c_Guard(c_Mutex);
+    return c_Call;
+}
+
+size_t FakeSpeech::GetCallCount() noexcept
+{
+    std::lock_guard<std::mutex> c_Guard(c_Mutex);
+    return us_Calls;
+}
+
+size_t FakeSpeech::GetConnectionCount() noexcept
+{
+    std::lock_guard<std::mutex> c_Guard(c_Mutex);
+    return m_Peer.size();
+}
+
+//*************************************************************************************
+// Setters
+//*************************************************************************************
+
+void FakeSpeech::SetStatus(grpc::Status const& c_Status) noexcept
+{
+    std::lock_guard<std::mutex> c_Guard(c_Mutex);
+    this->c_Status = c_Status;
+}
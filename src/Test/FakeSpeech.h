@@ -0,0 +1,191 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef FakeSpeech_h
+#define FakeSpeech_h
+
+// C / C++
+#include <memory>
+#include <mutex>
+#include <string>
+#include <map>
+
+// External
+#include <google/cloud/speech/v1/cloud_speech.grpc.pb.h>
+#include <grpcpp/grpcpp.h>
+#include <MRH_Typedefs.h>
+
+// Project
+
+
+class FakeSpeech : public google::cloud::speech::v1::Speech::Service
+{
+public:
+
+    //*************************************************************************************
+    // Types
+    //*************************************************************************************
+
+    struct Call
+    {
+        std::string s_LanguageCode = "";
+        MRH_Uint32 u32_KHz = 0;
+        bool b_ConfigFirst = false; // Only the first request held the configuration
+
+        std::string s_Audio = ""; // All received audio bytes in order
+        size_t us_Requests = 0;
+        size_t us_MaxRequestBytes = 0;
+    };
+
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+
+    /**
+     *  Default constructor. The server listens on a free local port.
+     */
+
+    FakeSpeech();
+
+    /**
+     *  Default destructor. Running calls are cancelled.
+     */
+
+    ~FakeSpeech() noexcept;
+
+    //*************************************************************************************
+    // Service
+    //*************************************************************************************
+
+    /**
+     *  Transcribe a unary request. One final result is returned.
+     *
+     *  \param p_Context The server call context.
+     *  \param p_Request The received request.
+     *  \param p_Response The response to fill.
+     *
+     *  \return The call status.
+     */
+
+    grpc::Status Recognize(grpc::ServerContext* p_Context,
+                           const google::cloud::speech::v1::RecognizeRequest* p_Request,
+                           google::cloud::speech::v1::RecognizeResponse* p_Response) override;
+
+    /**
+     *  Transcribe a stream. A interim result and two final results are returned
+     *  once the client finished writing.
+     *
+     *  \param p_Context The server call context.
+     *  \param p_Stream The call stream.
+     *
+     *  \return The call status.
+     */
+
+    grpc::Status StreamingRecognize(grpc::ServerContext* p_Context,
+                                    grpc::ServerReaderWriter<google::cloud::speech::v1::StreamingRecognizeResponse,
+                                                             google::cloud::speech::v1::StreamingRecognizeRequest>* p_Stream) override;
+
+    //*************************************************************************************
+    // Getters
+    //*************************************************************************************
+
+    /**
+     *  Get the server address.
+     *
+     *  \return The local address the server listens on.
+     */
+
+    std::string GetAddress() const noexcept;
+
+    /**
+     *  Get a stub connected to the server with its own insecure channel.
+     *
+     *  \return The connected stub.
+     */
+
+    std::shared_ptr<google::cloud::speech::v1::Speech::Stub> GetStub();
+
+    /**
+     *  Get the last received call.
+     *
+     *  \return The last call.
+     */
+
+    Call GetCall() noexcept;
+
+    /**
+     *  Get the number of calls received.
+     *
+     *  \return The call count.
+     */
+
+    size_t GetCallCount() noexcept;
+
+    /**
+     *  Get the number of client connections calls were received from.
+     *
+     *  \return The connection count.
+     */
+
+    size_t GetConnectionCount() noexcept;
+
+    //*************************************************************************************
+    // Setters
+    //*************************************************************************************
+
+    /**
+     *  Set the status returned by the following calls.
+     *
+     *  \param c_Status The status to return.
+     */
+
+    void SetStatus(grpc::Status const& c_Status) noexcept;
+
+private:
+
+    //*************************************************************************************
+    // Calls
+    //*************************************************************************************
+
+    /**
+     *  Add a received call.
+     *
+     *  \param p_Context The server call context.
+     *  \param c_Call The received call.
+     *
+     *  \return The status to return.
+     */
+
+    grpc::Status AddCall(grpc::ServerContext* p_Context, Call const& c_Call) noexcept;
+
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+
+    std::unique_ptr<grpc::Server> p_Server;
+    int i_Port;
+
+    std::mutex c_Mutex;
+    Call c_Call;
+    size_t us_Calls;
+    std::map<std::string, size_t> m_Peer; // Calls per client connection peer address
+    grpc::Status c_Status;
+
+protected:
+
+};
+
+#endif /* FakeSpeech_h */
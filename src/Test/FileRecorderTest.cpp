@@ -0,0 +1,118 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+#include <unistd.h>
+#include <chrono>
+#include <thread>
+
+// External
+
+// Project
+#include "./Test.h"
+#include "./SpeechFixture.h"
+#include "../Audio/API/File/FileRecorder.h"
+
+// Pre-defined
+#define TEST_FILE_RECORDER_TIMEOUT_MS 10000
+
+// Namespace
+namespace
+{
+    std::vector<MRH_Sint16> Record(std::string const& s_FilePath, MRH_Uint32 u32_PreRollSize)
+    {
+        std::shared_ptr<EventQueue> p_EventQueue = std::make_shared<EventQueue>(std::vector<int>(), 1);
+        std::shared_ptr<SpeechChecker> p_SpeechChecker = std::make_shared<SpeechFixture::ThresholdChecker>();
+        std::shared_ptr<Latency::Marks> p_Marks = std::make_shared<Latency::Marks>();
+        std::shared_ptr<RecorderContext> p_Context = std::make_shared<RecorderContext>(p_EventQueue, 0, p_SpeechChecker, p_Marks);
+
+        Configuration::FileRecorder c_Configuration;
+        c_Configuration.s_FilePath = s_FilePath;
+        c_Configuration.u32_KHz = TEST_SPEECH_FIXTURE_KHZ;
+        c_Configuration.u32_SamplesPerFrame = TEST_SPEECH_FIXTURE_FRAME;
+        c_Configuration.u32_TrailingFrameSize = 2 * TEST_SPEECH_FIXTURE_FRAME;
+        c_Configuration.u32_PreRollSize = u32_PreRollSize;
+        c_Configuration.f32_Speed = 0.f; // As fast as possible
+        c_Configuration.b_Loop = false;
+
+        FileRecorder c_Recorder(c_Configuration, p_Context);
+        c_Recorder.Start(true);
+
+        // Recording ends after the trailing frames
+        auto c_Timeout = std::chrono::steady_clock::now() + std::chrono::milliseconds(TEST_FILE_RECORDER_TIMEOUT_MS);
+
+        while (c_Recorder.GetRecording() == true)
+        {
+            MRH_TEST_ASSERT(std::chrono::steady_clock::now() < c_Timeout);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        MRH_TEST_ASSERT(c_Recorder.GetSpeechRecorded() == true);
+
+        AudioBuffer c_Buffer(TEST_SPEECH_FIXTURE_KHZ);
+        c_Recorder.GetRecordedAudio(c_Buffer);
+
+        std::vector<MRH_Sint16> v_Recorded(c_Buffer.GetSampleCount());
+        c_Buffer.RetrieveBytes(reinterpret_cast<char*>(v_Recorded.data()), v_Recorded.size());
+
+        return v_Recorded;
+    }
+}
+
+
+//*************************************************************************************
+// FileRecorder
+//*************************************************************************************
+
+void Test::FileRecorder()
+{
+    std::vector<MRH_Sint16> v_Fixture = SpeechFixture::Create();
+    std::string s_FilePath = SpeechFixture::Write(v_Fixture);
+
+    try
+    {
+        /**
+         *  Pre-Roll
+         */
+
+        std::vector<MRH_Sint16> v_Recorded = Record(s_FilePath, TEST_SPEECH_FIXTURE_PRE_ROLL);
+        size_t us_Start = SpeechFixture::GetStart(v_Recorded, v_Fixture);
+
+        // The quiet onset is kept, at most the pre-roll precedes it
+        MRH_TEST_ASSERT(us_Start <= SpeechFixture::us_Onset);
+        MRH_TEST_ASSERT(SpeechFixture::us_Onset - us_Start <= TEST_SPEECH_FIXTURE_PRE_ROLL);
+        MRH_TEST_ASSERT(us_Start + v_Recorded.size() >= SpeechFixture::us_Silence);
+
+        /**
+         *  No Pre-Roll
+         */
+
+        // @NOTE: Without pre-roll recording starts at the detected frame, the
+        //        fixture has to show the clipped onset
+        v_Recorded = Record(s_FilePath, 0);
+        us_Start = SpeechFixture::GetStart(v_Recorded, v_Fixture);
+
+        MRH_TEST_ASSERT(us_Start > SpeechFixture::us_Onset);
+        MRH_TEST_ASSERT(us_Start <= SpeechFixture::us_Loud);
+    }
+    catch (...)
+    {
+        unlink(s_FilePath.c_str());
+        throw;
+    }
+
+    unlink(s_FilePath.c_str());
+}
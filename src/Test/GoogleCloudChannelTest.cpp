@@ -0,0 +1,131 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// External
+
+// Project
+#include "./Test.h"
+#include "./FakeSpeech.h"
+#include "../GoogleCloud/GoogleCloudChannel.h"
+
+// Pre-defined
+#define TEST_GOOGLE_CLOUD_CHANNEL_TARGET "speech.stand-in.test"
+#define TEST_GOOGLE_CLOUD_CHANNEL_TIMEOUT_MS 5000
+#define TEST_GOOGLE_CLOUD_CHANNEL_STUBS 4 // One per API instance
+#define TEST_GOOGLE_CLOUD_CHANNEL_CALLS 10 // Per stub
+
+// Namespace
+using google::cloud::speech::v1::Speech;
+using google::cloud::speech::v1::RecognizeRequest;
+using google::cloud::speech::v1::RecognizeResponse;
+
+namespace
+{
+    bool Recognize(Speech::Stub& c_Stub) noexcept
+    {
+        RecognizeRequest c_Request;
+        RecognizeResponse c_Response;
+        grpc::ClientContext c_Context;
+
+        c_Request.mutable_config()->set_sample_rate_hertz(16000);
+        c_Request.mutable_audio()->mutable_content()->assign(320, '\0');
+
+        GoogleCloudChannel::SetDeadline(c_Context, TEST_GOOGLE_CLOUD_CHANNEL_TIMEOUT_MS);
+
+        return c_Stub.Recognize(&c_Context, c_Request, &c_Response).ok();
+    }
+}
+
+
+//*************************************************************************************
+// GoogleCloudChannel
+//*************************************************************************************
+
+void Test::GoogleCloudChannel()
+{
+    FakeSpeech c_Server;
+
+    ::GoogleCloudChannel::SetStandIn(TEST_GOOGLE_CLOUD_CHANNEL_TARGET, c_Server.GetAddress());
+
+    /**
+     *  Shared Channel
+     */
+
+    // The endpoint channel is created once and connected before any request
+    std::shared_ptr<grpc::Channel> p_Channel = ::GoogleCloudChannel::GetChannel(TEST_GOOGLE_CLOUD_CHANNEL_TARGET);
+
+    MRH_TEST_ASSERT(::GoogleCloudChannel::GetChannel(TEST_GOOGLE_CLOUD_CHANNEL_TARGET) == p_Channel);
+    MRH_TEST_ASSERT(::GoogleCloudChannel::Warm(p_Channel, TEST_GOOGLE_CLOUD_CHANNEL_TIMEOUT_MS) == true);
+    MRH_TEST_ASSERT(p_Channel->GetState(false) == GRPC_CHANNEL_READY);
+
+    /**
+     *  Requests
+     */
+
+    // Stubs of all instances call concurrently over the same connection
+    std::vector<std::thread> v_Thread;
+    std::atomic<size_t> us_Failed(0);
+
+    for (size_t i = 0; i < TEST_GOOGLE_CLOUD_CHANNEL_STUBS; ++i)
+    {
+        v_Thread.emplace_back([&]()
+        {
+            std::unique_ptr<Speech::Stub> p_Stub = Speech::NewStub(::GoogleCloudChannel::GetChannel(TEST_GOOGLE_CLOUD_CHANNEL_TARGET));
+
+            for (size_t j = 0; j < TEST_GOOGLE_CLOUD_CHANNEL_CALLS; ++j)
+            {
+                if (Recognize(*p_Stub) == false)
+                {
+                    us_Failed += 1;
+                }
+            }
+        });
+    }
+
+    for (auto& Thread : v_Thread)
+    {
+        Thread.join();
+    }
+
+    MRH_TEST_ASSERT(us_Failed == 0);
+    MRH_TEST_ASSERT(c_Server.GetCallCount() == TEST_GOOGLE_CLOUD_CHANNEL_STUBS * TEST_GOOGLE_CLOUD_CHANNEL_CALLS);
+    MRH_TEST_ASSERT(c_Server.GetConnectionCount() == 1);
+
+    /**
+     *  Connection Count
+     */
+
+    // Channels with their own subchannels open a new connection each, as
+    // every request did before the shared channel
+    for (size_t i = 0; i < 2; ++i)
+    {
+        grpc::ChannelArguments c_Arguments;
+        c_Arguments.SetInt(GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL, 1);
+
+        std::unique_ptr<Speech::Stub> p_Stub = Speech::NewStub(grpc::CreateCustomChannel(c_Server.GetAddress(),
+                                                                                         grpc::InsecureChannelCredentials(),
+                                                                                         c_Arguments));
+
+        MRH_TEST_ASSERT(Recognize(*p_Stub) == true);
+    }
+
+    MRH_TEST_ASSERT(c_Server.GetConnectionCount() == 3);
+}
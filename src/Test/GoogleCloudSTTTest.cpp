@@ -0,0 +1,158 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+#include <vector>
+
+// External
+
+// Project
+#include "./Test.h"
+#include "./FakeSpeech.h"
+#include "../STT/API/GoogleCloudSTT/GoogleCloudSTTStream.h"
+
+// Pre-defined
+#define TEST_GOOGLE_CLOUD_STT_KHZ 16000
+#define TEST_GOOGLE_CLOUD_STT_LANGUAGE_CODE "en-US"
+#define TEST_GOOGLE_CLOUD_STT_MAX_REQUEST_BYTES 16384
+
+
+//*************************************************************************************
+// GoogleCloudSTTStream
+//*************************************************************************************
+
+void Test::GoogleCloudSTTStream()
+{
+    FakeSpeech c_Server;
+    std::shared_ptr<google::cloud::speech::v1::Speech::Stub> p_Speech = c_Server.GetStub();
+
+    /**
+     *  Transcribe
+     */
+
+    // Recorded chunks as accepted by the speech checker, the second is split
+    // into multiple requests
+    const size_t p_Chunk[] = { 1024, 20000, 3 };
+    std::vector<MRH_Sint16> v_Recorded;
+    AudioBuffer c_Buffer(TEST_GOOGLE_CLOUD_STT_KHZ);
+    STTResult c_Result;
+
+    {
+        ::GoogleCloudSTTStream c_Stream(p_Speech,
+                                        TEST_GOOGLE_CLOUD_STT_LANGUAGE_CODE,
+                                        2,
+                                        false,
+                                        TEST_GOOGLE_CLOUD_STT_KHZ);
+
+        for (auto& Chunk : p_Chunk)
+        {
+            std::vector<MRH_Sint16> v_Chunk(Chunk);
+
+            for (size_t i = 0; i < Chunk; ++i)
+            {
+                v_Chunk[i] = static_cast<MRH_Sint16>((v_Recorded.size() + i) * 7919);
+            }
+
+            v_Recorded.insert(v_Recorded.end(), v_Chunk.begin(), v_Chunk.end());
+
+            c_Buffer.Add(v_Chunk.data(), v_Chunk.size());
+            c_Stream.Feed(c_Buffer);
+
+            MRH_TEST_ASSERT(c_Buffer.GetSampleCount() == 0);
+        }
+
+        c_Stream.Finish(c_Result);
+
+        // Finished streams cannot be used again
+        bool b_Thrown = false;
+
+        try
+        {
+            c_Stream.Finish(c_Result);
+        }
+        catch (Exception& e)
+        {
+            b_Thrown = true;
+        }
+
+        MRH_TEST_ASSERT(b_Thrown == true);
+    }
+
+    // Interim results are ignored, final results are the segments
+    MRH_TEST_ASSERT(c_Result.s_Transcript == "hello world");
+    MRH_TEST_ASSERT(c_Result.v_Segment.size() == 2);
+    MRH_TEST_ASSERT(c_Result.v_Segment[1].v_Alternative.size() == 2);
+    MRH_TEST_ASSERT(c_Result.v_Segment[1].v_Alternative[0].s_Transcript == " world");
+    MRH_TEST_ASSERT(c_Result.f32_Confidence > 0.89f && c_Result.f32_Confidence < 0.91f);
+
+    // The configuration is sent first, followed by the exact recorded audio
+    FakeSpeech::Call c_Call = c_Server.GetCall();
+
+    MRH_TEST_ASSERT(c_Call.b_ConfigFirst == true);
+    MRH_TEST_ASSERT(c_Call.s_LanguageCode == TEST_GOOGLE_CLOUD_STT_LANGUAGE_CODE);
+    MRH_TEST_ASSERT(c_Call.u32_KHz == TEST_GOOGLE_CLOUD_STT_KHZ);
+    MRH_TEST_ASSERT(c_Call.us_MaxRequestBytes <= TEST_GOOGLE_CLOUD_STT_MAX_REQUEST_BYTES);
+    MRH_TEST_ASSERT(c_Call.us_Requests > 1 + (sizeof(p_Chunk) / sizeof(p_Chunk[0])));
+    MRH_TEST_ASSERT(c_Call.s_Audio.size() == v_Recorded.size() * sizeof(MRH_Sint16));
+    MRH_TEST_ASSERT(c_Call.s_Audio.compare(0, std::string::npos, reinterpret_cast<const char*>(v_Recorded.data()), v_Recorded.size() * sizeof(MRH_Sint16)) == 0);
+
+    /**
+     *  Abandon
+     */
+
+    // Streams destroyed without finishing are cancelled
+    {
+        ::GoogleCloudSTTStream c_Stream(p_Speech,
+                                        TEST_GOOGLE_CLOUD_STT_LANGUAGE_CODE,
+                                        1,
+                                        false,
+                                        TEST_GOOGLE_CLOUD_STT_KHZ);
+
+        c_Buffer.Add(v_Recorded.data(), 512);
+        c_Stream.Feed(c_Buffer);
+    }
+
+    /**
+     *  Error
+     */
+
+    // Failed calls are reported by finishing the stream
+    c_Server.SetStatus(grpc::Status(grpc::StatusCode::UNAVAILABLE, "Fake failure"));
+
+    {
+        ::GoogleCloudSTTStream c_Stream(p_Speech,
+                                        TEST_GOOGLE_CLOUD_STT_LANGUAGE_CODE,
+                                        1,
+                                        false,
+                                        TEST_GOOGLE_CLOUD_STT_KHZ);
+
+        c_Buffer.Add(v_Recorded.data(), 512);
+        c_Stream.Feed(c_Buffer);
+
+        bool b_Thrown = false;
+
+        try
+        {
+            c_Stream.Finish(c_Result);
+        }
+        catch (Exception& e)
+        {
+            b_Thrown = true;
+        }
+
+        MRH_TEST_ASSERT(b_Thrown == true);
+    }
+}
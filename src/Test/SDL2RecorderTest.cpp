@@ -0,0 +1,115 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+#include <unistd.h>
+#include <algorithm>
+
+// External
+
+// Project
+#include "./Test.h"
+#include "./SpeechFixture.h"
+#include "../Audio/API/SDL2/SDL2Recorder.h"
+
+// Namespace
+namespace
+{
+    std::vector<MRH_Sint16> Record(std::vector<MRH_Sint16> const& v_Input, MRH_Uint32 u32_PreRollSize)
+    {
+        std::shared_ptr<EventQueue> p_EventQueue = std::make_shared<EventQueue>(std::vector<int>(), 1);
+        std::shared_ptr<SpeechChecker> p_SpeechChecker = std::make_shared<SpeechFixture::ThresholdChecker>();
+        std::shared_ptr<Latency::Marks> p_Marks = std::make_shared<Latency::Marks>();
+        std::shared_ptr<RecorderContext> p_Context = std::make_shared<RecorderContext>(p_EventQueue, 0, p_SpeechChecker, p_Marks);
+
+        // @NOTE: No device is opened, the callback is driven with the fixture
+        //        frames as SDL2 would with recorded frames
+        SDL2RecordingContext c_Context(TEST_SPEECH_FIXTURE_KHZ,
+                                       2 * TEST_SPEECH_FIXTURE_FRAME,
+                                       u32_PreRollSize,
+                                       1.f,
+                                       p_Context);
+
+        for (size_t us_Pos = 0; us_Pos < v_Input.size(); us_Pos += TEST_SPEECH_FIXTURE_FRAME)
+        {
+            size_t us_Length = std::min(v_Input.size() - us_Pos, static_cast<size_t>(TEST_SPEECH_FIXTURE_FRAME));
+            std::vector<MRH_Sint16> v_Stream(v_Input.begin() + us_Pos, v_Input.begin() + us_Pos + us_Length);
+
+            SDL2Recorder::Callback(&c_Context,
+                                   reinterpret_cast<Uint8*>(v_Stream.data()),
+                                   static_cast<int>(v_Stream.size() * sizeof(MRH_Sint16)));
+        }
+
+        MRH_TEST_ASSERT(p_Context->b_SpeechRecorded == true);
+        MRH_TEST_ASSERT(c_Context.us_DroppedSamples == 0);
+
+        AudioBuffer c_Buffer(TEST_SPEECH_FIXTURE_KHZ);
+        c_Context.c_Queue.Pop(c_Buffer);
+
+        std::vector<MRH_Sint16> v_Recorded(c_Buffer.GetSampleCount());
+        c_Buffer.RetrieveBytes(reinterpret_cast<char*>(v_Recorded.data()), v_Recorded.size());
+
+        return v_Recorded;
+    }
+}
+
+
+//*************************************************************************************
+// SDL2Recorder
+//*************************************************************************************
+
+void Test::SDL2Recorder()
+{
+    std::vector<MRH_Sint16> v_Fixture = SpeechFixture::Create();
+    std::string s_FilePath = SpeechFixture::Write(v_Fixture);
+    std::vector<MRH_Sint16> v_Input;
+
+    try
+    {
+        v_Input = SpeechFixture::Read(s_FilePath);
+    }
+    catch (...)
+    {
+        unlink(s_FilePath.c_str());
+        throw;
+    }
+
+    unlink(s_FilePath.c_str());
+
+    MRH_TEST_ASSERT(v_Input == v_Fixture);
+
+    /**
+     *  Pre-Roll
+     */
+
+    std::vector<MRH_Sint16> v_Recorded = Record(v_Input, TEST_SPEECH_FIXTURE_PRE_ROLL);
+    size_t us_Start = SpeechFixture::GetStart(v_Recorded, v_Fixture);
+
+    // The quiet onset is kept, at most the pre-roll precedes it
+    MRH_TEST_ASSERT(us_Start <= SpeechFixture::us_Onset);
+    MRH_TEST_ASSERT(SpeechFixture::us_Onset - us_Start <= TEST_SPEECH_FIXTURE_PRE_ROLL);
+    MRH_TEST_ASSERT(us_Start + v_Recorded.size() >= SpeechFixture::us_Silence);
+
+    /**
+     *  No Pre-Roll
+     */
+
+    v_Recorded = Record(v_Input, 0);
+    us_Start = SpeechFixture::GetStart(v_Recorded, v_Fixture);
+
+    MRH_TEST_ASSERT(us_Start > SpeechFixture::us_Onset);
+    MRH_TEST_ASSERT(us_Start <= SpeechFixture::us_Loud);
+}
@@ -0,0 +1,143 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+#include <vector>
+
+// External
+
+// Project
+#include "./Test.h"
+#include "../STT/STT.h"
+
+// Pre-defined
+#define TEST_STT_AUDIO_KHZ 16000
+
+// Namespace
+namespace
+{
+    class CaptureSTT : public STT
+    {
+    public:
+
+        CaptureSTT() noexcept : STT("Capture"),
+                                b_Copied(false)
+        {}
+
+        void Transcribe(AudioBuffer& c_Buffer, STTResult& c_Result) override
+        {
+            // Contiguous samples, as transcribed by Picovoice Leopard
+            size_t us_Samples;
+            const MRH_Sint16* p_Samples = PrepareAudio(c_Buffer, us_Samples);
+
+            s_Prepared.assign(reinterpret_cast<const char*>(p_Samples), us_Samples * sizeof(MRH_Sint16));
+            b_Copied = (v_Audio.empty() == false && p_Samples == v_Audio.data());
+
+            // Request bytes, as sent by Google Cloud STT
+            size_t us_Count = c_Buffer.GetSampleCount();
+
+            s_Request.assign(us_Count * sizeof(MRH_Sint16), '\0');
+            c_Buffer.RetrieveBytes(&(s_Request[0]), us_Count);
+
+            c_Result.Clear();
+        }
+
+        std::string s_Prepared;
+        std::string s_Request;
+        bool b_Copied;
+    };
+
+    void Record(std::vector<MRH_Sint16>& v_Recorded, AudioBuffer& c_Buffer, size_t us_Samples)
+    {
+        std::vector<MRH_Sint16> v_Chunk(us_Samples);
+
+        for (size_t i = 0; i < us_Samples; ++i)
+        {
+            v_Chunk[i] = static_cast<MRH_Sint16>((v_Recorded.size() + i) * 31 - 16000);
+        }
+
+        v_Recorded.insert(v_Recorded.end(), v_Chunk.begin(), v_Chunk.end());
+        c_Buffer.Add(v_Chunk.data(), v_Chunk.size());
+    }
+
+    std::string GetBytes(std::vector<MRH_Sint16> const& v_Recorded) noexcept
+    {
+        return std::string(reinterpret_cast<const char*>(v_Recorded.data()), v_Recorded.size() * sizeof(MRH_Sint16));
+    }
+}
+
+
+//*************************************************************************************
+// STTAudio
+//*************************************************************************************
+
+void Test::STTAudio()
+{
+    CaptureSTT c_STT;
+    STTResult c_Result;
+
+    /**
+     *  Stream
+     */
+
+    // Chunks are fed while recording, the collected audio is contiguous
+    const size_t p_Chunk[] = { 1, 160, 4096, 333, 20000 };
+    std::vector<MRH_Sint16> v_Recorded;
+    AudioBuffer c_Buffer(TEST_STT_AUDIO_KHZ);
+    std::shared_ptr<STTStream> p_Stream = c_STT.BeginStream(TEST_STT_AUDIO_KHZ);
+
+    for (auto& Chunk : p_Chunk)
+    {
+        Record(v_Recorded, c_Buffer, Chunk);
+        p_Stream->Feed(c_Buffer);
+    }
+
+    p_Stream->Finish(c_Result);
+
+    MRH_TEST_ASSERT(c_STT.b_Copied == false);
+    MRH_TEST_ASSERT(c_STT.s_Prepared == GetBytes(v_Recorded));
+    MRH_TEST_ASSERT(c_STT.s_Request == GetBytes(v_Recorded));
+
+    /**
+     *  Wrapped
+     */
+
+    // Consumed samples leave the stored samples wrapped around the ring end
+    AudioBuffer c_Wrapped(TEST_STT_AUDIO_KHZ, 1024);
+    std::vector<MRH_Sint16> v_Consumed(700);
+
+    v_Recorded.clear();
+    Record(v_Recorded, c_Wrapped, 800);
+
+    MRH_TEST_ASSERT(c_Wrapped.Retrieve(v_Consumed.data(), v_Consumed.size()) == v_Consumed.size());
+    v_Recorded.erase(v_Recorded.begin(), v_Recorded.begin() + v_Consumed.size());
+
+    Record(v_Recorded, c_Wrapped, 500);
+    Record(v_Recorded, c_Wrapped, 123);
+
+    AudioBuffer::ConstRegion c_First;
+    AudioBuffer::ConstRegion c_Second;
+
+    MRH_TEST_ASSERT(c_Wrapped.GetReadRegions(c_First, c_Second) == v_Recorded.size());
+    MRH_TEST_ASSERT(c_Second.us_Samples > 0);
+
+    c_STT.Transcribe(c_Wrapped, c_Result);
+
+    MRH_TEST_ASSERT(c_STT.b_Copied == true);
+    MRH_TEST_ASSERT(c_STT.s_Prepared == GetBytes(v_Recorded));
+    MRH_TEST_ASSERT(c_STT.s_Request == GetBytes(v_Recorded));
+    MRH_TEST_ASSERT(c_Wrapped.GetSampleCount() == 0);
+}
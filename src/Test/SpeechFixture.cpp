@@ -0,0 +1,147 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstdlib>
+#include <algorithm>
+
+// External
+
+// Project
+#include "./SpeechFixture.h"
+#include "./Test.h"
+#include "../Audio/API/File/FileDevice.h"
+
+
+//*************************************************************************************
+// Types
+//*************************************************************************************
+
+bool SpeechFixture::ThresholdChecker::IsSpeech(const MRH_Sint16* p_Samples, size_t us_Samples)
+{
+    for (size_t i = 0; i < us_Samples; ++i)
+    {
+        if (p_Samples[i] >= TEST_SPEECH_FIXTURE_THRESHOLD || p_Samples[i] <= -TEST_SPEECH_FIXTURE_THRESHOLD)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//*************************************************************************************
+// Fixture
+//*************************************************************************************
+
+std::vector<MRH_Sint16> SpeechFixture::Create() noexcept
+{
+    std::vector<MRH_Sint16> v_Fixture(us_End, 0);
+
+    for (size_t i = us_Onset; i < us_Loud; ++i)
+    {
+        v_Fixture[i] = static_cast<MRH_Sint16>(100 + (i % 50));
+    }
+
+    for (size_t i = us_Loud; i < us_Silence; ++i)
+    {
+        v_Fixture[i] = static_cast<MRH_Sint16>((i % 2 == 0 ? 8000 : -8000) + (i % 100));
+    }
+
+    return v_Fixture;
+}
+
+std::string SpeechFixture::Write(std::vector<MRH_Sint16> const& v_Samples)
+{
+    char p_FilePath[] = "/tmp/mrhspeechd-tests-XXXXXX.wav";
+    int i_FD = mkstemps(p_FilePath, std::strlen(MRH_FILE_WAV_EXTENSION));
+
+    if (i_FD < 0)
+    {
+        throw Exception("Failed to create WAV fixture: " + std::string(std::strerror(errno)));
+    }
+
+    size_t us_Size = v_Samples.size() * sizeof(MRH_Sint16);
+
+    try
+    {
+        FileDevice::WriteWAVHeader(i_FD, TEST_SPEECH_FIXTURE_KHZ, static_cast<MRH_Uint32>(us_Size));
+        MRH_TEST_ASSERT(FileDevice::Write(i_FD, v_Samples.data(), us_Size) == us_Size);
+    }
+    catch (...)
+    {
+        close(i_FD);
+        unlink(p_FilePath);
+        throw;
+    }
+
+    close(i_FD);
+
+    return p_FilePath;
+}
+
+std::vector<MRH_Sint16> SpeechFixture::Read(std::string const& s_FilePath)
+{
+    int i_FD = open(s_FilePath.c_str(), O_RDONLY | O_CLOEXEC);
+
+    if (i_FD < 0)
+    {
+        throw Exception("Failed to open WAV fixture: " + std::string(std::strerror(errno)));
+    }
+
+    std::vector<MRH_Sint16> v_Samples;
+
+    try
+    {
+        MRH_Uint32 u32_KHz = 0;
+        MRH_Uint32 u32_Size = FileDevice::ReadWAVHeader(i_FD, u32_KHz);
+
+        MRH_TEST_ASSERT(u32_KHz == TEST_SPEECH_FIXTURE_KHZ);
+
+        v_Samples.resize(u32_Size / sizeof(MRH_Sint16));
+        MRH_TEST_ASSERT(FileDevice::Read(i_FD, v_Samples.data(), u32_Size) == u32_Size);
+    }
+    catch (...)
+    {
+        close(i_FD);
+        throw;
+    }
+
+    close(i_FD);
+
+    return v_Samples;
+}
+
+//*************************************************************************************
+// Check
+//*************************************************************************************
+
+size_t SpeechFixture::GetStart(std::vector<MRH_Sint16> const& v_Recorded, std::vector<MRH_Sint16> const& v_Fixture)
+{
+    MRH_TEST_ASSERT(v_Recorded.empty() == false && v_Recorded.size() <= v_Fixture.size());
+
+    for (size_t us_Start = 0; us_Start <= v_Fixture.size() - v_Recorded.size(); ++us_Start)
+    {
+        if (std::equal(v_Recorded.begin(), v_Recorded.end(), v_Fixture.begin() + us_Start) == true)
+        {
+            return us_Start;
+        }
+    }
+
+    throw Exception("Recorded audio is not a slice of the fixture!");
+}
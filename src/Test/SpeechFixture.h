@@ -0,0 +1,118 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef SpeechFixture_h
+#define SpeechFixture_h
+
+// C / C++
+#include <string>
+#include <vector>
+
+// External
+#include <MRH_Typedefs.h>
+
+// Project
+#include "../Audio/SpeechChecker.h"
+
+// Pre-defined
+#define TEST_SPEECH_FIXTURE_KHZ 16000
+#define TEST_SPEECH_FIXTURE_FRAME 1024 // Samples per recorder frame
+#define TEST_SPEECH_FIXTURE_PRE_ROLL 4096
+#define TEST_SPEECH_FIXTURE_THRESHOLD 4000
+
+
+namespace SpeechFixture
+{
+    //*************************************************************************************
+    // Layout
+    //*************************************************************************************
+
+    // @NOTE: Speech starts quietly, the first frames of the utterance are
+    //        below the detection threshold
+    const size_t us_Onset = 10000;
+    const size_t us_Loud = 13000;
+    const size_t us_Silence = 17000;
+    const size_t us_End = 23000;
+
+    //*************************************************************************************
+    // Types
+    //*************************************************************************************
+
+    /**
+     *  Speech checker accepting chunks with a sample above the fixture threshold.
+     */
+
+    class ThresholdChecker : public SpeechChecker
+    {
+    public:
+
+        ThresholdChecker() noexcept : SpeechChecker("Threshold")
+        {}
+
+        bool IsSpeech(const MRH_Sint16* p_Samples, size_t us_Samples) override;
+    };
+
+    //*************************************************************************************
+    // Fixture
+    //*************************************************************************************
+
+    /**
+     *  Create the fixture samples. Silence, a quiet onset, loud speech and 
+     *  trailing silence.
+     *
+     *  \return The fixture samples.
+     */
+
+    std::vector<MRH_Sint16> Create() noexcept;
+
+    /**
+     *  Write samples to a new temporary WAV file.
+     *
+     *  \param v_Samples The samples to write.
+     *
+     *  \return The WAV file path. The caller removes the file.
+     */
+
+    std::string Write(std::vector<MRH_Sint16> const& v_Samples);
+
+    /**
+     *  Read the samples of a WAV file.
+     *
+     *  \param s_FilePath The WAV file path.
+     *
+     *  \return The file samples.
+     */
+
+    std::vector<MRH_Sint16> Read(std::string const& s_FilePath);
+
+    //*************************************************************************************
+    // Check
+    //*************************************************************************************
+
+    /**
+     *  Get the fixture position a recording starts at. The recording has to be
+     *  a single slice of the fixture.
+     *
+     *  \param v_Recorded The recorded samples.
+     *  \param v_Fixture The fixture samples.
+     *
+     *  \return The fixture sample the recording starts with.
+     */
+
+    size_t GetStart(std::vector<MRH_Sint16> const& v_Recorded, std::vector<MRH_Sint16> const& v_Fixture);
+};
+
+#endif /* SpeechFixture_h */
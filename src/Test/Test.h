@@ -0,0 +1,115 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef Test_h
+#define Test_h
+
+// C / C++
+#include <string>
+
+// External
+
+// Project
+#include "../Exception.h"
+
+// Pre-defined
+#define MRH_TEST_ASSERT(CONDITION) Test::Assert((CONDITION), #CONDITION, __FILE__, __LINE__)
+
+
+namespace Test
+{
+    //*************************************************************************************
+    // Tests
+    //*************************************************************************************
+
+    /**
+     *  Compare the vectorized audio feature processing with the scalar reference
+     *  for random and edge case samples at all lengths around the vector sizes.
+     */
+
+    void AudioFeatures();
+
+    /**
+     *  Check that the audio prepared for transcription and the request bytes
+     *  match the recorded chunks exactly, for streamed and wrapped buffers.
+     */
+
+    void STTAudio();
+
+    /**
+     *  Fill the audio stream socket and check that start flags and end markers 
+     *  of utterances are kept until sent.
+     */
+
+    void AudioStream();
+
+#if MRH_SPEECHD_SOUND_IO_API_FILE > 0
+    /**
+     *  Record a generated WAV fixture with a quiet speech onset through the 
+     *  file recorder and check that the onset is kept by the pre-roll.
+     */
+
+    void FileRecorder();
+#endif
+
+#if MRH_SPEECHD_SOUND_IO_API_SDL2 > 0
+    /**
+     *  Drive the SDL2 recording callback with a generated WAV fixture with a 
+     *  quiet speech onset and check that the onset is kept by the pre-roll.
+     */
+
+    void SDL2Recorder();
+#endif
+
+#if MRH_SPEECHD_STT_API_GGOGLE_CLOUD > 0
+    /**
+     *  Stream recorded chunks to a local fake speech server and check the 
+     *  received requests and the transcription result.
+     */
+
+    void GoogleCloudSTTStream();
+
+    /**
+     *  Send concurrent requests of multiple stubs over the shared endpoint 
+     *  channel to a local stand-in server and count the connections used.
+     */
+
+    void GoogleCloudChannel();
+#endif
+
+    //*************************************************************************************
+    // Assert
+    //*************************************************************************************
+
+    /**
+     *  Check a test condition.
+     *
+     *  \param b_Condition The condition result.
+     *  \param p_Condition The condition source text.
+     *  \param p_File The source file of the check.
+     *  \param i_Line The source file line of the check.
+     */
+
+    inline void Assert(bool b_Condition, const char* p_Condition, const char* p_File, int i_Line)
+    {
+        if (b_Condition == false)
+        {
+            throw Exception(std::string(p_File) + ":" + std::to_string(i_Line) + ": " + p_Condition);
+        }
+    }
+};
+
+#endif /* Test_h */
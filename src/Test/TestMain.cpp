@@ -0,0 +1,102 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+
+// External
+
+// Project
+#include "./Test.h"
+#include "../Revision.h"
+
+// Namespace
+namespace
+{
+    struct Case
+    {
+        const char* p_Name;
+        void (*Run)();
+    };
+
+    const Case p_Case[] =
+    {
+        { "AudioFeatures", Test::AudioFeatures },
+        { "STTAudio", Test::STTAudio },
+        { "AudioStream", Test::AudioStream },
+#if MRH_SPEECHD_SOUND_IO_API_FILE > 0
+        { "FileRecorder", Test::FileRecorder },
+#endif
+#if MRH_SPEECHD_SOUND_IO_API_SDL2 > 0
+        { "SDL2Recorder", Test::SDL2Recorder },
+#endif
+#if MRH_SPEECHD_STT_API_GGOGLE_CLOUD > 0
+        { "GoogleCloudSTTStream", Test::GoogleCloudSTTStream },
+        { "GoogleCloudChannel", Test::GoogleCloudChannel },
+#endif
+    };
+}
+
+
+//*************************************************************************************
+// Main
+//*************************************************************************************
+
+int main(int argc, const char* argv[])
+{
+    std::printf("MRH Speech Tests (%s)\n\n", VERSION_NUMBER);
+
+    size_t us_Failed = 0;
+    size_t us_Run = 0;
+
+    // @NOTE: All tests run if none are given
+    for (auto& Case : p_Case)
+    {
+        bool b_Run = (argc < 2);
+
+        for (int i = 1; i < argc && b_Run == false; ++i)
+        {
+            b_Run = (std::strcmp(argv[i], Case.p_Name) == 0);
+        }
+
+        if (b_Run == false)
+        {
+            continue;
+        }
+
+        ++us_Run;
+
+        try
+        {
+            Case.Run();
+            std::printf("PASSED\t%s\n", Case.p_Name);
+        }
+        catch (std::exception& e)
+        {
+            std::printf("FAILED\t%s\t%s\n", Case.p_Name, e.what());
+            ++us_Failed;
+        }
+
+        std::fflush(stdout);
+    }
+
+    std::printf("\n%zu of %zu tests passed\n", us_Run - us_Failed, us_Run);
+
+    return us_Run > 0 && us_Failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
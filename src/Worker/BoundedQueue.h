@@ -0,0 +1,168 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef BoundedQueue_h
+#define BoundedQueue_h
+
+// C / C++
+#include <deque>
+#include <mutex>
+
+// External
+
+// Project
+
+
+template<typename T> class BoundedQueue
+{
+public:
+
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+
+    /**
+     *  Default constructor.
+     *
+     *  \param us_Capacity The maximum amount of elements.
+     */
+
+    BoundedQueue(size_t us_Capacity) noexcept : us_Capacity(us_Capacity > 0 ? us_Capacity : 1)
+    {}
+
+    /**
+     *  Default destructor.
+     */
+
+    ~BoundedQueue() noexcept
+    {}
+
+    //*************************************************************************************
+    // Push
+    //*************************************************************************************
+
+    /**
+     *  Add an element if space is available.
+     *
+     *  \param c_Element The element to add. The element is moved on success.
+     *
+     *  \return true if added, false if full.
+     */
+
+    bool TryPush(T& c_Element)
+    {
+        std::lock_guard<std::mutex> c_Guard(c_Mutex);
+
+        if (dq_Element.size() >= us_Capacity)
+        {
+            return false;
+        }
+
+        dq_Element.emplace_back(std::move(c_Element));
+        return true;
+    }
+
+    //*************************************************************************************
+    // Pop
+    //*************************************************************************************
+
+    /**
+     *  Remove the oldest element if available.
+     *
+     *  \param c_Element The removed element.
+     *  \param b_Full If the queue was full before removing.
+     *
+     *  \return true if removed, false if empty.
+     */
+
+    bool TryPop(T& c_Element, bool& b_Full)
+    {
+        std::lock_guard<std::mutex> c_Guard(c_Mutex);
+
+        if (dq_Element.empty() == true)
+        {
+            return false;
+        }
+
+        b_Full = dq_Element.size() >= us_Capacity;
+
+        c_Element = std::move(dq_Element.front());
+        dq_Element.pop_front();
+
+        return true;
+    }
+
+    //*************************************************************************************
+    // Clear
+    //*************************************************************************************
+
+    /**
+     *  Remove all elements.
+     */
+
+    void Clear() noexcept
+    {
+        std::lock_guard<std::mutex> c_Guard(c_Mutex);
+
+        dq_Element.clear();
+    }
+
+    //*************************************************************************************
+    // Getters
+    //*************************************************************************************
+
+    /**
+     *  Get the amount of elements which can be added.
+     *
+     *  \return The free element count.
+     */
+
+    size_t GetFree() noexcept
+    {
+        std::lock_guard<std::mutex> c_Guard(c_Mutex);
+
+        return us_Capacity - dq_Element.size();
+    }
+
+    /**
+     *  Check if no elements are queued.
+     *
+     *  \return true if empty, false if not.
+     */
+
+    bool GetEmpty() noexcept
+    {
+        std::lock_guard<std::mutex> c_Guard(c_Mutex);
+
+        return dq_Element.empty();
+    }
+
+private:
+
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+
+    std::mutex c_Mutex;
+
+    std::deque<T> dq_Element;
+    size_t us_Capacity;
+
+protected:
+
+};
+
+#endif /* BoundedQueue_h */
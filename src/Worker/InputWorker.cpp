@@ -0,0 +1,230 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+
+// External
+
+// Project
+#include "./InputWorker.h"
+#include "../Latency.h"
+
+
+//*************************************************************************************
+// Constructor / Destructor
+//*************************************************************************************
+
+InputWorker::InputWorker(std::shared_ptr<WorkerPool>& p_WorkerPool,
+                         std::shared_ptr<STT>& p_STT,
+                         std::shared_ptr<UTF8Stream>& p_Stream,
+                         std::shared_ptr<EventQueue>& p_EventQueue,
+                         size_t us_Channel) : p_WorkerPool(p_WorkerPool),
+                                              u32_Generation(0),
+                                              c_Queue(MRH_SPEECHD_INPUT_WORKER_QUEUE_SIZE),
+                                              p_STT(p_STT),
+                                              p_Stream(p_Stream),
+                                              p_EventQueue(p_EventQueue),
+                                              us_Channel(us_Channel),
+                                              u32_StreamGeneration(0),
+                                              b_Failed(false)
+{
+    if (this->p_WorkerPool.expired() == true || this->p_STT == NULL || this->p_Stream == NULL || this->p_EventQueue == NULL)
+    {
+        throw Exception("Invalid input worker components!");
+    }
+}
+
+InputWorker::~InputWorker() noexcept
+{}
+
+//*************************************************************************************
+// Queue
+//*************************************************************************************
+
+bool InputWorker::Feed(AudioBuffer& c_Buffer) noexcept
+{
+    Job c_Job;
+    c_Job.e_Type = JOB_FEED;
+    c_Job.u32_Generation = u32_Generation;
+    c_Job.c_Buffer.Reset(c_Buffer);
+
+    if (c_Queue.TryPush(c_Job) == false)
+    {
+        // Hand the audio back
+        c_Buffer.Reset(c_Job.c_Buffer);
+        return false;
+    }
+
+    Schedule();
+    return true;
+}
+
+bool InputWorker::Finish(MRH_Uint64 u64_SpeechEnd) noexcept
+{
+    Job c_Job;
+    c_Job.e_Type = JOB_FINISH;
+    c_Job.u32_Generation = u32_Generation;
+    c_Job.u64_Time = u64_SpeechEnd;
+
+    if (c_Queue.TryPush(c_Job) == false)
+    {
+        return false;
+    }
+
+    Schedule();
+    return true;
+}
+
+void InputWorker::Cancel() noexcept
+{
+    // Queued jobs and the running stream belong to the old generation
+    u32_Generation += 1;
+    c_Queue.Clear();
+}
+
+//*************************************************************************************
+// Schedule
+//*************************************************************************************
+
+void InputWorker::Schedule() noexcept
+{
+    std::shared_ptr<WorkerPool> p_Pool = p_WorkerPool.lock();
+
+    if (p_Pool != NULL)
+    {
+        p_Pool->Schedule(shared_from_this());
+    }
+}
+
+//*************************************************************************************
+// Run
+//*************************************************************************************
+
+bool InputWorker::Run() noexcept
+{
+    bool b_Full;
+    Job c_Job;
+
+    if (c_Queue.TryPop(c_Job, b_Full) == false)
+    {
+        return false;
+    }
+
+    // Main thread waits for free space to feed more audio
+    if (b_Full == true)
+    {
+        p_EventQueue->Notify(EventQueue::EVENT_RECORDING, us_Channel);
+    }
+
+    Handle(c_Job);
+
+    return c_Queue.GetEmpty() == false;
+}
+
+void InputWorker::Handle(Job& c_Job) noexcept
+{
+    Latency& c_Latency = Latency::Singleton();
+
+    // Cancelled while queued?
+    if (c_Job.u32_Generation != u32_Generation)
+    {
+        return;
+    }
+
+    if (c_Job.u32_Generation != u32_StreamGeneration)
+    {
+        p_STTStream.reset();
+        u32_StreamGeneration = c_Job.u32_Generation;
+        b_Failed = false;
+    }
+
+    // Skip the rest of a failed stream until it is finished
+    if (b_Failed == true)
+    {
+        if (c_Job.e_Type == JOB_FINISH)
+        {
+            b_Failed = false;
+        }
+
+        return;
+    }
+
+    try
+    {
+        if (c_Job.e_Type == JOB_FEED)
+        {
+            if (p_STTStream == NULL)
+            {
+                MRH_LOG_INFO("Starting input transcription stream.");
+
+                p_STTStream = p_STT->BeginStream(c_Job.c_Buffer.GetKHz());
+            }
+
+            MRH_Uint64 u64_Feed = Latency::GetTime();
+
+            p_STTStream->Feed(c_Job.c_Buffer);
+
+            c_Latency.Add(Latency::STAGE_FEED_AUDIO, u64_Feed, Latency::GetTime());
+        }
+        else if (p_STTStream != NULL)
+        {
+            MRH_LOG_INFO("Finishing and creating input message.");
+
+            std::shared_ptr<STTStream> p_Finished;
+
+            MRH_Uint64 u64_Finish = Latency::GetTime();
+
+            p_Finished.swap(p_STTStream);
+            p_Finished->Finish(c_Result);
+
+            MRH_Uint64 u64_Write = Latency::GetTime();
+
+            // @NOTE: Cancelled transcriptions are never written
+            if (c_Job.u32_Generation != u32_Generation)
+            {
+                return;
+            }
+
+            MRH_LOG_INFO("Transcribed {} segments with confidence {}.",
+                         c_Result.v_Segment.size(),
+                         c_Result.f32_Confidence);
+
+            p_Stream->Write(c_Result.s_Transcript);
+
+            MRH_Uint64 u64_Written = Latency::GetTime();
+
+            c_Latency.Add(Latency::STAGE_STT_FINISH, u64_Finish, u64_Write);
+            c_Latency.Add(Latency::STAGE_STREAM_WRITE, u64_Write, u64_Written);
+            c_Latency.Add(Latency::STAGE_SPEECH_END_WRITTEN, c_Job.u64_Time, u64_Written);
+        }
+    }
+    catch (Exception& e)
+    {
+        MRH_LOG_ERROR("Failed to handle input: {}", e.what2());
+
+        p_STTStream.reset();
+        b_Failed = (c_Job.e_Type == JOB_FEED);
+    }
+}
+
+//*************************************************************************************
+// Getters
+//*************************************************************************************
+
+size_t InputWorker::GetFree() noexcept
+{
+    return c_Queue.GetFree();
+}
@@ -0,0 +1,231 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef InputWorker_h
+#define InputWorker_h
+
+// C / C++
+#include <atomic>
+#include <memory>
+
+// External
+#include <MRH_Typedefs.h>
+
+// Project
+#include "./BoundedQueue.h"
+#include "./WorkerPool.h"
+#include "../STT/STT.h"
+#include "../Stream/UTF8Stream.h"
+#include "../EventQueue.h"
+
+// Pre-defined
+#ifndef MRH_SPEECHD_INPUT_WORKER_QUEUE_SIZE
+    #define MRH_SPEECHD_INPUT_WORKER_QUEUE_SIZE 64 // ~8 seconds of 2048 sample frames
+#endif
+
+
+class InputWorker : public WorkerPool::Task
+{
+public:
+
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+
+    /**
+     *  Default constructor.
+     *
+     *  \param p_WorkerPool The worker pool to transcribe with.
+     *  \param p_STT The STT API to transcribe with.
+     *  \param p_Stream The stream to write transcribed strings to.
+     *  \param p_EventQueue The event queue to notify of free queue space.
+     *  \param us_Channel The event queue channel to notify.
+     */
+
+    InputWorker(std::shared_ptr<WorkerPool>& p_WorkerPool,
+                std::shared_ptr<STT>& p_STT,
+                std::shared_ptr<UTF8Stream>& p_Stream,
+                std::shared_ptr<EventQueue>& p_EventQueue,
+                size_t us_Channel);
+
+    /**
+     *  Default destructor.
+     */
+
+    ~InputWorker() noexcept;
+
+    //*************************************************************************************
+    // Queue
+    //*************************************************************************************
+
+    /**
+     *  Queue recorded audio for transcription. A transcription stream is
+     *  started with the first audio fed. This function does not block.
+     *
+     *  \param c_Buffer The audio to feed. The buffer is consumed on success.
+     *
+     *  \return true if queued, false if the queue is full.
+     */
+
+    bool Feed(AudioBuffer& c_Buffer) noexcept;
+
+    /**
+     *  Queue the end of the current transcription stream. The transcribed
+     *  string is written to the stream. This function does not block.
+     *
+     *  \param u64_SpeechEnd The latency time at which speech ended.
+     *
+     *  \return true if queued, false if the queue is full.
+     */
+
+    bool Finish(MRH_Uint64 u64_SpeechEnd) noexcept;
+
+    /**
+     *  Discard all queued audio and the current transcription stream.
+     */
+
+    void Cancel() noexcept;
+
+    //*************************************************************************************
+    // Getters
+    //*************************************************************************************
+
+    /**
+     *  Get the amount of jobs which can be queued without blocking.
+     *
+     *  \return The free job count.
+     */
+
+    size_t GetFree() noexcept;
+
+private:
+
+    //*************************************************************************************
+    // Types
+    //*************************************************************************************
+
+    typedef enum
+    {
+        JOB_FEED = 0,
+        JOB_FINISH = 1,
+
+        JOB_MAX = JOB_FINISH,
+
+        JOB_COUNT = JOB_MAX + 1
+
+    }JobType;
+
+    struct Job
+    {
+        /**
+         *  Default constructor.
+         */
+
+        Job() noexcept : e_Type(JOB_FEED),
+                         u32_Generation(0),
+                         u64_Time(0),
+                         c_Buffer(0)
+        {}
+
+        /**
+         *  Move constructor. The audio storage is swapped instead of copied.
+         */
+
+        Job(Job&& c_Job) noexcept : e_Type(c_Job.e_Type),
+                                    u32_Generation(c_Job.u32_Generation),
+                                    u64_Time(c_Job.u64_Time),
+                                    c_Buffer(0)
+        {
+            c_Buffer.Reset(c_Job.c_Buffer);
+        }
+
+        /**
+         *  Move assignment. The audio storage is swapped instead of copied.
+         */
+
+        Job& operator=(Job&& c_Job) noexcept
+        {
+            e_Type = c_Job.e_Type;
+            u32_Generation = c_Job.u32_Generation;
+            u64_Time = c_Job.u64_Time;
+            c_Buffer.Reset(c_Job.c_Buffer);
+
+            return *this;
+        }
+
+        JobType e_Type;
+        MRH_Uint32 u32_Generation;
+        MRH_Uint64 u64_Time;
+        AudioBuffer c_Buffer;
+    };
+
+    //*************************************************************************************
+    // Schedule
+    //*************************************************************************************
+
+    /**
+     *  Schedule the worker with the worker pool. Nothing is scheduled once 
+     *  the pool was destroyed.
+     */
+
+    void Schedule() noexcept;
+
+    //*************************************************************************************
+    // Run
+    //*************************************************************************************
+
+    /**
+     *  Transcribe a single queued job.
+     *
+     *  \return true if more jobs are queued, false if not.
+     */
+
+    bool Run() noexcept override;
+
+    /**
+     *  Handle a queued job.
+     *
+     *  \param c_Job The job to handle.
+     */
+
+    void Handle(Job& c_Job) noexcept;
+
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+
+    // @NOTE: Not owned, scheduled tasks are held by the pool
+    std::weak_ptr<WorkerPool> p_WorkerPool;
+    std::atomic<MRH_Uint32> u32_Generation;
+
+    BoundedQueue<Job> c_Queue;
+
+    std::shared_ptr<STT> p_STT;
+    std::shared_ptr<UTF8Stream> p_Stream;
+    std::shared_ptr<EventQueue> p_EventQueue;
+    size_t us_Channel;
+
+    // @NOTE: Only used by the running task
+    std::shared_ptr<STTStream> p_STTStream;
+    MRH_Uint32 u32_StreamGeneration;
+    bool b_Failed;
+    STTResult c_Result; // Allocations kept between transcriptions
+
+protected:
+
+};
+
+#endif /* InputWorker_h */
@@ -0,0 +1,219 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+
+// External
+
+// Project
+#include "./OutputWorker.h"
+#include "../Latency.h"
+
+
+//*************************************************************************************
+// Constructor / Destructor
+//*************************************************************************************
+
+OutputWorker::OutputWorker(std::shared_ptr<WorkerPool>& p_WorkerPool,
+                           std::shared_ptr<TTS>& p_TTS,
+                           std::shared_ptr<EventQueue>& p_EventQueue,
+                           size_t us_Channel) : p_WorkerPool(p_WorkerPool),
+                                                u32_Generation(0),
+                                                c_Message(MRH_SPEECHD_OUTPUT_WORKER_QUEUE_SIZE),
+                                                c_Audio(MRH_SPEECHD_OUTPUT_WORKER_AUDIO_SIZE),
+                                                p_TTS(p_TTS),
+                                                p_EventQueue(p_EventQueue),
+                                                us_Channel(us_Channel),
+                                                us_Sentence(0)
+{
+    if (this->p_WorkerPool.expired() == true || this->p_TTS == NULL || this->p_EventQueue == NULL)
+    {
+        throw Exception("Invalid output worker components!");
+    }
+}
+
+OutputWorker::~OutputWorker() noexcept
+{}
+
+//*************************************************************************************
+// Queue
+//*************************************************************************************
+
+bool OutputWorker::Add(std::string& s_Message, MRH_Uint64 u64_Read) noexcept
+{
+    Message c_Job;
+    c_Job.s_Message.swap(s_Message);
+    c_Job.u32_Generation = u32_Generation;
+    c_Job.u64_Read = u64_Read;
+
+    if (c_Message.TryPush(c_Job) == false)
+    {
+        s_Message.swap(c_Job.s_Message);
+        return false;
+    }
+
+    Schedule();
+    return true;
+}
+
+bool OutputWorker::GetAudio(AudioBuffer& c_Buffer, bool& b_First, MRH_Uint64& u64_Read) noexcept
+{
+    Audio c_Entry;
+    bool b_Full;
+
+    while (c_Audio.TryPop(c_Entry, b_Full) == true)
+    {
+        // Synthesis waits for playback to catch up
+        if (b_Full == true)
+        {
+            Schedule();
+        }
+
+        // Synthesized before the last cancel?
+        if (c_Entry.u32_Generation != u32_Generation)
+        {
+            continue;
+        }
+
+        c_Buffer.Reset(c_Entry.c_Buffer);
+        b_First = c_Entry.b_First;
+        u64_Read = c_Entry.u64_Read;
+
+        return true;
+    }
+
+    return false;
+}
+
+void OutputWorker::Cancel() noexcept
+{
+    u32_Generation += 1;
+
+    c_Message.Clear();
+    c_Audio.Clear();
+}
+
+//*************************************************************************************
+// Schedule
+//*************************************************************************************
+
+void OutputWorker::Schedule() noexcept
+{
+    std::shared_ptr<WorkerPool> p_Pool = p_WorkerPool.lock();
+
+    if (p_Pool != NULL)
+    {
+        p_Pool->Schedule(shared_from_this());
+    }
+}
+
+//*************************************************************************************
+// Run
+//*************************************************************************************
+
+bool OutputWorker::Run() noexcept
+{
+    // Wait for playback to catch up, retrieving audio schedules again
+    if (c_Audio.GetFree() == 0)
+    {
+        return false;
+    }
+
+    // Next message?
+    if (us_Sentence >= v_Sentence.size() || c_Current.u32_Generation != u32_Generation)
+    {
+        bool b_Full;
+
+        v_Sentence.clear();
+        us_Sentence = 0;
+
+        if (c_Message.TryPop(c_Current, b_Full) == false)
+        {
+            return false;
+        }
+
+        // Main thread waits for free space to add more messages
+        if (b_Full == true)
+        {
+            p_EventQueue->Notify(EventQueue::EVENT_MESSAGE, us_Channel);
+        }
+
+        // Cancelled while queued?
+        if (c_Current.u32_Generation != u32_Generation)
+        {
+            return c_Message.GetEmpty() == false;
+        }
+
+        MRH_LOG_INFO("Synthesizing output message.");
+
+        try
+        {
+            v_Sentence = TTS::SplitSentences(c_Current.s_Message);
+        }
+        catch (std::exception& e)
+        {
+            MRH_LOG_ERROR("Failed to split output message: {}", e.what());
+
+            return c_Message.GetEmpty() == false;
+        }
+
+        if (v_Sentence.empty() == true)
+        {
+            return c_Message.GetEmpty() == false;
+        }
+    }
+
+    // @NOTE: Playback starts with the first sentence, the following
+    //        sentences are synthesized while the previous ones play
+    try
+    {
+        Latency& c_Latency = Latency::Singleton();
+        MRH_Uint64 u64_Synthesize = Latency::GetTime();
+
+        p_TTS->Synthesize(v_Sentence[us_Sentence], c_Result.c_Buffer);
+
+        c_Latency.Add(Latency::STAGE_SYNTHESIZE, u64_Synthesize, Latency::GetTime());
+
+        c_Result.b_First = (us_Sentence == 0);
+        c_Result.u32_Generation = c_Current.u32_Generation;
+        c_Result.u64_Read = c_Current.u64_Read;
+
+        // Only this task adds audio, space was checked
+        c_Audio.TryPush(c_Result);
+
+        p_EventQueue->Notify(EventQueue::EVENT_SYNTHESIZED, us_Channel);
+
+        us_Sentence += 1;
+    }
+    catch (Exception& e)
+    {
+        MRH_LOG_ERROR("Failed to handle output: {}", e.what2());
+
+        // Skip the rest of the message
+        us_Sentence = v_Sentence.size();
+    }
+
+    return us_Sentence < v_Sentence.size() || c_Message.GetEmpty() == false;
+}
+
+//*************************************************************************************
+// Getters
+//*************************************************************************************
+
+size_t OutputWorker::GetFree() noexcept
+{
+    return c_Message.GetFree();
+}
@@ -0,0 +1,223 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef OutputWorker_h
+#define OutputWorker_h
+
+// C / C++
+#include <atomic>
+#include <memory>
+#include <vector>
+
+// External
+#include <MRH_Typedefs.h>
+
+// Project
+#include "./BoundedQueue.h"
+#include "./WorkerPool.h"
+#include "../TTS/TTS.h"
+#include "../EventQueue.h"
+
+// Pre-defined
+#ifndef MRH_SPEECHD_OUTPUT_WORKER_QUEUE_SIZE
+    #define MRH_SPEECHD_OUTPUT_WORKER_QUEUE_SIZE 16
+#endif
+#ifndef MRH_SPEECHD_OUTPUT_WORKER_AUDIO_SIZE
+    #define MRH_SPEECHD_OUTPUT_WORKER_AUDIO_SIZE 4 // Synthesized sentences ahead of playback
+#endif
+
+
+class OutputWorker : public WorkerPool::Task
+{
+public:
+
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+
+    /**
+     *  Default constructor.
+     *
+     *  \param p_WorkerPool The worker pool to synthesize with.
+     *  \param p_TTS The TTS API to synthesize with.
+     *  \param p_EventQueue The event queue to notify of synthesized audio and free 
+     *                      queue space.
+     *  \param us_Channel The event queue channel to notify.
+     */
+
+    OutputWorker(std::shared_ptr<WorkerPool>& p_WorkerPool,
+                 std::shared_ptr<TTS>& p_TTS,
+                 std::shared_ptr<EventQueue>& p_EventQueue,
+                 size_t us_Channel);
+
+    /**
+     *  Default destructor.
+     */
+
+    ~OutputWorker() noexcept;
+
+    //*************************************************************************************
+    // Queue
+    //*************************************************************************************
+
+    /**
+     *  Queue a message for synthesis. This function does not block.
+     *
+     *  \param s_Message The message to synthesize. The message is moved on success.
+     *  \param u64_Read The latency time at which the message was read.
+     *
+     *  \return true if queued, false if the queue is full.
+     */
+
+    bool Add(std::string& s_Message, MRH_Uint64 u64_Read) noexcept;
+
+    /**
+     *  Get the next synthesized sentence. This function does not block.
+     *
+     *  \param c_Buffer The synthesized audio. The buffer storage is swapped.
+     *  \param b_First If the sentence is the first of a message.
+     *  \param u64_Read The latency time at which the message was read.
+     *
+     *  \return true if audio was retrieved, false if none is available.
+     */
+
+    bool GetAudio(AudioBuffer& c_Buffer, bool& b_First, MRH_Uint64& u64_Read) noexcept;
+
+    /**
+     *  Discard all queued messages and synthesized audio. The message being 
+     *  synthesized is stopped after the current sentence.
+     */
+
+    void Cancel() noexcept;
+
+    //*************************************************************************************
+    // Getters
+    //*************************************************************************************
+
+    /**
+     *  Get the amount of messages which can be queued without blocking.
+     *
+     *  \return The free message count.
+     */
+
+    size_t GetFree() noexcept;
+
+private:
+
+    //*************************************************************************************
+    // Types
+    //*************************************************************************************
+
+    struct Message
+    {
+        std::string s_Message = "";
+        MRH_Uint32 u32_Generation = 0;
+        MRH_Uint64 u64_Read = 0;
+    };
+
+    struct Audio
+    {
+        /**
+         *  Default constructor.
+         */
+
+        Audio() noexcept : b_First(false),
+                           u32_Generation(0),
+                           u64_Read(0),
+                           c_Buffer(0)
+        {}
+
+        /**
+         *  Move constructor. The audio storage is swapped instead of copied.
+         */
+
+        Audio(Audio&& c_Audio) noexcept : b_First(c_Audio.b_First),
+                                          u32_Generation(c_Audio.u32_Generation),
+                                          u64_Read(c_Audio.u64_Read),
+                                          c_Buffer(0)
+        {
+            c_Buffer.Reset(c_Audio.c_Buffer);
+        }
+
+        /**
+         *  Move assignment. The audio storage is swapped instead of copied.
+         */
+
+        Audio& operator=(Audio&& c_Audio) noexcept
+        {
+            b_First = c_Audio.b_First;
+            u32_Generation = c_Audio.u32_Generation;
+            u64_Read = c_Audio.u64_Read;
+            c_Buffer.Reset(c_Audio.c_Buffer);
+
+            return *this;
+        }
+
+        bool b_First;
+        MRH_Uint32 u32_Generation;
+        MRH_Uint64 u64_Read;
+        AudioBuffer c_Buffer;
+    };
+
+    //*************************************************************************************
+    // Schedule
+    //*************************************************************************************
+
+    /**
+     *  Schedule the worker with the worker pool. Nothing is scheduled once 
+     *  the pool was destroyed.
+     */
+
+    void Schedule() noexcept;
+
+    //*************************************************************************************
+    // Run
+    //*************************************************************************************
+
+    /**
+     *  Synthesize a single sentence of a queued message.
+     *
+     *  \return true if more sentences are available, false if not.
+     */
+
+    bool Run() noexcept override;
+
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+
+    // @NOTE: Not owned, scheduled tasks are held by the pool
+    std::weak_ptr<WorkerPool> p_WorkerPool;
+    std::atomic<MRH_Uint32> u32_Generation;
+
+    BoundedQueue<Message> c_Message;
+    BoundedQueue<Audio> c_Audio;
+
+    std::shared_ptr<TTS> p_TTS;
+    std::shared_ptr<EventQueue> p_EventQueue;
+    size_t us_Channel;
+
+    // @NOTE: Only used by the running task
+    Message c_Current;
+    std::vector<std::string> v_Sentence;
+    size_t us_Sentence;
+    Audio c_Result;
+
+protected:
+
+};
+
+#endif /* OutputWorker_h */
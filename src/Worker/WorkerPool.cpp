@@ -0,0 +1,165 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+
+// External
+
+// Project
+#include "./WorkerPool.h"
+#include "../Logger.h"
+#include "../Exception.h"
+
+
+//*************************************************************************************
+// Constructor / Destructor
+//*************************************************************************************
+
+WorkerPool::WorkerPool(size_t us_Threads) : b_Run(true)
+{
+    if (us_Threads == 0)
+    {
+        throw Exception("Worker pool requires at least one thread!");
+    }
+
+    try
+    {
+        for (size_t i = 0; i < us_Threads; ++i)
+        {
+            v_Thread.emplace_back(&WorkerPool::Update, this);
+        }
+    }
+    catch (std::exception& e)
+    {
+        std::string s_Error = e.what();
+
+        // Join already started threads
+        Stop();
+
+        throw Exception("Failed to start worker thread: " + s_Error);
+    }
+
+    MRH_LOG_INFO("Started {} worker threads.", us_Threads);
+}
+
+WorkerPool::~WorkerPool() noexcept
+{
+    Stop();
+}
+
+void WorkerPool::Stop() noexcept
+{
+    // @NOTE: Discarded tasks are released after joining, outside the lock
+    std::deque<std::shared_ptr<Task>> dq_Discard;
+
+    {
+        std::lock_guard<std::mutex> c_Guard(c_Mutex);
+
+        b_Run = false;
+        dq_Task.swap(dq_Discard);
+    }
+
+    c_Condition.notify_all();
+
+    for (auto& Thread : v_Thread)
+    {
+        if (Thread.joinable() == true)
+        {
+            Thread.join();
+        }
+    }
+}
+
+//*************************************************************************************
+// Schedule
+//*************************************************************************************
+
+void WorkerPool::Schedule(std::shared_ptr<Task> const& p_Task) noexcept
+{
+    {
+        std::lock_guard<std::mutex> c_Guard(c_Mutex);
+
+        if (b_Run == false || p_Task->b_Queued == true)
+        {
+            return;
+        }
+        else if (p_Task->b_Running == true)
+        {
+            // Requeued by the running thread
+            p_Task->b_Rerun = true;
+            return;
+        }
+
+        try
+        {
+            dq_Task.emplace_back(p_Task);
+        }
+        catch (...)
+        {
+            return;
+        }
+
+        p_Task->b_Queued = true;
+    }
+
+    c_Condition.notify_one();
+}
+
+//*************************************************************************************
+// Update
+//*************************************************************************************
+
+void WorkerPool::Update() noexcept
+{
+    std::unique_lock<std::mutex> c_Lock(c_Mutex);
+
+    while (true)
+    {
+        c_Condition.wait(c_Lock, [this]() { return b_Run == false || dq_Task.empty() == false; });
+
+        if (b_Run == false)
+        {
+            return;
+        }
+
+        std::shared_ptr<Task> p_Task = dq_Task.front();
+        dq_Task.pop_front();
+
+        p_Task->b_Queued = false;
+        p_Task->b_Running = true;
+        p_Task->b_Rerun = false;
+
+        c_Lock.unlock();
+
+        bool b_More = p_Task->Run();
+
+        c_Lock.lock();
+
+        p_Task->b_Running = false;
+
+        // @NOTE: Added to the back, other tasks run before the next unit
+        if (b_Run == true && (b_More == true || p_Task->b_Rerun == true))
+        {
+            try
+            {
+                dq_Task.emplace_back(p_Task);
+                p_Task->b_Queued = true;
+            }
+            catch (...)
+            {}
+        }
+    }
+}
@@ -0,0 +1,167 @@
+/**
+ *  Copyright (C) 2023 The mrhspeechd Authors.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef WorkerPool_h
+#define WorkerPool_h
+
+// C / C++
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+#include <deque>
+#include <memory>
+
+// External
+
+// Project
+
+
+class WorkerPool
+{
+public:
+
+    //*************************************************************************************
+    // Types
+    //*************************************************************************************
+
+    class Task : public std::enable_shared_from_this<Task>
+    {
+    public:
+
+        //*************************************************************************************
+        // Destructor
+        //*************************************************************************************
+
+        /**
+         *  Default destructor.
+         */
+
+        virtual ~Task() noexcept
+        {}
+
+        //*************************************************************************************
+        // Run
+        //*************************************************************************************
+
+        /**
+         *  Perform a single unit of work. A task is never run by multiple
+         *  threads at once.
+         *
+         *  \return true if more work is available, false if not.
+         */
+
+        virtual bool Run() noexcept = 0;
+
+    private:
+
+        friend class WorkerPool;
+
+        //*************************************************************************************
+        // Data
+        //*************************************************************************************
+
+        // @NOTE: Guarded by the pool mutex
+        bool b_Queued = false;
+        bool b_Running = false;
+        bool b_Rerun = false;
+
+    protected:
+
+        //*************************************************************************************
+        // Constructor
+        //*************************************************************************************
+
+        /**
+         *  Default constructor.
+         */
+
+        Task() noexcept
+        {}
+    };
+
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+
+    /**
+     *  Default constructor.
+     *
+     *  \param us_Threads The number of worker threads.
+     */
+
+    WorkerPool(size_t us_Threads);
+
+    /**
+     *  Default destructor. Queued tasks are discarded, running tasks finish
+     *  their current unit of work.
+     */
+
+    ~WorkerPool() noexcept;
+
+    //*************************************************************************************
+    // Schedule
+    //*************************************************************************************
+
+    /**
+     *  Schedule a task to be run. Tasks are run round robin, one unit of
+     *  work at a time. Scheduling a running task runs it again afterwards.
+     *
+     *  \param p_Task The task to schedule.
+     */
+
+    void Schedule(std::shared_ptr<Task> const& p_Task) noexcept;
+
+    //*************************************************************************************
+    // Stop
+    //*************************************************************************************
+
+    /**
+     *  Stop and join all worker threads. Queued tasks are discarded, running
+     *  tasks finish their current unit of work. Tasks scheduled afterwards 
+     *  are ignored. This function must not be called by a task.
+     */
+
+    void Stop() noexcept;
+
+private:
+
+    //*************************************************************************************
+    // Update
+    //*************************************************************************************
+
+    /**
+     *  Run scheduled tasks.
+     */
+
+    void Update() noexcept;
+
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+
+    std::vector<std::thread> v_Thread;
+
+    std::mutex c_Mutex;
+    std::condition_variable c_Condition;
+    std::deque<std::shared_ptr<Task>> dq_Task;
+    bool b_Run;
+
+protected:
+
+};
+
+#endif /* WorkerPool_h */